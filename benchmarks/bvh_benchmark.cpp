@@ -0,0 +1,150 @@
+#include "lve_bvh.hpp"
+#include "lve_camera.hpp"
+
+// std
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// LveBvh 갱신/query 비용 측정
+// 큰 월드에 흩어진 객체를 카메라 frustum으로 culling하는 경우를 brute force와 비교
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+lve::LveAabb boxAt(const glm::vec3 &center, float halfSize) {
+  return {center - glm::vec3{halfSize}, center + glm::vec3{halfSize}};
+}
+
+} // namespace
+
+int main() {
+  constexpr float WORLD = 500.f;
+  constexpr float HALF_SIZE = 0.5f;
+  constexpr int QUERIES = 100;
+
+  std::mt19937 rng{42};
+  std::uniform_real_distribution<float> position{-WORLD, WORLD};
+  std::uniform_real_distribution<float> jitter{-0.05f, 0.05f};
+  std::uniform_real_distribution<float> angle{0.f, 6.2831853f};
+
+  lve::LveCamera camera{};
+  camera.setPerspectiveProjection(0.87f, 16.f / 9.f, 0.1f, 200.f);
+
+  for (size_t count : {size_t{100'000}, size_t{1'000'000}}) {
+    std::printf("objects: %zu\n", count);
+
+    std::vector<glm::vec3> centers(count);
+    for (auto &center : centers) {
+      center = {position(rng), position(rng) * 0.1f, position(rng)};
+    }
+
+    lve::LveBvh bvh;
+    std::vector<lve::LveBvh::proxy_t> proxies(count);
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < count; i++) {
+      proxies[i] = bvh.insert(boxAt(centers[i], HALF_SIZE),
+                              static_cast<uint32_t>(i));
+    }
+    std::printf("  insert all            %9.3f ms  height %d\n",
+                elapsedMs(start), bvh.height());
+
+    // fat margin 안에서 움직이는 경우 -> 재삽입 없음
+    start = Clock::now();
+    size_t reinserted = 0;
+    for (size_t i = 0; i < count; i++) {
+      centers[i] += glm::vec3{jitter(rng), 0.f, jitter(rng)};
+      reinserted += bvh.move(proxies[i], boxAt(centers[i], HALF_SIZE));
+    }
+    std::printf("  move small (all)      %9.3f ms  reinserted %zu\n",
+                elapsedMs(start), reinserted);
+
+    // 1%가 멀리 이동 -> 제거 후 재삽입
+    start = Clock::now();
+    reinserted = 0;
+    for (size_t i = 0; i < count; i += 100) {
+      centers[i] = {position(rng), position(rng) * 0.1f, position(rng)};
+      reinserted += bvh.move(proxies[i], boxAt(centers[i], HALF_SIZE));
+    }
+    std::printf("  move large (1%%)       %9.3f ms  reinserted %zu\n",
+                elapsedMs(start), reinserted);
+
+    // 모두 조금씩 움직였다고 보고 setBounds + refit 일괄 갱신
+    start = Clock::now();
+    for (size_t i = 0; i < count; i++) {
+      centers[i] += glm::vec3{0.3f, 0.f, 0.f};
+      bvh.setBounds(proxies[i], boxAt(centers[i], HALF_SIZE));
+    }
+    bvh.refit();
+    std::printf("  setBounds + refit     %9.3f ms\n", elapsedMs(start));
+
+    // 같은 카메라 위치로 BVH와 brute force culling 비교
+    std::vector<lve::LveFrustum> frustums;
+    for (int q = 0; q < QUERIES; q++) {
+      camera.setViewYXZ({position(rng), 0.f, position(rng)},
+                        {0.f, angle(rng), 0.f});
+      frustums.push_back(lve::LveFrustum::fromMatrix(camera.getProjection() *
+                                                     camera.getView()));
+    }
+
+    size_t visibleBvh = 0;
+    start = Clock::now();
+    for (const auto &frustum : frustums) {
+      bvh.queryFrustum(frustum, [&](uint32_t) { visibleBvh++; });
+    }
+    const double bvhMs = elapsedMs(start) / QUERIES;
+
+    size_t visibleBrute = 0;
+    start = Clock::now();
+    for (const auto &frustum : frustums) {
+      for (size_t i = 0; i < count; i++) {
+        if (frustum.test(bvh.getFatAabb(proxies[i])) !=
+            lve::LveFrustum::Result::OUTSIDE) {
+          visibleBrute++;
+        }
+      }
+    }
+    const double bruteMs = elapsedMs(start) / QUERIES;
+
+    std::printf("  frustum bvh           %9.3f ms/query  visible %zu\n", bvhMs,
+                visibleBvh / QUERIES);
+    std::printf("  frustum brute force   %9.3f ms/query  visible %zu  "
+                "(%.1fx)\n",
+                bruteMs, visibleBrute / QUERIES, bruteMs / bvhMs);
+
+    size_t hits = 0;
+    start = Clock::now();
+    for (int q = 0; q < QUERIES; q++) {
+      bvh.querySphere({position(rng), 0.f, position(rng)}, 10.f,
+                      [&](uint32_t) { hits++; });
+    }
+    std::printf("  sphere r=10           %9.3f ms/query  hits %zu\n",
+                elapsedMs(start) / QUERIES, hits / QUERIES);
+
+    size_t rayHits = 0;
+    start = Clock::now();
+    for (int q = 0; q < QUERIES; q++) {
+      const float a = angle(rng);
+      bvh.queryRay({position(rng), 0.f, position(rng)},
+                   {std::cos(a), 0.f, std::sin(a)}, 1000.f,
+                   [&](uint32_t, float enter) {
+                     rayHits++;
+                     return enter; // 가장 가까운 객체까지만 탐색
+                   });
+    }
+    std::printf("  ray (closest)         %9.3f ms/query  leaves %zu\n",
+                elapsedMs(start) / QUERIES, rayHits / QUERIES);
+  }
+
+  return 0;
+}
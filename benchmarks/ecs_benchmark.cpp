@@ -0,0 +1,154 @@
+#include "lve_ecs.hpp"
+#include "lve_game_object.hpp"
+
+// std
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// std::vector<LveGameObject>와 LveRegistry 순회 비교 (1M entity)
+// visit : model pointer, color, translation만 읽음 -> memory layout 비용
+// push  : SimpleRenderSystem과 같은 push constant 계산
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+template <typename Fn> double bestOf(int repeat, Fn fn) {
+  double best = 1e30;
+  for (int i = 0; i < repeat; i++) {
+    auto start = Clock::now();
+    fn();
+    best = std::min(best, elapsedMs(start));
+  }
+  return best;
+}
+
+// 최적화로 순회가 사라지지 않도록 결과를 밖으로 내보냄
+volatile float sink;
+
+} // namespace
+
+int main() {
+  constexpr size_t COUNT = 1'000'000;
+  constexpr int REPEAT = 5;
+
+  std::mt19937 rng{42};
+  std::uniform_real_distribution<float> dist{-10.f, 10.f};
+
+  // 실제 LveModel은 device가 필요하므로 주소값만 가진 placeholder 사용
+  std::vector<char> fakeModels(16);
+  auto fakeModel = [&](size_t i) {
+    return reinterpret_cast<lve::LveModel *>(&fakeModels[i % 16]);
+  };
+
+  std::vector<lve::LveGameObject> gameObjects;
+  gameObjects.reserve(COUNT);
+  lve::LveRegistry registry;
+
+  for (size_t i = 0; i < COUNT; i++) {
+    lve::TransformComponent transform{};
+    transform.translation = {dist(rng), dist(rng), dist(rng)};
+    transform.rotation = {dist(rng), dist(rng), dist(rng)};
+    glm::vec3 color{dist(rng), dist(rng), dist(rng)};
+
+    auto obj = lve::LveGameObject::createGameObject();
+    obj.model = std::shared_ptr<lve::LveModel>(std::shared_ptr<void>{},
+                                               fakeModel(i));
+    obj.transform = transform;
+    obj.color = color;
+    gameObjects.push_back(std::move(obj));
+
+    auto entity = registry.create();
+    registry.add<lve::ModelComponent>(entity, {fakeModel(i)});
+    registry.add<lve::TransformComponent>(entity, transform);
+    registry.add<lve::ColorComponent>(entity, {color});
+  }
+
+  const glm::mat4 projectionView{1.f};
+
+  double vectorVisit = bestOf(REPEAT, [&] {
+    float sum = 0.f;
+    for (auto &obj : gameObjects) {
+      sum += obj.transform.translation.x + obj.color.y +
+             static_cast<float>(reinterpret_cast<uintptr_t>(obj.model.get()) &
+                                1);
+    }
+    sink = sum;
+  });
+
+  double registryVisit = bestOf(REPEAT, [&] {
+    float sum = 0.f;
+    registry.each<lve::ModelComponent, lve::TransformComponent,
+                  lve::ColorComponent>(
+        [&](lve::LveEntity, lve::ModelComponent &model,
+            lve::TransformComponent &transform, lve::ColorComponent &color) {
+          sum += transform.translation.x + color.color.y +
+                 static_cast<float>(
+                     reinterpret_cast<uintptr_t>(model.model) & 1);
+        });
+    sink = sum;
+  });
+
+  double vectorPush = bestOf(REPEAT, [&] {
+    float sum = 0.f;
+    for (auto &obj : gameObjects) {
+      glm::mat4 transform = projectionView * obj.transform.mat4();
+      sum += transform[3][0] + obj.color.x;
+    }
+    sink = sum;
+  });
+
+  double registryPush = bestOf(REPEAT, [&] {
+    float sum = 0.f;
+    registry.each<lve::ModelComponent, lve::TransformComponent,
+                  lve::ColorComponent>(
+        [&](lve::LveEntity, lve::ModelComponent &,
+            lve::TransformComponent &transform, lve::ColorComponent &color) {
+          glm::mat4 matrix = projectionView * transform.mat4();
+          sum += matrix[3][0] + color.color.x;
+        });
+    sink = sum;
+  });
+
+  // 무작위 entity 10% 삭제 후 다시 생성 -> O(1) add/remove 확인
+  std::vector<lve::LveEntity> entities;
+  registry.each<lve::ModelComponent>(
+      [&](lve::LveEntity entity, lve::ModelComponent &) {
+        entities.push_back(entity);
+      });
+  std::shuffle(entities.begin(), entities.end(), rng);
+  entities.resize(COUNT / 10);
+
+  auto churnStart = Clock::now();
+  for (auto entity : entities) {
+    registry.destroy(entity);
+  }
+  for (size_t i = 0; i < entities.size(); i++) {
+    auto entity = registry.create();
+    registry.add<lve::ModelComponent>(entity, {fakeModel(i)});
+    registry.add<lve::TransformComponent>(entity);
+    registry.add<lve::ColorComponent>(entity);
+  }
+  double churnMs = elapsedMs(churnStart);
+
+  std::printf("entities: %zu (LveGameObject %zu bytes)\n", COUNT,
+              sizeof(lve::LveGameObject));
+  std::printf("%-8s %16s %16s %10s\n", "", "vector ms", "registry ms",
+              "speedup");
+  std::printf("%-8s %16.3f %16.3f %9.2fx\n", "visit", vectorVisit,
+              registryVisit, vectorVisit / registryVisit);
+  std::printf("%-8s %16.3f %16.3f %9.2fx\n", "push", vectorPush, registryPush,
+              vectorPush / registryPush);
+  std::printf("destroy + create %zu entities: %.3f ms (%.1f ns/entity)\n",
+              entities.size(), churnMs, churnMs * 1e6 / (2 * entities.size()));
+
+  return 0;
+}
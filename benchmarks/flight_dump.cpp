@@ -0,0 +1,145 @@
+#include "lve_flight_recorder.hpp"
+
+// std
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+// posix
+#include <sys/wait.h>
+#include <unistd.h>
+
+// FirstApp이 남긴 flight recorder 파일 (lve_flight_recorder.bin)을 출력
+// 실행 중인 process의 파일도 읽을 수 있음 -> 멈춘 renderer가 어느 단계에
+// 있는지 확인
+// --self-test: 자식 process가 frame을 기록하다 SIGSEGV로 죽었을 때 dump와
+//              ring 파일이 남는지 확인 (GPU, window 불필요)
+//
+// 사용법: flight_dump [file] [--self-test]
+
+namespace {
+
+constexpr const char *DEFAULT_FILE = "lve_flight_recorder.bin";
+constexpr uint32_t SELF_TEST_FRAMES = 300;
+
+std::string readFile(const std::string &path) {
+  std::ifstream file{path};
+  std::stringstream text;
+  text << file.rdbuf();
+  return text.str();
+}
+
+// renderer처럼 단계별로 채우고 마지막 frame은 submit 전에 멈춤
+[[noreturn]] void recordAndCrash(const std::string &ringPath,
+                                 const std::string &dumpPath) {
+  if (!lve::LveFlightRecorder::start(ringPath, dumpPath)) {
+    std::_Exit(EXIT_FAILURE);
+  }
+  for (uint32_t frame = 0; frame < SELF_TEST_FRAMES; frame++) {
+    auto *record = lve::LveFlightRecorder::beginFrame();
+    record->fenceResult = VK_SUCCESS;
+    record->acquireNs = lve::LveFlightRecorder::now();
+    record->acquireResult = VK_SUCCESS;
+    record->imageIndex = frame % 3;
+    record->recordNs = lve::LveFlightRecorder::now();
+    record->drawCount = frame;
+    if (frame + 1 == SELF_TEST_FRAMES) {
+      break;
+    }
+    record->submitNs = lve::LveFlightRecorder::now();
+    record->submitResult = VK_SUCCESS;
+    record->presentNs = lve::LveFlightRecorder::now();
+    record->presentResult = VK_SUBOPTIMAL_KHR;
+  }
+  raise(SIGSEGV);
+  std::_Exit(EXIT_FAILURE);
+}
+
+int selfTest() {
+  const std::string base = "/tmp/lve_flight_self_test_" +
+                           std::to_string(getpid());
+  const std::string ringPath = base + ".bin";
+  const std::string dumpPath = base + ".txt";
+
+  const pid_t child = fork();
+  if (child < 0) {
+    std::perror("fork");
+    return EXIT_FAILURE;
+  }
+  if (child == 0) {
+    recordAndCrash(ringPath, dumpPath);
+  }
+  int status = 0;
+  waitpid(child, &status, 0);
+
+  bool passed = true;
+  if (!WIFSIGNALED(status) || WTERMSIG(status) != SIGSEGV) {
+    std::fprintf(stderr, "child did not die from SIGSEGV (status %d)\n",
+                 status);
+    passed = false;
+  }
+
+  const std::string last = "frame " + std::to_string(SELF_TEST_FRAMES - 1);
+  const std::string dump = readFile(dumpPath);
+  const std::string expected[] = {
+      "=== lve flight recorder: SIGSEGV ===",
+      "frames " + std::to_string(SELF_TEST_FRAMES) + ", showing last " +
+          std::to_string(lve::LveFlightRecorder::CAPACITY),
+      "frame " + std::to_string(SELF_TEST_FRAMES -
+                                lve::LveFlightRecorder::CAPACITY) +
+          " ",
+      "(VK_SUBOPTIMAL_KHR) | draws " + std::to_string(SELF_TEST_FRAMES - 2),
+      " submit - (image fence 0.000 -) present - (-) | draws " +
+          std::to_string(SELF_TEST_FRAMES - 1),
+  };
+  for (const auto &text : expected) {
+    if (dump.find(text) == std::string::npos) {
+      std::fprintf(stderr, "dump is missing '%s'\n", text.c_str());
+      passed = false;
+    }
+  }
+
+  // crash 후에도 ring 파일을 그대로 읽을 수 있어야 함
+  std::printf("--- %s ---\n", ringPath.c_str());
+  std::fflush(stdout);
+  if (!lve::LveFlightRecorder::printFile(ringPath, STDOUT_FILENO)) {
+    std::fprintf(stderr, "failed to read %s\n", ringPath.c_str());
+    passed = false;
+  }
+
+  std::remove(ringPath.c_str());
+  std::remove(dumpPath.c_str());
+  std::printf("flight recorder self test %s\n", passed ? "passed" : "FAILED");
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::string path = DEFAULT_FILE;
+  bool runSelfTest = false;
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (arg == "--self-test") {
+      runSelfTest = true;
+    } else if (arg.rfind("--", 0) != 0) {
+      path = arg;
+    } else {
+      std::fprintf(stderr, "unknown argument '%s'\n", arg.c_str());
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (runSelfTest) {
+    return selfTest();
+  }
+  if (!lve::LveFlightRecorder::printFile(path, STDOUT_FILENO)) {
+    std::fprintf(stderr, "failed to read flight recorder file '%s'\n",
+                 path.c_str());
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,136 @@
+#include "lve_frame_limiter.hpp"
+
+// std
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+// 목표 frame rate로 가짜 render loop를 돌리면서 대기 방식별 비교
+// sleep만 사용 / spin만 사용 / LveFrameLimiter (sleep + 보정된 spin)
+// frame time 오차 percentile과 대기에 쓴 CPU 시간 출력
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr double FRAME_RATE = 144.0;
+constexpr double DURATION_SECONDS = 3.0;
+
+double toMs(Clock::duration duration) {
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+// frame마다 1~4 ms의 CPU 작업 (기록, culling 등을 흉내)
+void simulateWork(std::mt19937 &rng) {
+  std::uniform_real_distribution<double> workMs{1.0, 4.0};
+  const auto work = std::chrono::duration<double, std::milli>(workMs(rng));
+  const auto end =
+      Clock::now() + std::chrono::duration_cast<Clock::duration>(work);
+  volatile double sink = 0.0;
+  while (Clock::now() < end) {
+    sink = sink + 1.0;
+  }
+}
+
+double percentile(std::vector<double> values, double p) {
+  const size_t index =
+      std::min(values.size() - 1,
+               static_cast<size_t>(p * static_cast<double>(values.size())));
+  std::nth_element(values.begin(), values.begin() + index, values.end());
+  return values[index];
+}
+
+void printResult(const char *name, const std::vector<double> &frameMs,
+                 double cpuMs, double wallMs) {
+  const double targetMs = 1000.0 / FRAME_RATE;
+  std::vector<double> errors;
+  errors.reserve(frameMs.size());
+  for (double ms : frameMs) {
+    errors.push_back(std::abs(ms - targetMs));
+  }
+  std::printf("%-10s frames %5zu  error p50 %6.3f  p95 %6.3f  p99 %6.3f ms  "
+              "cpu %5.1f%%\n",
+              name, frameMs.size(), percentile(errors, 0.50),
+              percentile(errors, 0.95), percentile(errors, 0.99),
+              100.0 * cpuMs / wallMs);
+}
+
+double cpuMsSince(std::clock_t start) {
+  return 1000.0 * static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+}
+
+// sleep_until / spin 비교용 loop, wait(deadline)으로 대기 방식 지정
+template <typename WaitFn> void runManual(const char *name, WaitFn wait) {
+  std::mt19937 rng{42};
+  const auto target = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(1.0 / FRAME_RATE));
+  std::vector<double> frames;
+
+  const std::clock_t cpuStart = std::clock();
+  const auto start = Clock::now();
+  auto last = start;
+  auto deadline = start + target;
+  while (Clock::now() - start <
+         std::chrono::duration<double>(DURATION_SECONDS)) {
+    simulateWork(rng);
+    wait(deadline);
+    const auto now = Clock::now();
+    frames.push_back(toMs(now - last));
+    last = now;
+    deadline += target;
+  }
+  printResult(name, frames, cpuMsSince(cpuStart), toMs(Clock::now() - start));
+}
+
+} // namespace
+
+int main() {
+  std::printf("target %.1f fps (%.3f ms), %.0f s each\n", FRAME_RATE,
+              1000.0 / FRAME_RATE, DURATION_SECONDS);
+
+  runManual("sleep", [](Clock::time_point deadline) {
+    std::this_thread::sleep_until(deadline);
+  });
+
+  runManual("spin", [](Clock::time_point deadline) {
+    while (Clock::now() < deadline) {
+    }
+  });
+
+  {
+    std::mt19937 rng{42};
+    lve::LveFrameLimiter limiter{FRAME_RATE};
+    std::vector<double> frames;
+
+    const std::clock_t cpuStart = std::clock();
+    const auto start = Clock::now();
+    limiter.wait();
+    auto last = Clock::now();
+    while (Clock::now() - start <
+           std::chrono::duration<double>(DURATION_SECONDS)) {
+      simulateWork(rng);
+      limiter.wait();
+      const auto now = Clock::now();
+      frames.push_back(toMs(now - last));
+      last = now;
+    }
+    printResult("hybrid", frames, cpuMsSince(cpuStart),
+                toMs(Clock::now() - start));
+
+    const auto stats = limiter.getStats();
+    std::printf("hybrid     p50 %.3f  p95 %.3f  p99 %.3f ms, sleep %.0f ms, "
+                "spin %.0f ms, spin threshold %.3f ms\n",
+                stats.frameP50Ms, stats.frameP95Ms, stats.frameP99Ms,
+                stats.sleepMs, stats.spinMs, stats.spinThresholdMs);
+    lve::LveFrameLimiter::printHistogram(stats, std::cout);
+  }
+
+  return 0;
+}
@@ -0,0 +1,305 @@
+#include "lve_device.hpp"
+#include "lve_frame_capture.hpp"
+#include "lve_late_latch.hpp"
+#include "lve_model.hpp"
+#include "lve_pipeline.hpp"
+#include "lve_renderer.hpp"
+#include "lve_vulkan_dispatch.hpp"
+#include "lve_window.hpp"
+
+// libs
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+// std
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// FirstApp에서 CAPTURE_KEY로 저장한 frame을 scene update 없이 N번 다시 그림
+// replay마다 command 기록 시간, endFrame(submit + present) 시간, GPU frame time 측정
+// -> scene logic과 분리된 driver, GPU 비용
+//
+// 사용법: frame_replay <capture file> [--replays N] [--headless] [--csv path]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// pipeline, cache가 자리 잡도록 버리는 replay
+constexpr uint32_t WARM_UP_REPLAYS = 10;
+// GPU 구간은 profiler가 보관하는 frame만 읽을 수 있음
+constexpr uint32_t MAX_REPLAYS = lve::LveGpuProfiler::TRACE_FRAMES;
+
+struct ReplaySample {
+  double recordMs = 0.0;
+  double submitMs = 0.0;
+  double gpuMs = 0.0;
+};
+
+// p (0..1) 위치의 값, values의 순서는 바뀜
+double percentile(std::vector<double> &values, double p) {
+  if (values.empty()) {
+    return 0.0;
+  }
+  const size_t index =
+      std::min(values.size() - 1,
+               static_cast<size_t>(p * static_cast<double>(values.size())));
+  std::nth_element(values.begin(), values.begin() + index, values.end());
+  return values[index];
+}
+
+/**
+ * @brief capture의 pipeline, buffer를 다시 만들고 command stream을 실행
+ */
+class FrameReplayer {
+public:
+  FrameReplayer(const lve::LveFrameCapture &capture, bool headless)
+      : capture{capture},
+        lveWindow{static_cast<int>(std::max(1u, capture.getExtent().width)),
+                  static_cast<int>(std::max(1u, capture.getExtent().height)),
+                  "lve frame replay", headless} {
+    // vsync 없이 가능한 빨리 그림 (지원하지 않으면 FIFO)
+    lveRenderer.setFramePacing(lve::LveFramePacing::presets()[1]);
+    createPipelineLayout();
+    for (const auto &pipeline : capture.getPipelines()) {
+      lve::PipelineConfigInfo pipelineConfig{};
+      lve::LvePipeline::defaultPipelineConfigInfo(pipelineConfig);
+      pipelineConfig.renderPass = lveRenderer.getSwapChainRenderPass();
+      pipelineConfig.pipelineLayout = pipelineLayout;
+      pipelines.push_back(std::make_unique<lve::LvePipeline>(
+          lveDevice, pipeline.vertFilepath, pipeline.fragFilepath,
+          pipelineConfig));
+    }
+    for (const auto &buffer : capture.getBuffers()) {
+      models.push_back(std::make_unique<lve::LveModel>(lveDevice, buffer));
+    }
+  }
+
+  ~FrameReplayer() {
+    vkDeviceWaitIdle(lveDevice.device());
+    vkDestroyPipelineLayout(lveDevice.device(), pipelineLayout, nullptr);
+  }
+
+  const char *deviceName() const { return lveDevice.properties.deviceName; }
+
+  // 마지막 replay의 Vulkan 호출 수 (live frame의 "vulkan calls"와 비교)
+  const lve::LveVulkanStats::FrameStats &frameStats() const {
+    return lveRenderer.getFrameStats();
+  }
+
+  std::vector<ReplaySample> run(uint32_t replays) {
+    std::vector<ReplaySample> samples;
+    auto &gpuProfiler = lveRenderer.getGpuProfiler();
+
+    for (uint32_t replay = 0; replay < WARM_UP_REPLAYS + replays; replay++) {
+      if (replay == WARM_UP_REPLAYS) {
+        // warm-up replay의 GPU 구간이 측정에 섞이지 않도록 모두 읽고 버림
+        vkDeviceWaitIdle(lveDevice.device());
+        gpuProfiler.resolveAll();
+        gpuProfiler.resetStats();
+      }
+      glfwPollEvents();
+
+      auto commandBuffer = lveRenderer.beginFrame();
+      if (commandBuffer == nullptr) {
+        continue;
+      }
+      // push constant에 기록 시점 PV가 들어 있음 -> correction은 identity
+      const int frameIndex = lveRenderer.getFrameIndex();
+      lateLatch.record(frameIndex, glm::mat4{1.f});
+
+      const auto recordStart = Clock::now();
+      execute(commandBuffer, lateLatch.getDescriptorSet(frameIndex));
+      const auto submitStart = Clock::now();
+      lveRenderer.endFrame();
+      const auto submitEnd = Clock::now();
+
+      if (replay >= WARM_UP_REPLAYS) {
+        ReplaySample sample{};
+        sample.recordMs = std::chrono::duration<double, std::milli>(
+                              submitStart - recordStart)
+                              .count();
+        sample.submitMs =
+            std::chrono::duration<double, std::milli>(submitEnd - submitStart)
+                .count();
+        samples.push_back(sample);
+      }
+    }
+
+    // 아직 읽지 않은 slot까지 읽어서 replay 순서대로 GPU frame time을 채움
+    vkDeviceWaitIdle(lveDevice.device());
+    gpuProfiler.resolveAll();
+    std::vector<lve::LveTraceEvent> events;
+    gpuProfiler.collectTraceEvents(events);
+    size_t replay = 0;
+    for (const auto &event : events) {
+      if (std::strcmp(event.name, "frame") == 0 && replay < samples.size()) {
+        samples[replay++].gpuMs = event.durationUs / 1000.0;
+      }
+    }
+    return samples;
+  }
+
+private:
+  void createPipelineLayout() {
+    VkPushConstantRange pushConstantRange{};
+    pushConstantRange.stageFlags = capture.getPushConstantStages();
+    pushConstantRange.offset = 0;
+    pushConstantRange.size = capture.getPushConstantSize();
+
+    VkDescriptorSetLayout globalSetLayout = lateLatch.getDescriptorSetLayout();
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+    pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount = 1;
+    pipelineLayoutInfo.pSetLayouts = &globalSetLayout;
+    pipelineLayoutInfo.pushConstantRangeCount =
+        pushConstantRange.size > 0 ? 1 : 0;
+    pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+    if (vkCreatePipelineLayout(lveDevice.device(), &pipelineLayoutInfo,
+                               nullptr, &pipelineLayout) != VK_SUCCESS) {
+      throw std::runtime_error("failed to create pipeline layout!");
+    }
+  }
+
+  void execute(VkCommandBuffer commandBuffer, VkDescriptorSet globalSet) {
+    using Op = lve::LveFrameCapture::Op;
+    for (const auto &command : capture.getCommands()) {
+      const uint32_t *args = command.args;
+      switch (command.op) {
+      case Op::BEGIN_RENDER_PASS:
+        // 크기는 window에서 정해짐 (capture와 같은 크기로 만듦)
+        lveRenderer.beginSwapChainRenderPass(commandBuffer);
+        break;
+      case Op::END_RENDER_PASS:
+        lveRenderer.endSwapChainRenderPass(commandBuffer);
+        break;
+      case Op::BIND_PIPELINE:
+        pipelines[args[0]]->bind(commandBuffer);
+        break;
+      case Op::BIND_GLOBAL_SET:
+        lve::vkd::cmdBindDescriptorSets(commandBuffer,
+                                        VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                        pipelineLayout, 0, 1, &globalSet, 0,
+                                        nullptr);
+        break;
+      case Op::PUSH_CONSTANTS:
+        lve::vkd::cmdPushConstants(commandBuffer, pipelineLayout, args[2], 0,
+                                   args[1], capture.getPushData(args[0]));
+        break;
+      case Op::BIND_BUFFERS:
+        models[args[0]]->bind(commandBuffer);
+        break;
+      case Op::DRAW:
+        lve::vkd::cmdDraw(commandBuffer, args[0], 1, 0, 0);
+        break;
+      case Op::DRAW_INDEXED:
+        lve::vkd::cmdDrawIndexed(commandBuffer, args[0], 1, 0, 0, 0);
+        break;
+      }
+    }
+  }
+
+  const lve::LveFrameCapture &capture;
+  lve::LveWindow lveWindow;
+  lve::LveDevice lveDevice{lveWindow};
+  lve::LveRenderer lveRenderer{lveWindow, lveDevice};
+  lve::LveLateLatch lateLatch{lveDevice};
+  VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+  std::vector<std::unique_ptr<lve::LvePipeline>> pipelines;
+  std::vector<std::unique_ptr<lve::LveModel>> models;
+};
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::string capturePath;
+  uint32_t replays = 100;
+  bool headless = false;
+  std::string csvPath;
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (arg == "--replays" && i + 1 < argc) {
+      replays = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "--headless") {
+      headless = true;
+    } else if (arg == "--csv" && i + 1 < argc) {
+      csvPath = argv[++i];
+    } else if (capturePath.empty() && arg.rfind("--", 0) != 0) {
+      capturePath = arg;
+    } else {
+      std::fprintf(stderr, "unknown argument '%s'\n", arg.c_str());
+      return EXIT_FAILURE;
+    }
+  }
+  if (capturePath.empty()) {
+    std::fprintf(stderr, "usage: frame_replay <capture file> [--replays N] "
+                         "[--headless] [--csv path]\n");
+    return EXIT_FAILURE;
+  }
+  replays = std::clamp(replays, 1u, MAX_REPLAYS);
+
+  try {
+    const auto capture = lve::LveFrameCapture::load(capturePath);
+    uint32_t draws = 0;
+    for (const auto &command : capture.getCommands()) {
+      draws += command.op == lve::LveFrameCapture::Op::DRAW ||
+               command.op == lve::LveFrameCapture::Op::DRAW_INDEXED;
+    }
+
+    FrameReplayer replayer{capture, headless};
+    std::printf("device: %s\n", replayer.deviceName());
+    std::printf("capture: %s (%ux%u, %zu commands, %u draws, %zu buffers)\n",
+                capturePath.c_str(), capture.getExtent().width,
+                capture.getExtent().height, capture.getCommands().size(),
+                draws, capture.getBuffers().size());
+
+    auto samples = replayer.run(replays);
+    const auto &vulkanStats = replayer.frameStats();
+    std::printf("vulkan calls per replay: %llu vkCmd* (draws %llu)\n",
+                static_cast<unsigned long long>(vulkanStats.commandCount()),
+                static_cast<unsigned long long>(vulkanStats.drawCount()));
+
+    if (!csvPath.empty()) {
+      std::ofstream csv{csvPath};
+      csv << "replay,record_ms,submit_ms,gpu_ms\n";
+      for (size_t i = 0; i < samples.size(); i++) {
+        csv << i << "," << samples[i].recordMs << "," << samples[i].submitMs
+            << "," << samples[i].gpuMs << "\n";
+      }
+      std::printf("per-replay times written to %s\n", csvPath.c_str());
+    }
+
+    std::printf("%zu replays\n%-10s %10s %10s %10s %10s\n", samples.size(),
+                "", "min", "p50", "p99", "max");
+    auto printRow = [&](const char *name, double ReplaySample::*field) {
+      std::vector<double> values;
+      for (const auto &sample : samples) {
+        values.push_back(sample.*field);
+      }
+      if (values.empty()) {
+        return;
+      }
+      const double min = *std::min_element(values.begin(), values.end());
+      const double max = *std::max_element(values.begin(), values.end());
+      std::printf("%-10s %10.3f %10.3f %10.3f %10.3f\n", name, min,
+                  percentile(values, 0.50), percentile(values, 0.99), max);
+    };
+    printRow("record ms", &ReplaySample::recordMs);
+    printRow("submit ms", &ReplaySample::submitMs);
+    printRow("gpu ms", &ReplaySample::gpuMs);
+  } catch (const std::exception &e) {
+    std::fprintf(stderr, "%s\n", e.what());
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
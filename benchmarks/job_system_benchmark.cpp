@@ -0,0 +1,146 @@
+#include "lve_job_system.hpp"
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// LveJobSystem 오버헤드와 확장성 측정
+// 빈 job 처리량, parallelFor 속도 향상, 의존 관계 chain, steal/queue 통계 출력
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+// job 하나당 적당한 계산량
+float work(size_t index) {
+  float value = static_cast<float>(index);
+  for (int i = 0; i < 64; i++) {
+    value = std::sqrt(value * 1.0001f + 1.f);
+  }
+  return value;
+}
+
+void printStats(const lve::LveJobSystem &jobSystem) {
+  const auto threads = jobSystem.getThreadStats();
+  for (size_t i = 0; i < threads.size(); i++) {
+    const auto &stats = threads[i];
+    std::printf("    thread %zu%s executed %8llu  steals %7llu/%-8llu  "
+                "sleeps %5llu  max depth %zu\n",
+                i, i == 0 ? " (main)" : "       ",
+                static_cast<unsigned long long>(stats.executed),
+                static_cast<unsigned long long>(stats.steals),
+                static_cast<unsigned long long>(stats.stealAttempts),
+                static_cast<unsigned long long>(stats.sleeps),
+                stats.maxQueueDepth);
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  // 인자로 worker 수 지정 가능, 기본은 hardware thread - 1
+  const unsigned workerCount =
+      argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 0;
+  lve::LveJobSystem jobSystem{workerCount};
+  std::printf("workers: %zu (+ main thread)\n", jobSystem.workerCount());
+
+  // 1. 빈 job 처리량 -> 스케줄링 오버헤드
+  {
+    constexpr size_t JOBS = 1'000'000;
+    jobSystem.resetStats();
+    lve::LveJobCounter counter;
+    auto start = Clock::now();
+    for (size_t i = 0; i < JOBS; i++) {
+      jobSystem.run([] {}, &counter);
+    }
+    jobSystem.wait(counter);
+    const double ms = elapsedMs(start);
+    std::printf("empty jobs: %zu in %.2f ms (%.1f ns/job)\n", JOBS, ms,
+                ms * 1e6 / JOBS);
+    printStats(jobSystem);
+  }
+
+  // 2. parallelFor 확장성
+  {
+    constexpr size_t COUNT = 4'000'000;
+    std::vector<float> out(COUNT);
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < COUNT; i++) {
+      out[i] = work(i);
+    }
+    const double serialMs = elapsedMs(start);
+
+    for (size_t grain : {size_t{256}, size_t{4096}, size_t{65536}}) {
+      jobSystem.resetStats();
+      start = Clock::now();
+      jobSystem.parallelFor(COUNT, grain, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+          out[i] = work(i);
+        }
+      });
+      const double parallelMs = elapsedMs(start);
+      std::printf("parallelFor grain %6zu: serial %8.2f ms  parallel %8.2f ms "
+                  " (%.2fx)\n",
+                  grain, serialMs, parallelMs, serialMs / parallelMs);
+      printStats(jobSystem);
+    }
+  }
+
+  // 3. 의존 관계 chain: A(병렬 N개) -> B(병렬 N개) -> C
+  {
+    constexpr int ITERATIONS = 1000;
+    constexpr int FAN_OUT = 16;
+    std::atomic<int> order{0};
+    int violations = 0;
+
+    auto start = Clock::now();
+    for (int iteration = 0; iteration < ITERATIONS; iteration++) {
+      lve::LveJobCounter stageA, stageB, stageC;
+      std::atomic<int> doneA{0}, doneB{0};
+
+      for (int i = 0; i < FAN_OUT; i++) {
+        jobSystem.run([&] { doneA.fetch_add(1); }, &stageA);
+      }
+      for (int i = 0; i < FAN_OUT; i++) {
+        jobSystem.runAfter(
+            stageA,
+            [&] {
+              if (doneA.load() != FAN_OUT) {
+                order.fetch_add(1);
+              }
+              doneB.fetch_add(1);
+            },
+            &stageB);
+      }
+      jobSystem.runAfter(
+          stageB,
+          [&] {
+            if (doneB.load() != FAN_OUT) {
+              order.fetch_add(1);
+            }
+          },
+          &stageC);
+
+      jobSystem.wait(stageC);
+      jobSystem.wait(stageB);
+      jobSystem.wait(stageA);
+    }
+    violations = order.load();
+    std::printf("dependency chains: %d x (%d -> %d -> 1) in %.2f ms, order "
+                "violations %d\n",
+                ITERATIONS, FAN_OUT, FAN_OUT, elapsedMs(start), violations);
+  }
+
+  return 0;
+}
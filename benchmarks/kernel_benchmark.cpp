@@ -0,0 +1,320 @@
+#include "lve_camera.hpp"
+#include "lve_game_object.hpp"
+#include "lve_model.hpp"
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+// 자주 호출되는 CPU kernel의 ns/op, 처리량, op당 할당 수 측정 (GPU 불필요)
+// 결과를 history 파일에 한 줄씩 추가하고 직전 실행과 비교 -> 최적화 확인용
+//
+// 사용법: kernel_benchmark [--history path] [--label text]
+
+namespace {
+
+// new/delete를 바꿔서 측정 구간의 할당 수를 셈
+std::atomic<uint64_t> allocationCount{0};
+
+} // namespace
+
+void *operator new(std::size_t size) {
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  if (void *memory = std::malloc(size == 0 ? 1 : size)) {
+    return memory;
+  }
+  throw std::bad_alloc{};
+}
+void operator delete(void *memory) noexcept { std::free(memory); }
+void operator delete(void *memory, std::size_t) noexcept { std::free(memory); }
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// 측정 한 번의 최소 시간, 가장 빠른 REPEAT번 결과를 사용
+constexpr double MIN_RUN_MS = 100.0;
+constexpr int REPEAT = 5;
+constexpr uint32_t SEED = 42;
+// 실행한 machine마다 다르므로 git에 넣지 않음 (.gitignore)
+constexpr const char *DEFAULT_HISTORY = "benchmarks/kernel_history.jsonl";
+
+// 최적화로 계산이 사라지지 않도록 결과를 모음
+volatile float floatSink = 0.f;
+volatile size_t sizeSink = 0;
+
+struct Result {
+  std::string name;
+  const char *unit; // op 하나가 무엇인지
+  double nsPerOp = 0.0;
+  double opsPerSecond = 0.0;
+  double allocationsPerOp = 0.0;
+};
+
+/**
+ * @brief run() 한 번이 opsPerRun개의 op를 처리, MIN_RUN_MS 이상 반복해서 측정
+ */
+Result measure(const std::string &name, const char *unit, size_t opsPerRun,
+               const std::function<void()> &run) {
+  run(); // warm up, cache와 lazy 할당 정리
+
+  double bestNs = 1e30;
+  double allocations = 0.0;
+  for (int repeat = 0; repeat < REPEAT; repeat++) {
+    size_t runs = 0;
+    const uint64_t allocationsBefore = allocationCount.load();
+    const auto start = Clock::now();
+    double elapsedMs = 0.0;
+    while (elapsedMs < MIN_RUN_MS) {
+      run();
+      runs++;
+      elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() -
+                                                            start)
+                      .count();
+    }
+    const double ops = static_cast<double>(runs * opsPerRun);
+    bestNs = std::min(bestNs, elapsedMs * 1e6 / ops);
+    allocations = (allocationCount.load() - allocationsBefore) / ops;
+  }
+  return {name, unit, bestNs, 1e9 / bestNs, allocations};
+}
+
+std::vector<lve::TransformComponent> randomTransforms(size_t count) {
+  std::mt19937 rng{SEED};
+  std::uniform_real_distribution<float> position{-100.f, 100.f};
+  std::uniform_real_distribution<float> angle{-glm::two_pi<float>(),
+                                              glm::two_pi<float>()};
+  std::uniform_real_distribution<float> scale{0.1f, 2.f};
+
+  std::vector<lve::TransformComponent> transforms(count);
+  for (auto &transform : transforms) {
+    transform.translation = {position(rng), position(rng), position(rng)};
+    transform.rotation = {angle(rng), angle(rng), angle(rng)};
+    transform.scale = {scale(rng), scale(rng), scale(rng)};
+  }
+  return transforms;
+}
+
+/**
+ * @brief side x side 격자 mesh의 index 순서 vertex stream
+ * 안쪽 vertex는 삼각형 6개가 공유 -> OBJ를 읽은 직후와 같은 중복
+ */
+std::vector<lve::LveModel::Vertex> gridVertexStream(uint32_t side) {
+  auto vertexAt = [&](uint32_t x, uint32_t z) {
+    lve::LveModel::Vertex vertex{};
+    vertex.position = {static_cast<float>(x), 0.f, static_cast<float>(z)};
+    vertex.color = {1.f, 1.f, 1.f};
+    vertex.normal = {0.f, -1.f, 0.f};
+    vertex.uv = {static_cast<float>(x) / side, static_cast<float>(z) / side};
+    return vertex;
+  };
+
+  std::vector<lve::LveModel::Vertex> stream;
+  stream.reserve(side * side * 6);
+  for (uint32_t z = 0; z < side; z++) {
+    for (uint32_t x = 0; x < side; x++) {
+      stream.insert(stream.end(),
+                    {vertexAt(x, z), vertexAt(x + 1, z), vertexAt(x, z + 1),
+                     vertexAt(x + 1, z), vertexAt(x + 1, z + 1),
+                     vertexAt(x, z + 1)});
+    }
+  }
+  return stream;
+}
+
+/**
+ * @brief gridVertexStream()과 같은 격자를 OBJ 파일로 저장
+ * @return 저장한 파일의 face index 수
+ */
+size_t writeGridObj(const std::string &path, uint32_t side) {
+  std::ofstream obj{path};
+  for (uint32_t z = 0; z <= side; z++) {
+    for (uint32_t x = 0; x <= side; x++) {
+      obj << "v " << x << " 0 " << z << "\n";
+      obj << "vt " << static_cast<float>(x) / side << " "
+          << static_cast<float>(z) / side << "\n";
+    }
+  }
+  obj << "vn 0 -1 0\n";
+  // OBJ index는 1부터
+  auto index = [&](uint32_t x, uint32_t z) { return z * (side + 1) + x + 1; };
+  auto corner = [&](uint32_t x, uint32_t z) {
+    const uint32_t i = index(x, z);
+    return std::to_string(i) + "/" + std::to_string(i) + "/1";
+  };
+  for (uint32_t z = 0; z < side; z++) {
+    for (uint32_t x = 0; x < side; x++) {
+      obj << "f " << corner(x, z) << " " << corner(x + 1, z) << " "
+          << corner(x, z + 1) << "\n";
+      obj << "f " << corner(x + 1, z) << " " << corner(x + 1, z + 1) << " "
+          << corner(x, z + 1) << "\n";
+    }
+  }
+  return static_cast<size_t>(side) * side * 6;
+}
+
+/**
+ * @brief history 한 줄에서 kernel의 ns/op 찾기 (이 benchmark가 쓴 형식)
+ */
+bool findNsPerOp(const std::string &line, const std::string &name,
+                 double &nsPerOp) {
+  const std::string key = "\"" + name + "\": {\"ns_per_op\": ";
+  const size_t position = line.find(key);
+  if (position == std::string::npos) {
+    return false;
+  }
+  return std::sscanf(line.c_str() + position + key.size(), "%lf", &nsPerOp) ==
+         1;
+}
+
+std::string lastLine(const std::string &path) {
+  std::ifstream history{path};
+  std::string line;
+  std::string last;
+  while (std::getline(history, line)) {
+    if (!line.empty()) {
+      last = line;
+    }
+  }
+  return last;
+}
+
+void appendHistory(const std::string &path, const std::string &label,
+                   const std::vector<Result> &results) {
+  std::ofstream history{path, std::ios::app};
+  history << "{\"time\": " << static_cast<long long>(std::time(nullptr))
+          << ", \"label\": \"" << label << "\", \"results\": {";
+  for (size_t i = 0; i < results.size(); i++) {
+    const auto &result = results[i];
+    history << (i > 0 ? ", " : "") << "\"" << result.name
+            << "\": {\"ns_per_op\": " << result.nsPerOp
+            << ", \"ops_per_second\": " << result.opsPerSecond
+            << ", \"allocations_per_op\": " << result.allocationsPerOp << "}";
+  }
+  history << "}}\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::string historyPath = DEFAULT_HISTORY;
+  std::string label;
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (arg == "--history" && i + 1 < argc) {
+      historyPath = argv[++i];
+    } else if (arg == "--label" && i + 1 < argc) {
+      label = argv[++i];
+    } else {
+      std::fprintf(stderr, "unknown argument '%s'\n", arg.c_str());
+      return 2;
+    }
+  }
+
+  std::vector<Result> results;
+
+  // TransformComponent::mat4, cache에 들어가는 크기로 계산 비용만 측정
+  {
+    auto transforms = randomTransforms(4096);
+    results.push_back(
+        measure("TransformComponent::mat4", "matrix", transforms.size(), [&] {
+          float sum = 0.f;
+          for (auto &transform : transforms) {
+            sum += transform.mat4()[3][0];
+          }
+          floatSink = sum;
+        }));
+  }
+
+  // LveCamera::setViewYXZ / setPerspectiveProjection
+  {
+    const auto transforms = randomTransforms(4096);
+    lve::LveCamera camera{};
+    results.push_back(
+        measure("LveCamera::setViewYXZ", "call", transforms.size(), [&] {
+          float sum = 0.f;
+          for (const auto &transform : transforms) {
+            camera.setViewYXZ(transform.translation, transform.rotation);
+            sum += camera.getView()[3][2];
+          }
+          floatSink = sum;
+        }));
+    results.push_back(measure(
+        "LveCamera::setPerspectiveProjection", "call", transforms.size(), [&] {
+          float sum = 0.f;
+          for (const auto &transform : transforms) {
+            camera.setPerspectiveProjection(
+                glm::radians(50.f), transform.scale.x, 0.1f, 100.f);
+            sum += camera.getProjection()[0][0];
+          }
+          floatSink = sum;
+        }));
+  }
+
+  // hashCombine over Vertex (std::hash<LveModel::Vertex>)
+  const auto stream = gridVertexStream(128);
+  {
+    const std::hash<lve::LveModel::Vertex> hasher{};
+    results.push_back(measure("hash<Vertex>", "vertex", stream.size(), [&] {
+      size_t sum = 0;
+      for (const auto &vertex : stream) {
+        sum += hasher(vertex);
+      }
+      sizeSink = sum;
+    }));
+  }
+
+  // Builder::loadModel의 welding, 파일 읽기 없이
+  {
+    lve::LveModel::Builder builder{};
+    results.push_back(measure("vertex welding", "index", stream.size(), [&] {
+      builder.weldVertices(stream);
+      sizeSink = builder.vertices.size();
+    }));
+  }
+
+  // Builder::loadModel 전체 (OBJ parse + welding)
+  {
+    const std::string objPath = "kernel_benchmark_grid.obj";
+    const size_t indexCount = writeGridObj(objPath, 128);
+    lve::LveModel::Builder builder{};
+    results.push_back(
+        measure("Builder::loadModel", "index", indexCount, [&] {
+          builder.loadModel(objPath);
+          sizeSink = builder.vertices.size();
+        }));
+    std::remove(objPath.c_str());
+  }
+
+  // 직전 실행과 비교 (ns/op가 작을수록 좋음)
+  const std::string previous = lastLine(historyPath);
+  std::printf("%-38s %12s %14s %10s %10s\n", "kernel", "ns/op", "Mops/s",
+              "allocs/op", "vs prev");
+  for (const auto &result : results) {
+    double previousNs;
+    char change[16] = "-";
+    if (findNsPerOp(previous, result.name, previousNs) && previousNs > 0.0) {
+      std::snprintf(change, sizeof(change), "%+.1f%%",
+                    (result.nsPerOp / previousNs - 1.0) * 100.0);
+    }
+    const std::string name = result.name + " (" + result.unit + ")";
+    std::printf("%-38s %12.2f %14.2f %10.3f %10s\n", name.c_str(),
+                result.nsPerOp, result.opsPerSecond / 1e6,
+                result.allocationsPerOp, change);
+  }
+
+  appendHistory(historyPath, label, results);
+  std::printf("appended to %s\n", historyPath.c_str());
+  return 0;
+}
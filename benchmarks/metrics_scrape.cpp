@@ -0,0 +1,113 @@
+#include "lve_metrics.hpp"
+#include "lve_metrics_server.hpp"
+
+// std
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <string>
+#include <thread>
+#include <vector>
+
+// posix
+#include <unistd.h>
+
+// 실행 중인 FirstApp (--metrics)의 metrics endpoint를 한 번 읽어서 출력
+// --self-test: 이 process 안에서 server를 열고 갱신 중인 metric을 scrape해서
+//              형식과 값을 확인 (GPU, window 불필요)
+//
+// 사용법: metrics_scrape [address] [--self-test]
+
+namespace {
+
+constexpr uint32_t SELF_TEST_FRAMES = 1000;
+
+bool contains(const std::string &text, const std::string &line) {
+  return text.find(line + "\n") != std::string::npos;
+}
+
+int selfTest() {
+  const std::string address =
+      "unix:/tmp/lve_metrics_self_test_" + std::to_string(getpid()) + ".sock";
+
+  auto &frames = lve::LveMetrics::counter("lve_self_test_frames_total",
+                                          "Frames written by the self test");
+  auto &depth =
+      lve::LveMetrics::gauge("lve_self_test_depth", "Self test gauge");
+  auto &frameTime = lve::LveMetrics::histogram(
+      "lve_self_test_frame_time_seconds", "Self test histogram",
+      lve::LveMetrics::frameTimeBuckets());
+
+  lve::LveMetricsServer server{address};
+
+  // render thread처럼 scrape 중에도 계속 갱신
+  std::thread writer{[&] {
+    for (uint32_t frame = 0; frame < SELF_TEST_FRAMES; frame++) {
+      frames.add();
+      depth.set(frame % 4);
+      frameTime.observe(frame % 2 == 0 ? 0.005 : 0.02);
+    }
+  }};
+  const std::string during = lve::LveMetricsServer::scrape(address);
+  writer.join();
+  const std::string after = lve::LveMetricsServer::scrape(address);
+
+  const std::vector<std::string> expected = {
+      "# TYPE lve_self_test_frames_total counter",
+      "lve_self_test_frames_total " + std::to_string(SELF_TEST_FRAMES),
+      "# TYPE lve_self_test_depth gauge",
+      "lve_self_test_depth 3",
+      "# TYPE lve_self_test_frame_time_seconds histogram",
+      "lve_self_test_frame_time_seconds_bucket{le=\"0.00694444444\"} " +
+          std::to_string(SELF_TEST_FRAMES / 2),
+      "lve_self_test_frame_time_seconds_bucket{le=\"+Inf\"} " +
+          std::to_string(SELF_TEST_FRAMES),
+      "lve_self_test_frame_time_seconds_count " +
+          std::to_string(SELF_TEST_FRAMES),
+  };
+  bool passed = contains(during, "# TYPE lve_self_test_frames_total counter");
+  for (const auto &line : expected) {
+    if (!contains(after, line)) {
+      std::fprintf(stderr, "missing line: %s\n", line.c_str());
+      passed = false;
+    }
+  }
+  if (server.scrapeCount() != 2) {
+    std::fprintf(stderr, "expected 2 scrapes, server answered %llu\n",
+                 static_cast<unsigned long long>(server.scrapeCount()));
+    passed = false;
+  }
+
+  std::printf("%s", after.c_str());
+  std::printf("metrics self test %s\n", passed ? "passed" : "FAILED");
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::string address = lve::LveMetricsServer::DEFAULT_ADDRESS;
+  bool runSelfTest = false;
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (arg == "--self-test") {
+      runSelfTest = true;
+    } else if (arg.rfind("--", 0) != 0) {
+      address = arg;
+    } else {
+      std::fprintf(stderr, "unknown argument '%s'\n", arg.c_str());
+      return EXIT_FAILURE;
+    }
+  }
+
+  try {
+    if (runSelfTest) {
+      return selfTest();
+    }
+    std::printf("%s", lve::LveMetricsServer::scrape(address).c_str());
+  } catch (const std::exception &e) {
+    std::fprintf(stderr, "%s\n", e.what());
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,139 @@
+#include "lve_profiler.hpp"
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <thread>
+#include <vector>
+
+// LVE_PROFILE_SCOPE 하나의 비용 측정 (목표 50 ns 이하)
+// 단일 thread, 중첩, 여러 thread 동시 기록, trace 수집 시간 출력
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t ITERATIONS = 10'000'000;
+constexpr double BUDGET_NS = 50.0;
+
+double elapsedNs(Clock::time_point start) {
+  return std::chrono::duration<double, std::nano>(Clock::now() - start)
+      .count();
+}
+
+// 최적화로 loop가 사라지지 않도록 하는 최소 작업
+volatile uint64_t sink = 0;
+
+// 다른 thread와 core를 나눠 쓰는 동안의 대기 시간을 빼기 위해 thread CPU 시간 사용
+double threadCpuNs() {
+  timespec time{};
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+  return time.tv_sec * 1e9 + time.tv_nsec;
+}
+
+double baselineNs() {
+  const auto start = Clock::now();
+  for (size_t i = 0; i < ITERATIONS; i++) {
+    sink = sink + i;
+  }
+  return elapsedNs(start) / ITERATIONS;
+}
+
+double scopedNs() {
+  const auto start = Clock::now();
+  for (size_t i = 0; i < ITERATIONS; i++) {
+    LVE_PROFILE_SCOPE("benchmark scope");
+    sink = sink + i;
+  }
+  return elapsedNs(start) / ITERATIONS;
+}
+
+// 바깥 구간 하나에 안쪽 구간 하나 -> 구간 2개 비용
+double nestedNs() {
+  const auto start = Clock::now();
+  for (size_t i = 0; i < ITERATIONS / 2; i++) {
+    LVE_PROFILE_SCOPE("outer");
+    {
+      LVE_PROFILE_SCOPE("inner");
+      sink = sink + i;
+    }
+  }
+  return elapsedNs(start) / ITERATIONS;
+}
+
+double steadyClockNs() {
+  const auto start = Clock::now();
+  for (size_t i = 0; i < ITERATIONS; i++) {
+    sink = sink + Clock::now().time_since_epoch().count();
+  }
+  return elapsedNs(start) / ITERATIONS;
+}
+
+void printScope(const char *name, double ns, double baseline) {
+  const double cost = std::max(0.0, ns - baseline);
+  std::printf("%-28s %6.1f ns/scope %s\n", name, cost,
+              cost <= BUDGET_NS ? "" : "(over budget)");
+}
+
+} // namespace
+
+int main() {
+#if !LVE_PROFILER
+  std::printf("LVE_PROFILER=0 -> scopes compile to nothing\n");
+#endif
+  LVE_PROFILE_THREAD("benchmark main");
+  // thread buffer 등록은 처음 한 번만
+  { LVE_PROFILE_SCOPE("warm up"); }
+
+  const double baseline = baselineNs();
+  std::printf("loop baseline               %6.1f ns/iteration\n", baseline);
+  std::printf("steady_clock::now()         %6.1f ns/call (reference)\n",
+              steadyClockNs() - baseline);
+
+  printScope("single thread", scopedNs(), baseline);
+  printScope("nested (2 per iteration)", nestedNs(), baseline / 2);
+
+  // thread마다 자기 buffer에 기록 -> 공유하는 cache line이 없어야 함
+  const unsigned threadCount =
+      std::max(2u, std::min(8u, std::thread::hardware_concurrency()));
+  std::vector<double> results(threadCount);
+  std::vector<std::thread> threads;
+  std::atomic<bool> go{false};
+  for (unsigned t = 0; t < threadCount; t++) {
+    threads.emplace_back([&, t] {
+      LVE_PROFILE_THREAD("benchmark worker " + std::to_string(t));
+      { LVE_PROFILE_SCOPE("warm up"); }
+      while (!go.load()) {
+        std::this_thread::yield();
+      }
+      // sink를 공유하면 cache line을 주고받는 비용이 섞임
+      volatile uint64_t localSink = 0;
+      const double cpuStart = threadCpuNs();
+      for (size_t i = 0; i < ITERATIONS; i++) {
+        LVE_PROFILE_SCOPE("benchmark scope");
+        localSink = localSink + i;
+      }
+      results[t] = (threadCpuNs() - cpuStart) / ITERATIONS;
+    });
+  }
+  go.store(true);
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  std::printf("%u threads                    ", threadCount);
+  for (double ns : results) {
+    std::printf(" %5.1f", std::max(0.0, ns - baseline));
+  }
+  std::printf(" ns/scope (thread CPU time)\n");
+
+  // 모든 buffer가 가득 찬 상태에서 수집 비용
+  const auto start = Clock::now();
+  std::vector<lve::LveTraceEvent> events;
+  lve::LveProfiler::collectTraceEvents(events);
+  std::printf("collect %zu events from %zu threads: %.2f ms\n", events.size(),
+              lve::LveProfiler::threads().size(), elapsedNs(start) / 1e6);
+  return 0;
+}
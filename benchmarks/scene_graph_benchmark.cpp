@@ -0,0 +1,102 @@
+#include "lve_scene_graph.hpp"
+
+// std
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// LveSceneGraph 전파 비용 측정
+// 4진 트리 형태의 hierarchy에서 단일 thread와 job system 결과를 비교
+
+namespace {
+
+struct Scenario {
+  const char *name;
+  size_t movedNodes; // 0이면 root만 이동
+};
+
+void printStats(const char *name, const lve::LveSceneGraph::Stats &stats) {
+  std::printf("  %-14s levels %3zu  local %8zu  world %8zu  reorder %8.3f ms  "
+              "propagate %8.3f ms\n",
+              name, stats.levelCount, stats.localRecomputed,
+              stats.worldRecomputed, stats.reorderMs, stats.propagateMs);
+}
+
+} // namespace
+
+int main() {
+  constexpr size_t BRANCHING = 4;
+  std::mt19937 rng{42};
+  std::uniform_real_distribution<float> dist{-1.f, 1.f};
+
+  lve::LveJobSystem jobSystem{};
+  std::printf("worker threads: %zu\n", jobSystem.workerCount());
+
+  for (size_t count : {size_t{100'000}, size_t{1'000'000}}) {
+    std::printf("nodes: %zu\n", count);
+
+    lve::LveSceneGraph serial{};
+    lve::LveSceneGraph parallel{&jobSystem};
+    std::vector<lve::LveSceneGraph::node_t> nodes;
+    nodes.reserve(count);
+
+    for (size_t i = 0; i < count; i++) {
+      lve::TransformComponent local{};
+      local.translation = {dist(rng), dist(rng), dist(rng)};
+      local.rotation = {dist(rng), dist(rng), dist(rng)};
+      auto parent = i == 0 ? lve::LveSceneGraph::NO_PARENT
+                           : nodes[(i - 1) / BRANCHING];
+      nodes.push_back(serial.createNode(local, parent));
+      parallel.createNode(local, parent);
+    }
+
+    for (auto *graph : {&serial, &parallel}) {
+      graph->update();
+    }
+    printStats("build serial", serial.getStats());
+    printStats("build parallel", parallel.getStats());
+
+    const Scenario scenarios[] = {
+        {"idle", 0}, {"1% moved", count / 100}, {"root moved", 0}};
+    std::uniform_int_distribution<size_t> pick{0, count - 1};
+
+    for (const auto &scenario : scenarios) {
+      std::vector<size_t> moved;
+      if (scenario.movedNodes > 0) {
+        for (size_t i = 0; i < scenario.movedNodes; i++) {
+          moved.push_back(pick(rng));
+        }
+      } else if (scenario.name[0] == 'r') {
+        moved.push_back(0);
+      }
+
+      for (auto *graph : {&serial, &parallel}) {
+        for (size_t index : moved) {
+          auto local = graph->getLocalTransform(nodes[index]);
+          local.translation.x += 0.1f;
+          graph->setLocalTransform(nodes[index], local);
+        }
+        graph->update();
+      }
+
+      std::printf(" %s\n", scenario.name);
+      printStats("serial", serial.getStats());
+      printStats("parallel", parallel.getStats());
+    }
+
+    float error = 0.f;
+    for (auto node : nodes) {
+      const auto &a = serial.worldMatrix(node);
+      const auto &b = parallel.worldMatrix(node);
+      for (int c = 0; c < 4; c++) {
+        for (int r = 0; r < 4; r++) {
+          error = std::max(error, glm::abs(a[c][r] - b[c][r]));
+        }
+      }
+    }
+    std::printf(" serial/parallel max difference: %.2e\n", error);
+  }
+
+  return 0;
+}
@@ -0,0 +1,546 @@
+#include "lve_bvh.hpp"
+#include "lve_camera.hpp"
+#include "lve_device.hpp"
+#include "lve_ecs.hpp"
+#include "lve_frame_info.hpp"
+#include "lve_late_latch.hpp"
+#include "lve_model.hpp"
+#include "lve_renderer.hpp"
+#include "lve_scene_graph.hpp"
+#include "lve_window.hpp"
+#include "simple_render_system.hpp"
+
+// libs
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+
+// std
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+// 합성 scene을 정해진 camera 경로로 그리면서 frame별 비용 측정
+// scene마다 CPU frame time, GPU frame time, draw call 수, 메모리의 p50/p99를
+// JSON으로 저장하고, --baseline 결과보다 threshold 이상 나빠진 값을 표시
+//
+// GPU 없는 CI: make stress (lavapipe + --headless, GLFW 3.4 null platform)
+//
+// model을 만들 때 geometry upload 처리량도 기록 (direct write 또는 staging,
+// --staging-uploads면 항상 staging -> 두 경로 비교)
+//
+// 사용법: stress_benchmark [--headless] [--frames N] [--output path]
+//                          [--baseline path] [--threshold 0.1]
+//                          [--staging-uploads]
+//                          [--scene name:objects:models:triangles:overlap]...
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int WIDTH = 800;
+constexpr int HEIGHT = 600;
+// 측정 전에 pipeline, cache, swap chain이 자리 잡도록 버리는 frame
+constexpr uint32_t WARM_UP_FRAMES = 30;
+// GPU 구간은 profiler가 보관하는 frame만 읽을 수 있음
+constexpr uint32_t MAX_FRAMES = lve::LveGpuProfiler::TRACE_FRAMES;
+// 한 object의 반지름, object 사이 기본 간격
+constexpr float OBJECT_RADIUS = 0.5f;
+constexpr float OBJECT_SPACING = 2.0f;
+
+struct SceneConfig {
+  std::string name;
+  uint32_t objects;
+  uint32_t models;
+  uint32_t triangles; // model 하나의 목표 삼각형 수
+  float overlap;      // 0이면 간격대로 흩어짐, 1에 가까울수록 한 곳에 겹침
+};
+
+const std::vector<SceneConfig> &defaultScenes() {
+  static const std::vector<SceneConfig> scenes{
+      {"baseline", 100, 4, 1'000, 0.2f},
+      {"many objects", 5'000, 8, 500, 0.2f},
+      {"dense meshes", 200, 4, 50'000, 0.2f},
+      {"heavy overlap", 1'000, 4, 2'000, 0.9f},
+  };
+  return scenes;
+}
+
+struct Metric {
+  const char *name;
+  std::vector<double> samples;
+  double p50 = 0.0;
+  double p99 = 0.0;
+};
+
+struct SceneResult {
+  SceneConfig config;
+  uint64_t trianglesPerModel = 0;
+  uint64_t geometryBytes = 0;
+  const char *uploadPath = "staging";
+  double uploadMibPerSecond = 0.0;
+  std::vector<Metric> metrics;
+};
+
+// 실행 환경과 무관하게 같은 scene이 나오도록 표준 분포 대신 직접 구현
+class Random {
+public:
+  explicit Random(uint64_t seed) : state{seed} {}
+
+  float next() {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return static_cast<float>(state >> 40) / static_cast<float>(1 << 24);
+  }
+  float range(float low, float high) { return low + (high - low) * next(); }
+
+private:
+  uint64_t state;
+};
+
+// p (0..1) 위치의 값, values의 순서는 바뀜
+double percentile(std::vector<double> &values, double p) {
+  if (values.empty()) {
+    return 0.0;
+  }
+  const size_t index =
+      std::min(values.size() - 1,
+               static_cast<size_t>(p * static_cast<double>(values.size())));
+  std::nth_element(values.begin(), values.begin() + index, values.end());
+  return values[index];
+}
+
+double residentMemoryMb() {
+#if defined(__linux__)
+  std::ifstream statm{"/proc/self/statm"};
+  uint64_t size = 0;
+  uint64_t resident = 0;
+  statm >> size >> resident;
+  return static_cast<double>(resident) *
+         static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+#else
+  return 0.0;
+#endif
+}
+
+/**
+ * @brief 약 triangles개 삼각형의 UV sphere
+ * ring r, segment 2r -> 삼각형 약 4r^2
+ */
+lve::LveModel::Builder makeSphere(uint32_t triangles, const glm::vec3 &color) {
+  const auto rings = std::max<uint32_t>(
+      3, static_cast<uint32_t>(std::lround(std::sqrt(triangles / 4.0))));
+  const uint32_t segments = rings * 2;
+
+  lve::LveModel::Builder builder{};
+  for (uint32_t ring = 0; ring <= rings; ring++) {
+    const float phi = glm::pi<float>() * ring / rings;
+    for (uint32_t segment = 0; segment <= segments; segment++) {
+      const float theta = glm::two_pi<float>() * segment / segments;
+      lve::LveModel::Vertex vertex{};
+      vertex.normal = {std::sin(phi) * std::cos(theta), std::cos(phi),
+                       std::sin(phi) * std::sin(theta)};
+      vertex.position = vertex.normal * OBJECT_RADIUS;
+      vertex.color = color;
+      vertex.uv = {static_cast<float>(segment) / segments,
+                   static_cast<float>(ring) / rings};
+      builder.vertices.push_back(vertex);
+    }
+  }
+
+  const uint32_t stride = segments + 1;
+  for (uint32_t ring = 0; ring < rings; ring++) {
+    for (uint32_t segment = 0; segment < segments; segment++) {
+      const uint32_t a = ring * stride + segment;
+      const uint32_t b = a + stride;
+      // 극점의 퇴화 삼각형은 빼고 셈
+      if (ring != 0) {
+        builder.indices.insert(builder.indices.end(), {a, b, a + 1});
+      }
+      if (ring != rings - 1) {
+        builder.indices.insert(builder.indices.end(), {a + 1, b, b + 1});
+      }
+    }
+  }
+  return builder;
+}
+
+/**
+ * @brief 주어진 장치로 scene 하나를 만들고 정해진 경로를 따라 그림
+ */
+class StressRunner {
+public:
+  StressRunner(bool headless, uint32_t frames, bool stagingUploads)
+      : lveWindow{WIDTH, HEIGHT, "lve stress benchmark", headless},
+        frames{frames} {
+    // vsync 없이 가능한 빨리 그림 (지원하지 않으면 FIFO)
+    lveRenderer.setFramePacing(lve::LveFramePacing::presets()[1]);
+    lveDevice.setDirectUploadEnabled(!stagingUploads);
+  }
+
+  const char *deviceName() const { return lveDevice.properties.deviceName; }
+
+  SceneResult run(const SceneConfig &config) {
+    SceneResult result{};
+    result.config = config;
+
+    // model마다 색을 다르게 -> 같은 삼각형 수라도 다른 buffer
+    Random random{0x5eed0000u + config.objects * 31u + config.models};
+    std::vector<std::unique_ptr<lve::LveModel>> models;
+    const auto directBefore =
+        lveDevice.getUploadStats(lve::LveDevice::UploadPath::DIRECT);
+    const auto stagingBefore =
+        lveDevice.getUploadStats(lve::LveDevice::UploadPath::STAGING);
+    for (uint32_t i = 0; i < config.models; i++) {
+      const auto builder = makeSphere(
+          config.triangles, {random.next(), random.next(), random.next()});
+      result.trianglesPerModel = builder.indices.size() / 3;
+      result.geometryBytes +=
+          builder.vertices.size() * sizeof(lve::LveModel::Vertex) +
+          builder.indices.size() * sizeof(uint32_t);
+      models.push_back(std::make_unique<lve::LveModel>(lveDevice, builder));
+    }
+    const auto direct =
+        lveDevice.getUploadStats(lve::LveDevice::UploadPath::DIRECT);
+    const auto staging =
+        lveDevice.getUploadStats(lve::LveDevice::UploadPath::STAGING);
+    lve::LveDevice::UploadStats uploads{};
+    uploads.bytes = direct.bytes - directBefore.bytes + staging.bytes -
+                    stagingBefore.bytes;
+    uploads.seconds = direct.seconds - directBefore.seconds + staging.seconds -
+                      stagingBefore.seconds;
+    result.uploadPath =
+        direct.count > directBefore.count ? "direct" : "staging";
+    result.uploadMibPerSecond = uploads.mibPerSecond();
+
+    // overlap이 클수록 같은 수의 object를 더 작은 공간에 배치
+    const float extent =
+        std::max(OBJECT_RADIUS, OBJECT_SPACING *
+                                    std::cbrt(static_cast<float>(
+                                        config.objects)) *
+                                    (1.f - config.overlap) * 0.5f);
+
+    lve::LveRegistry registry;
+    lve::LveSceneGraph sceneGraph;
+    lve::LveBvh bvh;
+    for (uint32_t i = 0; i < config.objects; i++) {
+      auto entity = registry.create();
+      lve::TransformComponent transform{};
+      transform.translation = {random.range(-extent, extent),
+                               random.range(-extent, extent),
+                               random.range(-extent, extent)};
+      transform.rotation = {random.range(0.f, glm::two_pi<float>()),
+                            random.range(0.f, glm::two_pi<float>()), 0.f};
+      lve::LveModel *model = models[i % models.size()].get();
+      registry.add<lve::ModelComponent>(entity, {model});
+      registry.add<lve::TransformComponent>(entity, transform);
+      registry.add<lve::ColorComponent>(entity);
+      const lve::LveAabb bounds =
+          model->getBoundingBox().transformed(transform.mat4());
+      registry.add<lve::BvhProxyComponent>(entity,
+                                           {bvh.insert(bounds, entity.index)});
+    }
+
+    Metric cpuFrame{"cpu_frame_ms", {}};
+    Metric drawCalls{"draw_calls", {}};
+    Metric residentMemory{"resident_mb", {}};
+    auto &gpuProfiler = lveRenderer.getGpuProfiler();
+
+    lve::LveCamera camera{};
+    const float pathRadius = extent + 2.f;
+    for (uint32_t frame = 0; frame < WARM_UP_FRAMES + frames; frame++) {
+      if (frame == WARM_UP_FRAMES) {
+        // warm-up frame의 GPU 구간이 측정에 섞이지 않도록 모두 읽고 버림
+        vkDeviceWaitIdle(lveDevice.device());
+        gpuProfiler.resolveAll();
+        gpuProfiler.resetStats();
+      }
+      glfwPollEvents();
+
+      // 고정 간격 경로 -> 실행 속도와 무관하게 frame마다 같은 view
+      const float t = static_cast<float>(frame) / (WARM_UP_FRAMES + frames);
+      auto pathPoint = [&](float s) {
+        const float angle = glm::two_pi<float>() * s;
+        return glm::vec3{pathRadius * std::cos(angle),
+                         0.5f * extent * std::sin(2.f * angle),
+                         pathRadius * std::sin(angle) * 0.6f};
+      };
+      const glm::vec3 position = pathPoint(t);
+      camera.setViewDirection(position, pathPoint(t + 0.02f) - position);
+      camera.setPerspectiveProjection(glm::radians(60.f),
+                                      lveRenderer.getAspectRatio(), 0.1f,
+                                      pathRadius * 4.f);
+
+      const auto start = Clock::now();
+      auto commandBuffer = lveRenderer.beginFrame();
+      if (commandBuffer == nullptr) {
+        continue;
+      }
+      const int frameIndex = lveRenderer.getFrameIndex();
+      lateLatch.record(frameIndex, camera.getProjection() * camera.getView());
+
+      lveRenderer.beginSwapChainRenderPass(commandBuffer);
+      lve::FrameInfo frameInfo{frameIndex,
+                               1.f / 60.f,
+                               commandBuffer,
+                               camera,
+                               lateLatch.getDescriptorSet(frameIndex),
+                               registry,
+                               sceneGraph,
+                               &bvh,
+                               &gpuProfiler};
+      simpleRenderSystem.renderGameObjects(frameInfo);
+      lveRenderer.endSwapChainRenderPass(commandBuffer);
+      lveRenderer.endFrame();
+      const double elapsedMs =
+          std::chrono::duration<double, std::milli>(Clock::now() - start)
+              .count();
+
+      if (frame >= WARM_UP_FRAMES) {
+        cpuFrame.samples.push_back(elapsedMs);
+        drawCalls.samples.push_back(simpleRenderSystem.getDrawCount());
+        residentMemory.samples.push_back(residentMemoryMb());
+      }
+    }
+
+    // 아직 읽지 않은 slot까지 읽어서 측정 구간의 GPU frame을 모두 모음
+    vkDeviceWaitIdle(lveDevice.device());
+    gpuProfiler.resolveAll();
+    std::vector<lve::LveTraceEvent> events;
+    gpuProfiler.collectTraceEvents(events);
+    Metric gpuFrame{"gpu_frame_ms", {}};
+    for (const auto &event : events) {
+      if (std::strcmp(event.name, "frame") == 0) {
+        gpuFrame.samples.push_back(event.durationUs / 1000.0);
+      }
+    }
+
+    result.metrics = {std::move(cpuFrame), std::move(gpuFrame),
+                      std::move(drawCalls), std::move(residentMemory)};
+    for (auto &metric : result.metrics) {
+      metric.p50 = percentile(metric.samples, 0.50);
+      metric.p99 = percentile(metric.samples, 0.99);
+    }
+    // model은 deferred destruction -> 다음 scene 중에 파괴됨
+    return result;
+  }
+
+private:
+  lve::LveWindow lveWindow;
+  lve::LveDevice lveDevice{lveWindow};
+  lve::LveRenderer lveRenderer{lveWindow, lveDevice};
+  lve::LveLateLatch lateLatch{lveDevice};
+  lve::SimpleRenderSystem simpleRenderSystem{
+      lveDevice, lveRenderer.getSwapChainRenderPass(),
+      lateLatch.getDescriptorSetLayout()};
+  uint32_t frames;
+};
+
+void writeJson(std::ostream &out, const char *device, uint32_t frames,
+               const std::vector<SceneResult> &results) {
+  // --baseline에서 한 줄씩 다시 읽으므로 metric은 한 줄에 하나
+  out << "{\n  \"device\": \"" << device << "\",\n  \"frames\": " << frames
+      << ",\n  \"scenes\": [\n";
+  for (size_t i = 0; i < results.size(); i++) {
+    const auto &result = results[i];
+    const auto &config = result.config;
+    out << "    {\n      \"name\": \"" << config.name << "\",\n"
+        << "      \"objects\": " << config.objects << ",\n"
+        << "      \"models\": " << config.models << ",\n"
+        << "      \"triangles_per_model\": " << result.trianglesPerModel
+        << ",\n"
+        << "      \"overlap\": " << config.overlap << ",\n"
+        << "      \"geometry_kib\": " << result.geometryBytes / 1024 << ",\n"
+        << "      \"upload_path\": \"" << result.uploadPath << "\",\n"
+        << "      \"upload_mib_per_s\": " << result.uploadMibPerSecond
+        << ",\n"
+        << "      \"metrics\": {\n";
+    for (size_t m = 0; m < result.metrics.size(); m++) {
+      const auto &metric = result.metrics[m];
+      out << "        \"" << metric.name << "\": {\"p50\": " << metric.p50
+          << ", \"p99\": " << metric.p99 << "}"
+          << (m + 1 < result.metrics.size() ? "," : "") << "\n";
+    }
+    out << "      }\n    }" << (i + 1 < results.size() ? "," : "") << "\n";
+  }
+  out << "  ]\n}\n";
+}
+
+/**
+ * @brief baseline JSON(이 benchmark가 쓴 형식)에서 scene의 metric 값 찾기
+ * @return 없으면 false
+ */
+bool findBaseline(const std::string &json, const std::string &scene,
+                  const char *metric, double &p50, double &p99) {
+  const std::string nameKey = "\"name\": \"" + scene + "\"";
+  const size_t sceneBegin = json.find(nameKey);
+  if (sceneBegin == std::string::npos) {
+    return false;
+  }
+  const size_t sceneEnd = json.find("\"name\": ", sceneBegin + nameKey.size());
+  const size_t metricBegin =
+      json.find("\"" + std::string{metric} + "\": ", sceneBegin);
+  if (metricBegin == std::string::npos || metricBegin > sceneEnd) {
+    return false;
+  }
+  return std::sscanf(json.c_str() + metricBegin + std::strlen(metric) + 4,
+                     "{\"p50\": %lf, \"p99\": %lf}", &p50, &p99) == 2;
+}
+
+/**
+ * @brief 모든 metric은 작을수록 좋음, baseline보다 threshold 이상 크면 regression
+ * @return regression 수
+ */
+int compareBaseline(const std::string &json,
+                    const std::vector<SceneResult> &results,
+                    double threshold) {
+  int regressions = 0;
+  for (const auto &result : results) {
+    for (const auto &metric : result.metrics) {
+      double baseP50, baseP99;
+      if (!findBaseline(json, result.config.name, metric.name, baseP50,
+                        baseP99)) {
+        std::printf("%-16s %-14s no baseline\n", result.config.name.c_str(),
+                    metric.name);
+        continue;
+      }
+      auto check = [&](const char *label, double base, double now) {
+        const double change = base > 0.0 ? now / base - 1.0 : 0.0;
+        const bool regressed = change > threshold;
+        regressions += regressed ? 1 : 0;
+        std::printf("%-16s %-14s %s %10.3f -> %10.3f (%+6.1f%%)%s\n",
+                    result.config.name.c_str(), metric.name, label, base, now,
+                    change * 100.0, regressed ? "  REGRESSION" : "");
+      };
+      check("p50", baseP50, metric.p50);
+      check("p99", baseP99, metric.p99);
+    }
+  }
+  return regressions;
+}
+
+// name:objects:models:triangles:overlap
+bool parseScene(const std::string &text, SceneConfig &config) {
+  std::stringstream stream{text};
+  std::string field;
+  std::vector<std::string> fields;
+  while (std::getline(stream, field, ':')) {
+    fields.push_back(field);
+  }
+  if (fields.size() != 5) {
+    return false;
+  }
+  try {
+    config = {fields[0], static_cast<uint32_t>(std::stoul(fields[1])),
+              static_cast<uint32_t>(std::stoul(fields[2])),
+              static_cast<uint32_t>(std::stoul(fields[3])),
+              std::stof(fields[4])};
+  } catch (const std::exception &) {
+    return false;
+  }
+  return config.objects > 0 && config.models > 0 && config.overlap >= 0.f &&
+         config.overlap < 1.f;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  bool headless = false;
+  bool stagingUploads = false;
+  uint32_t frames = MAX_FRAMES;
+  std::string outputPath = "stress_results.json";
+  std::string baselinePath;
+  double threshold = 0.10;
+  std::vector<SceneConfig> scenes;
+
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    const bool hasValue = i + 1 < argc;
+    if (arg == "--headless") {
+      headless = true;
+    } else if (arg == "--staging-uploads") {
+      stagingUploads = true;
+    } else if (arg == "--frames" && hasValue) {
+      frames = static_cast<uint32_t>(std::stoul(argv[++i]));
+    } else if (arg == "--output" && hasValue) {
+      outputPath = argv[++i];
+    } else if (arg == "--baseline" && hasValue) {
+      baselinePath = argv[++i];
+    } else if (arg == "--threshold" && hasValue) {
+      threshold = std::stod(argv[++i]);
+    } else if (arg == "--scene" && hasValue) {
+      SceneConfig config{};
+      if (!parseScene(argv[++i], config)) {
+        std::fprintf(stderr, "invalid scene '%s'\n", argv[i]);
+        return 2;
+      }
+      scenes.push_back(config);
+    } else {
+      std::fprintf(stderr, "unknown argument '%s'\n", arg.c_str());
+      return 2;
+    }
+  }
+  if (scenes.empty()) {
+    scenes = defaultScenes();
+  }
+  if (frames == 0 || frames > MAX_FRAMES) {
+    std::fprintf(stderr, "--frames must be 1..%u\n", MAX_FRAMES);
+    return 2;
+  }
+
+  std::vector<SceneResult> results;
+  std::string device;
+  try {
+    StressRunner runner{headless, frames, stagingUploads};
+    device = runner.deviceName();
+    for (const auto &scene : scenes) {
+      results.push_back(runner.run(scene));
+      const auto &result = results.back();
+      std::printf("%-16s %6u objects %8llu tris/model:", scene.name.c_str(),
+                  scene.objects,
+                  static_cast<unsigned long long>(result.trianglesPerModel));
+      for (const auto &metric : result.metrics) {
+        std::printf("  %s %.3f/%.3f", metric.name, metric.p50, metric.p99);
+      }
+      std::printf("  upload %s %.1f MiB/s\n", result.uploadPath,
+                  result.uploadMibPerSecond);
+    }
+  } catch (const std::exception &e) {
+    std::fprintf(stderr, "%s\n", e.what());
+    return 1;
+  }
+
+  std::ofstream output{outputPath};
+  writeJson(output, device.c_str(), frames, results);
+  std::printf("results written to %s\n", outputPath.c_str());
+
+  if (baselinePath.empty()) {
+    return 0;
+  }
+  std::ifstream baselineFile{baselinePath};
+  if (!baselineFile) {
+    std::fprintf(stderr, "failed to read baseline %s\n", baselinePath.c_str());
+    return 1;
+  }
+  const std::string baseline{std::istreambuf_iterator<char>{baselineFile},
+                             std::istreambuf_iterator<char>{}};
+  const int regressions = compareBaseline(baseline, results, threshold);
+  std::printf("%d regressions (threshold %+.0f%%)\n", regressions,
+              threshold * 100.0);
+  return regressions > 0 ? 1 : 0;
+}
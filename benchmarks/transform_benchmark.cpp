@@ -0,0 +1,104 @@
+#include "lve_transform_system.hpp"
+
+// std
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// TransformComponent::mat4()와 LveTransformSystem 비교
+// 10k, 100k, 1M 객체에서 전체 갱신과 10% dirty 갱신 시간을 측정
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+float maxError(const glm::mat4 &a, const glm::mat4 &b) {
+  float error = 0.f;
+  for (int c = 0; c < 4; c++) {
+    for (int r = 0; r < 4; r++) {
+      error = std::max(error, glm::abs(a[c][r] - b[c][r]));
+    }
+  }
+  return error;
+}
+
+} // namespace
+
+int main() {
+  constexpr int REPEAT = 5;
+  std::mt19937 rng{42};
+  std::uniform_real_distribution<float> position{-100.f, 100.f};
+  std::uniform_real_distribution<float> angle{-glm::two_pi<float>(),
+                                              glm::two_pi<float>()};
+  std::uniform_real_distribution<float> scale{0.1f, 2.f};
+
+  std::printf("lanes: %u\n", lve::LveTransformSystem::LANES);
+  std::printf("%10s %14s %14s %14s %10s %12s\n", "objects", "scalar ms",
+              "simd full ms", "simd 10% ms", "speedup", "max error");
+
+  for (size_t count : {size_t{10'000}, size_t{100'000}, size_t{1'000'000}}) {
+    std::vector<lve::TransformComponent> transforms(count);
+    for (auto &transform : transforms) {
+      transform.translation = {position(rng), position(rng), position(rng)};
+      transform.rotation = {angle(rng), angle(rng), angle(rng)};
+      transform.scale = {scale(rng), scale(rng), scale(rng)};
+    }
+
+    // scalar: 매 프레임 모든 객체 mat4() 호출
+    std::vector<glm::mat4> scalarResults(count);
+    double scalarMs = 1e30;
+    for (int i = 0; i < REPEAT; i++) {
+      auto start = Clock::now();
+      for (size_t j = 0; j < count; j++) {
+        scalarResults[j] = transforms[j].mat4();
+      }
+      scalarMs = std::min(scalarMs, elapsedMs(start));
+    }
+
+    lve::LveTransformSystem system;
+    for (const auto &transform : transforms) {
+      system.add(transform);
+    }
+
+    double fullMs = 1e30;
+    for (int i = 0; i < REPEAT; i++) {
+      system.markAllDirty();
+      auto start = Clock::now();
+      system.update();
+      fullMs = std::min(fullMs, elapsedMs(start));
+    }
+
+    float error = 0.f;
+    for (size_t j = 0; j < count; j++) {
+      error = std::max(error, maxError(scalarResults[j],
+                                       system.worldMatrix(
+                                           static_cast<uint32_t>(j))));
+    }
+
+    // 10% 객체만 움직인 프레임
+    std::uniform_int_distribution<uint32_t> pick{
+        0, static_cast<uint32_t>(count - 1)};
+    double partialMs = 1e30;
+    for (int i = 0; i < REPEAT; i++) {
+      for (size_t j = 0; j < count / 10; j++) {
+        auto handle = pick(rng);
+        system.setTranslation(handle, system.getTranslation(handle) + 0.1f);
+      }
+      auto start = Clock::now();
+      system.update();
+      partialMs = std::min(partialMs, elapsedMs(start));
+    }
+
+    std::printf("%10zu %14.3f %14.3f %14.3f %9.2fx %12.2e\n", count, scalarMs,
+                fullMs, partialMs, scalarMs / fullMs, error);
+  }
+
+  return 0;
+}
@@ -2,3 +2,4 @@
 # 첫번째 경로는 shader의 파일 경로 
 /Users/miyu/VulkanSDK/1.3.290.0/macOS/bin/glslc shaders/simple_shader.vert -o shaders/simple_shader.vert.spv
 /Users/miyu/VulkanSDK/1.3.290.0/macOS/bin/glslc shaders/simple_shader.frag -o shaders/simple_shader.frag.spv
+/Users/miyu/VulkanSDK/1.3.290.0/macOS/bin/glslc shaders/overdraw.frag -o shaders/overdraw.frag.spv
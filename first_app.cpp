@@ -1,6 +1,17 @@
 #include "first_app.hpp"
 #include "keyboard_movement_controller.hpp"
 #include "lve_camera.hpp"
+#include "lve_frame_capture.hpp"
+#include "lve_frame_info.hpp"
+#include "lve_frame_limiter.hpp"
+#include "lve_input.hpp"
+#include "lve_input_recording.hpp"
+#include "lve_log.hpp"
+#include "lve_metrics_server.hpp"
+#include "lve_profiler.hpp"
+#include "lve_simulation.hpp"
+#include "lve_trace.hpp"
+#include "lve_vulkan_dispatch.hpp"
 #include "simple_render_system.hpp"
 
 // libs
@@ -10,35 +21,415 @@
 #include <glm/gtc/constants.hpp>
 
 // std
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <chrono>
+#include <memory>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace lve {
 
-FirstApp::FirstApp() { loadGameObjects(); }
+namespace {
+
+// 보간 오차 정도의 차이는 같은 camera로 봄
+bool sameViewer(const TransformComponent &a, const TransformComponent &b) {
+  constexpr float EPSILON = 1e-5f;
+  const glm::vec3 translation = a.translation - b.translation;
+  const glm::vec3 rotation = a.rotation - b.rotation;
+  return glm::dot(translation, translation) < EPSILON * EPSILON &&
+         glm::dot(rotation, rotation) < EPSILON * EPSILON;
+}
+
+} // namespace
+
+FirstApp::FirstApp(Options options) : options{std::move(options)} {
+  loadGameObjects();
+  // model 로드는 동기식 -> 로드가 끝난 scene을 on-demand에서도 한 번은 그림
+  lveWindow.requestRedraw();
+}
 
 FirstApp::~FirstApp() {}
 
 void FirstApp::run() {
-  SimpleRenderSystem simpleRenderSystem{lveDevice,
-                                        lveRenderer.getSwapChainRenderPass()};
+  LVE_PROFILE_THREAD("main thread");
+  LveVulkanStats::timingEnabled = VULKAN_CALL_TIMING;
+
+  // renderer, device, model loader가 갱신한 metric을 background thread가 응답
+  std::unique_ptr<LveMetricsServer> metricsServer;
+  if (!options.metricsAddress.empty()) {
+    metricsServer = std::make_unique<LveMetricsServer>(options.metricsAddress);
+    LVE_LOG_INFO << "metrics served on " << metricsServer->getAddress();
+  }
+
+  SimpleRenderSystem simpleRenderSystem{
+      lveDevice, lveRenderer.getSwapChainRenderPass(),
+      lateLatch.getDescriptorSetLayout(), overdraw.getRenderPass()};
   LveCamera camera{};
 
   // camera.setViewDirection(glm::vec3(0.f), glm::vec3(0.5f, 0.f, 1.f));
   // 2.5f는 큐브의 중심
   camera.setViewTarget(glm::vec3(-1.f, -2.f, -2.f), glm::vec3(0.f, 0.f, 2.5f));
 
-  // 렌더링은 되지 않고 카메라 현재 상태를 저장
-  auto viewerObject = LveGameObject::createGameObject();
+  // 카메라 상태는 simulation thread가 소유, render loop는 보간된 값만 읽음
   KeyboardMovementController cameraController{};
 
+  // key event는 main thread에서 timestamp와 함께 기록
+  // frame fence를 기다리는 동안에도 event 처리
+  LveInput input{lveWindow, cameraController.bindings()};
+  lveRenderer.setWaitCallback([&] { input.pump(); });
+
+  // 입력 기록/재생 -> simulation thread가 tick마다 사용
+  std::unique_ptr<LveInputRecorder> inputRecorder;
+  std::unique_ptr<LveInputReplay> inputReplay;
+  if (!options.replayInputPath.empty()) {
+    inputReplay = std::make_unique<LveInputReplay>(options.replayInputPath,
+                                                   SIMULATION_TICK_RATE);
+    LVE_LOG_INFO << "replaying " << inputReplay->tickCount() << " ticks from "
+                 << options.replayInputPath;
+  } else if (!options.recordInputPath.empty()) {
+    inputRecorder = std::make_unique<LveInputRecorder>(SIMULATION_TICK_RATE);
+  }
+
+  LveSimulation simulation{
+      SIMULATION_TICK_RATE, LveSimulationState{},
+      [&](LveSimulationState &state, float dt) {
+        using Duration = LveSimulation::Clock::duration;
+        const auto tickStart =
+            state.time - std::chrono::duration_cast<Duration>(
+                             std::chrono::duration<float>(dt));
+        if (inputRecorder || inputReplay) {
+          // 기록/재생 중에는 tick이 끝날 때의 key 상태를 tick 전체에 적용
+          // -> key를 누른 시각과 무관하게 tick 단위로 같은 결과
+          uint32_t keyBits = 0;
+          input.integrate(tickStart, state.time,
+                          [&](uint32_t bits, float) { keyBits = bits; });
+          if (inputReplay) {
+            inputReplay->next(keyBits);
+          } else {
+            inputRecorder->record(keyBits);
+          }
+          cameraController.apply(keyBits, dt, state.viewer);
+        } else {
+          // tick 구간을 key 상태가 같은 구간으로 나눠서 적분
+          input.integrate(tickStart, state.time,
+                          [&](uint32_t keyBits, float seconds) {
+                            cameraController.apply(keyBits, seconds,
+                                                   state.viewer);
+                          });
+        }
+        state.inputTime = input.latestSampleTime();
+      }};
+  simulation.start();
+
+  // 입력 event -> submit 지연, report()에서 출력하고 다시 집계
+  uint32_t latencyFrames = 0;
+  float latencyMsSum = 0.f;
+  uint64_t frameNumber = 0;
+  // 지연을 이미 잰 마지막 입력 event 시각
+  LveInput::Clock::time_point measuredInputTime{};
+
+  // submit 직전에 가장 최근 simulation 상태로 camera 보정
+  // -> 기록 후 fence/이미지 대기 동안 지난 시간만큼 입력 지연이 줄어듦
+  // 마지막으로 그린 camera, on-demand에서 camera가 아직 움직이는지 확인
+  TransformComponent drawnViewer{};
+  lveRenderer.setBeforeSubmitCallback([&] {
+    LVE_PROFILE_SCOPE("late latch");
+    input.pump();
+    const LveSimulationState latest = simulation.sample();
+    LveCamera latchedCamera = camera;
+    latchedCamera.setViewYXZ(latest.viewer.translation, latest.viewer.rotation);
+    lateLatch.latch(lveRenderer.getFrameIndex(),
+                    latchedCamera.getProjection() * latchedCamera.getView());
+    drawnViewer = latest.viewer;
+
+    // 새 입력 event가 처음 반영된 frame만 잼 (present, capture 저장은 제외)
+    if (latest.inputTime > measuredInputTime) {
+      const float latencyMs = std::chrono::duration<float, std::milli>(
+                                  LveInput::Clock::now() - latest.inputTime)
+                                  .count();
+      measuredInputTime = latest.inputTime;
+      latencyMsSum += latencyMs;
+      latencyFrames++;
+      if (MEASURE_INPUT_LATENCY) {
+        LVE_LOG_INFO << "frame " << frameNumber << " input->submit "
+                     << latencyMs << " ms";
+      }
+    }
+  });
+
+  // IMMEDIATE/MAILBOX에서도 목표 frame time까지 쉬면서 CPU 사용을 줄임
+  // sleep 중에도 입력은 timestamp와 함께 기록
+  LveFrameLimiter frameLimiter{FRAME_RATE_LIMIT};
+  frameLimiter.waitCallback = [&] { input.pump(); };
+
   // 고성능 시간 측정
   auto currentTime = std::chrono::high_resolution_clock::now();
 
+  // simulation tick rate, render frame rate, 입력 지연을 따로 집계
+  // frame pacing mode를 바꾸면 그때까지의 값을 출력하고 다시 집계
+  auto reportTime = currentTime;
+  uint32_t reportFrames = 0;
+  size_t pacingIndex = 0;
+  bool pacingKeyDown = false;
+  bool onDemand = ON_DEMAND_REDRAW;
+  bool onDemandKeyDown = false;
+  bool traceKeyDown = false;
+  bool frameTraceKeyDown = false;
+  bool measuring = false;
+  bool measureKeyDown = false;
+  bool captureKeyDown = false;
+  uint32_t idleWaits = 0;
+  // scene graph update를 report 구간 동안 합산
+  uint32_t sceneUpdates = 0;
+  size_t sceneLocalSum = 0;
+  size_t sceneWorldSum = 0;
+  double sceneReorderMsSum = 0.0;
+  double scenePropagateMsSum = 0.0;
+  double scenePropagateMsMax = 0.0;
+
+  // key를 누른 순간에만 true
+  auto keyPressed = [&](int key, bool &down) {
+    const bool pressed =
+        glfwGetKey(lveWindow.getGLFWwindow(), key) == GLFW_PRESS;
+    const bool edge = pressed && !down;
+    down = pressed;
+    return edge;
+  };
+
+  // on-demand에서 이번 loop에 그려야 하는지
+  auto needsRedraw = [&] {
+    if (lveWindow.consumeRedrawRequest() || input.heldKeys() != 0) {
+      return true;
+    }
+    const LveSimulationState latest = simulation.sample();
+    // 쉬는 동안 짧게 누르고 뗀 key -> simulation이 반영할 때까지 계속 진행
+    if (latest.inputTime < input.latestPushTime()) {
+      return true;
+    }
+    // key를 뗀 뒤에도 마지막 tick까지 보간하는 동안은 camera가 움직임
+    return !sameViewer(latest.viewer, drawnViewer);
+  };
+
+  auto report = [&](std::chrono::high_resolution_clock::time_point now) {
+    const float reportSeconds =
+        std::chrono::duration<float>(now - reportTime).count();
+    const auto &pacing = lveRenderer.getFramePacing();
+    const auto &simulationStats = simulation.getStats();
+    const auto &latchStats = lateLatch.getStats();
+    const float fps = reportSeconds > 0.f ? reportFrames / reportSeconds : 0.f;
+    {
+      LveLogLine line{LveLog::Level::INFO};
+      line << "[" << pacing.name << ", " << pacing.framesInFlight
+           << " in flight, "
+           << LveSwapChain::presentModeName(lveRenderer.getPresentMode())
+           << "] simulation " << simulationStats.tickRate << " Hz (step "
+           << simulationStats.averageStepMs << " ms, skipped "
+           << simulationStats.skippedTicks << "), render " << fps << " fps ("
+           << (fps > 0.f ? 1000.f / fps : 0.f) << " ms), input->submit "
+           << (latencyFrames > 0 ? latencyMsSum / latencyFrames : 0.f)
+           << " ms, late latch +" << latchStats.averageDelayMs << " ms (max "
+           << latchStats.maxDelayMs << ", dropped " << input.droppedSamples()
+           << ")";
+      if (onDemand) {
+        line << ", on-demand (idle waits " << idleWaits << ")";
+      }
+    }
+
+    // 창 크기 변경 비용 (device를 기다리지 않고 다시 만든 시간)
+    const auto &resizeStats = lveRenderer.getResizeStats();
+    if (resizeStats.count > 0) {
+      LVE_LOG_INFO << "swap chain resized " << resizeStats.count
+                   << " times (last " << resizeStats.lastMs << " ms, max "
+                   << resizeStats.maxMs << " ms, avg "
+                   << resizeStats.totalMs / resizeStats.count << " ms)";
+    }
+    if (lveDevice.deferredCount() > 0) {
+      LVE_LOG_INFO << "deferred destruction pending "
+                   << lveDevice.deferredCount() << " objects ("
+                   << lveDevice.deferredBytes() / 1024 << " KiB)";
+    }
+    // heap별 사용량 / 예산, 용도별 사용량
+    lveDevice.logMemoryReport();
+    for (auto path : {LveDevice::UploadPath::DIRECT,
+                      LveDevice::UploadPath::STAGING}) {
+      const auto uploads = lveDevice.getUploadStats(path);
+      if (uploads.count > 0) {
+        LVE_LOG_INFO << (path == LveDevice::UploadPath::DIRECT ? "direct"
+                                                               : "staging")
+                     << " uploads " << uploads.count << " ("
+                     << uploads.bytes / 1024 << " KiB, "
+                     << uploads.mibPerSecond() << " MiB/s)";
+      }
+    }
+
+    if (sceneUpdates > 0) {
+      const auto &sceneStats = sceneGraph.getStats();
+      LVE_LOG_INFO << "scene graph " << sceneStats.nodeCount << " nodes, "
+                   << sceneStats.levelCount << " levels, per update local "
+                   << sceneLocalSum / sceneUpdates << " / world "
+                   << sceneWorldSum / sceneUpdates << " recomputed, reorder "
+                   << sceneReorderMsSum / sceneUpdates << " ms, propagate "
+                   << scenePropagateMsSum / sceneUpdates << " ms (max "
+                   << scenePropagateMsMax << ")";
+    }
+
+    const auto pacingStats = frameLimiter.getStats();
+    LVE_LOG_INFO << "frame time p50 " << pacingStats.frameP50Ms << " / p95 "
+                 << pacingStats.frameP95Ms << " / p99 "
+                 << pacingStats.frameP99Ms << " ms, error p50 "
+                 << pacingStats.errorP50Ms << " / p95 "
+                 << pacingStats.errorP95Ms << " / p99 "
+                 << pacingStats.errorP99Ms << " ms, sleep "
+                 << pacingStats.sleepMs << " ms, spin " << pacingStats.spinMs
+                 << " ms";
+    {
+      // histogram 한 줄이 record 하나
+      LveLogLine histogram{LveLog::Level::INFO};
+      LveFrameLimiter::printHistogram(pacingStats, histogram.getStream());
+    }
+    frameLimiter.resetStats();
+
+    // 마지막 frame 하나의 API 호출 수
+    const auto &vulkanStats = lveRenderer.getFrameStats();
+    {
+      LveLogLine line{LveLog::Level::INFO};
+      line << "vulkan calls " << vulkanStats.commandCount() << " vkCmd* (draws "
+           << vulkanStats.drawCount() << ", binds "
+           << vulkanStats[LveVulkanStats::BIND_PIPELINE].count +
+                  vulkanStats[LveVulkanStats::BIND_DESCRIPTOR_SETS].count +
+                  vulkanStats[LveVulkanStats::BIND_VERTEX_BUFFERS].count +
+                  vulkanStats[LveVulkanStats::BIND_INDEX_BUFFER].count
+           << ", push constants "
+           << vulkanStats[LveVulkanStats::PUSH_CONSTANTS].count << "), submits "
+           << vulkanStats[LveVulkanStats::QUEUE_SUBMIT].count
+           << ", fence waits "
+           << vulkanStats[LveVulkanStats::WAIT_FOR_FENCES].count;
+      if (LveVulkanStats::timingEnabled) {
+        line << ", " << vulkanStats.cpuMs() << " ms";
+      }
+    }
+    if (LveVulkanStats::timingEnabled) {
+      for (uint32_t i = 0; i < LveVulkanStats::CALL_COUNT; i++) {
+        const auto call = static_cast<LveVulkanStats::Call>(i);
+        if (vulkanStats[call].count > 0) {
+          LVE_LOG_INFO << "  " << LveVulkanStats::callName(call) << " x"
+                       << vulkanStats[call].count << " "
+                       << vulkanStats[call].cpuMs << " ms";
+        }
+      }
+    }
+
+    if (measuring) {
+      // 결과는 frame in flight 수만큼 늦게 읽은 마지막 frame
+      const VkExtent2D extent = lveRenderer.getSwapChainExtent();
+      const double pixels =
+          static_cast<double>(extent.width) * extent.height;
+      using Counters = LvePipelineStatistics::Counters;
+      auto printCounters = [&](const char *name, const Counters &counters) {
+        LVE_LOG_INFO << "pass " << name << ": vertices "
+                     << counters.inputVertices << " (vs "
+                     << counters.vertexInvocations << "), primitives "
+                     << counters.inputPrimitives << " -> clipping "
+                     << counters.clippingInvocations << " -> "
+                     << counters.clippingPrimitives << ", fragments "
+                     << counters.fragmentInvocations << " ("
+                     << counters.fragmentInvocations / pixels << " per pixel)";
+      };
+      const auto &statistics =
+          lveRenderer.getPipelineStatistics().getLastFrame();
+      for (const auto &pass : statistics.passes) {
+        printCounters(pass.name, pass.counters);
+      }
+      if (!statistics.passes.empty()) {
+        printCounters("frame total", statistics.total);
+      }
+
+      const auto &overdrawStats = overdraw.getStats();
+      LVE_LOG_INFO << "overdraw avg " << overdrawStats.averageOverdraw
+                   << " (covered pixels "
+                   << overdrawStats.coveredAverageOverdraw << "), max "
+                   << overdrawStats.maxOverdraw << ", coverage "
+                   << overdrawStats.coverage * 100.0 << "%";
+    }
+
+    // 이동 평균이므로 reset하지 않음
+    for (const auto &scope : lveRenderer.getGpuProfiler().getScopeStats()) {
+      LVE_LOG_INFO << std::string(scope.depth * 2, ' ') << "gpu " << scope.name
+                   << " " << scope.averageMs << " ms (last " << scope.lastMs
+                   << ", max " << scope.maxMs << ")";
+    }
+
+    reportTime = now;
+    reportFrames = 0;
+    latencyFrames = 0;
+    latencyMsSum = 0.f;
+    idleWaits = 0;
+    sceneUpdates = 0;
+    sceneLocalSum = 0;
+    sceneWorldSum = 0;
+    sceneReorderMsSum = 0.0;
+    scenePropagateMsSum = 0.0;
+    scenePropagateMsMax = 0.0;
+    lateLatch.resetStats();
+  };
+
+  // [fromTicks, toTicks)와 겹치는 CPU 구간과 GPU 구간을 같은 시간축으로 저장
+  auto writeTrace = [&](const char *path, uint64_t fromTicks,
+                        uint64_t toTicks) {
+    std::vector<LveTraceEvent> events;
+    LveProfiler::collectTraceEvents(events, fromTicks, toTicks);
+
+    std::vector<LveTraceEvent> gpuEvents;
+    lveRenderer.getGpuProfiler().collectTraceEvents(gpuEvents);
+    const bool all = fromTicks == LveProfiler::FIRST_TICK &&
+                     toTicks == LveProfiler::LAST_TICK;
+    const double fromUs = LveProfiler::ticksToNanoseconds(fromTicks) / 1000.0;
+    const double toUs = LveProfiler::ticksToNanoseconds(toTicks) / 1000.0;
+    for (const auto &event : gpuEvents) {
+      if (all ||
+          (event.beginUs + event.durationUs > fromUs && event.beginUs < toUs)) {
+        events.push_back(event);
+      }
+    }
+
+    auto threads = LveProfiler::threads();
+    threads.push_back({LveTrace::GPU_THREAD_ID, "GPU graphics queue"});
+    const bool written = LveTrace::writeFile(path, events, threads);
+    LveLogLine{written ? LveLog::Level::INFO : LveLog::Level::ERROR}
+        << (written ? "trace written to " : "failed to write trace ") << path
+        << " (" << events.size() << " events)";
+  };
+
   while (!lveWindow.shouldClose()) {
-    glfwPollEvents();
+    if (inputReplay && inputReplay->finished()) {
+      report(std::chrono::high_resolution_clock::now());
+      LVE_LOG_INFO << "input replay finished";
+      break;
+    }
+
+    // 바뀐 것이 없으면 event가 올 때까지 block -> CPU, GPU 모두 쉼
+    if (onDemand && !needsRedraw()) {
+      // 기록/재생은 tick 단위로 이어져야 하므로 simulation을 멈추지 않음
+      if (!inputRecorder && !inputReplay) {
+        simulation.pause();
+      }
+      input.wait(ON_DEMAND_WAIT_TIMEOUT);
+      idleWaits++;
+      frameLimiter.restart();
+      continue;
+    }
+    simulation.resume();
+
+    LVE_PROFILE_FRAME();
+    {
+      // 쉬고 난 뒤에 입력을 읽어야 frame에 최신 입력이 반영됨
+      LVE_PROFILE_SCOPE("frame limiter");
+      frameLimiter.wait();
+    }
+    input.pump();
 
     //  각 루프마다 시간 측정
     auto newTime = std::chrono::high_resolution_clock::now();
@@ -48,39 +439,188 @@ void FirstApp::run() {
             .count();
     currentTime = newTime;
 
-    // 카메라 이동
-    cameraController.moveInPlaneXZ(lveWindow.getGLFWwindow(), frameTime,
-                                   viewerObject);
-    camera.setViewYXZ(viewerObject.transform.translation,
-                      viewerObject.transform.rotation);
+    if (keyPressed(FRAME_PACING_KEY, pacingKeyDown)) {
+      report(newTime);
+      const auto &presets = LveFramePacing::presets();
+      pacingIndex = (pacingIndex + 1) % presets.size();
+      lveRenderer.setFramePacing(presets[pacingIndex]);
+    }
+    if (keyPressed(ON_DEMAND_KEY, onDemandKeyDown)) {
+      report(newTime);
+      onDemand = !onDemand;
+      LVE_LOG_INFO << "on-demand redraw " << (onDemand ? "on" : "off");
+    }
+    if (keyPressed(TRACE_KEY, traceKeyDown)) {
+      writeTrace(TRACE_FILE, LveProfiler::FIRST_TICK, LveProfiler::LAST_TICK);
+    }
+    // overdraw pipeline은 처음 측정을 켤 때 생성
+    if (keyPressed(MEASURE_KEY, measureKeyDown) &&
+        (measuring || simpleRenderSystem.prepareOverdraw())) {
+      measuring = !measuring;
+      auto &statistics = lveRenderer.getPipelineStatistics();
+      statistics.enabled = measuring;
+      LveLogLine line{LveLog::Level::INFO};
+      line << "render measurement " << (measuring ? "on" : "off");
+      if (measuring && !statistics.isSupported()) {
+        line << " (pipeline statistics not supported, overdraw only)";
+      }
+    }
+    // 이번 frame만 기록, submit한 뒤 저장
+    std::unique_ptr<LveFrameCapture> capture;
+    if (keyPressed(CAPTURE_KEY, captureKeyDown)) {
+      capture = std::make_unique<LveFrameCapture>();
+    }
+    uint64_t frameBegin, frameEnd;
+    if (keyPressed(FRAME_TRACE_KEY, frameTraceKeyDown) &&
+        LveProfiler::frameRange(0, frameBegin, frameEnd)) {
+      writeTrace(FRAME_TRACE_FILE, frameBegin, frameEnd);
+    }
+
+    reportFrames++;
+    if (std::chrono::duration<float>(newTime - reportTime).count() >=
+        REPORT_INTERVAL) {
+      report(newTime);
+    }
+
+    {
+      // hierarchy world matrix 전파 -> 변경된 subtree만 계산
+      LVE_PROFILE_SCOPE("scene update");
+      sceneGraph.update();
+      updateBvh();
+    }
+    {
+      const auto &sceneStats = sceneGraph.getStats();
+      sceneUpdates++;
+      sceneLocalSum += sceneStats.localRecomputed;
+      sceneWorldSum += sceneStats.worldRecomputed;
+      sceneReorderMsSum += sceneStats.reorderMs;
+      scenePropagateMsSum += sceneStats.propagateMs;
+      scenePropagateMsMax =
+          std::max(scenePropagateMsMax, sceneStats.propagateMs);
+    }
 
     float aspect = lveRenderer.getAspectRatio();
     // camera.setOrthographicProjection(-aspect, aspect, -1, 1, -1, 1);
     camera.setPerspectiveProjection(glm::radians(50.f), aspect, 0.1f, 10.f);
 
     if (auto commandBuffer = lveRenderer.beginFrame()) {
+      // 카메라 이동 -> fence 대기가 끝난 뒤에 가장 최근 tick 사이를 보간
+      const LveSimulationState view = simulation.sample();
+      camera.setViewYXZ(view.viewer.translation, view.viewer.rotation);
+
+      const int frameIndex = lveRenderer.getFrameIndex();
+      lateLatch.record(frameIndex, camera.getProjection() * camera.getView());
+      drawnViewer = view.viewer;
+
+      FrameInfo frameInfo{frameIndex,
+                          frameTime,
+                          commandBuffer,
+                          camera,
+                          lateLatch.getDescriptorSet(frameIndex),
+                          registry,
+                          sceneGraph,
+                          &bvh,
+                          &lveRenderer.getGpuProfiler(),
+                          capture.get()};
+
+      if (measuring) {
+        // swap chain pass와 같은 object를 depth test 없이 그려서 fragment 수를 셈
+        auto &statistics = lveRenderer.getPipelineStatistics();
+        statistics.beginPass(commandBuffer, "overdraw pass");
+        overdraw.beginPass(commandBuffer, frameIndex,
+                           lveRenderer.getSwapChainExtent());
+        simpleRenderSystem.renderOverdraw(frameInfo);
+        overdraw.endPass(commandBuffer);
+        statistics.endPass(commandBuffer);
+      }
+
+      lveRenderer.setFrameCapture(capture.get());
       lveRenderer.beginSwapChainRenderPass(commandBuffer);
-      simpleRenderSystem.renderGameObjects(commandBuffer, gameObjects, camera);
+      simpleRenderSystem.renderGameObjects(frameInfo);
       lveRenderer.endSwapChainRenderPass(commandBuffer);
+      lveRenderer.setFrameCapture(nullptr);
       lveRenderer.endFrame();
+
+      if (capture) {
+        const bool saved = capture->save(CAPTURE_FILE);
+        LveLogLine{saved ? LveLog::Level::INFO : LveLog::Level::ERROR}
+            << (saved ? "frame captured to " : "failed to capture frame ")
+            << CAPTURE_FILE << " (" << capture->getCommands().size()
+            << " commands, " << capture->getBuffers().size() << " buffers)";
+      }
+
+      frameNumber++;
+    } else {
+      // swap chain을 다시 만드느라 그리지 못함 -> on-demand에서도 다음 loop에 그림
+      lveWindow.requestRedraw();
     }
   }
 
+  simulation.stop();
+  if (inputRecorder) {
+    const bool saved = inputRecorder->save(options.recordInputPath);
+    LveLogLine{saved ? LveLog::Level::INFO : LveLog::Level::ERROR}
+        << (saved ? "input recorded to " : "failed to record input ")
+        << options.recordInputPath << " (" << inputRecorder->tickCount()
+        << " ticks)";
+  }
+  lveRenderer.setWaitCallback(nullptr);
+  lveRenderer.setBeforeSubmitCallback(nullptr);
   vkDeviceWaitIdle(lveDevice.device());
 }
 
 void FirstApp::loadGameObjects() {
-  std::shared_ptr<LveModel> lveModel =
-      LveModel::createModelFromFile(lveDevice, "models/42/teapot.obj");
+  models.push_back(
+      LveModel::createModelFromFile(lveDevice, "models/42/teapot.obj"));
 
-  auto gameObj = LveGameObject::createGameObject();
+  auto entity = registry.create();
 
-  gameObj.model = lveModel;
-  gameObj.transform.translation = {.0f, .0f, 2.5f};
-  gameObj.transform.scale = {.5f, .5f, .5f};
-  //   gameObj.transform.scale = glm::vec3(3.f);
+  TransformComponent transform{};
+  transform.translation = {.0f, .0f, 2.5f};
+  transform.scale = {.5f, .5f, .5f};
+  //   transform.scale = glm::vec3(3.f);
 
-  gameObjects.push_back(std::move(gameObj));
+  registry.add<ModelComponent>(entity, {models.back().get()});
+  registry.add<TransformComponent>(entity, transform);
+  registry.add<ColorComponent>(entity);
+
+  const LveAabb bounds =
+      models.back()->getBoundingBox().transformed(transform.mat4());
+  registry.add<BvhProxyComponent>(entity, {bvh.insert(bounds, entity.index)});
+}
+
+void FirstApp::updateBvh() {
+  // registry 순회는 main thread에서, matrix와 AABB 계산은 job system으로 나눔
+  bvhRefits.clear();
+  registry.each<BvhProxyComponent, ModelComponent, TransformComponent>(
+      [&](LveEntity, BvhProxyComponent &proxy, ModelComponent &model,
+          TransformComponent &transform) {
+        bvhRefits.push_back(
+            {proxy.proxy, model.model, &transform, nullptr, LveAabb{}});
+      });
+  registry.each<BvhProxyComponent, ModelComponent, SceneNodeComponent>(
+      [&](LveEntity, BvhProxyComponent &proxy, ModelComponent &model,
+          SceneNodeComponent &sceneNode) {
+        bvhRefits.push_back({proxy.proxy, model.model, nullptr,
+                             &sceneGraph.worldMatrix(sceneNode.node),
+                             LveAabb{}});
+      });
+
+  jobSystem.parallelFor(
+      bvhRefits.size(), BVH_REFIT_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+          BvhRefit &refit = bvhRefits[i];
+          const glm::mat4 matrix = refit.transform != nullptr
+                                       ? refit.transform->mat4()
+                                       : *refit.world;
+          refit.bounds = refit.model->getBoundingBox().transformed(matrix);
+        }
+      });
+
+  // fat AABB 안에서 움직이면 move()는 tree를 건드리지 않음
+  for (const BvhRefit &refit : bvhRefits) {
+    bvh.move(refit.proxy, refit.bounds);
+  }
 }
 
 } // namespace lve
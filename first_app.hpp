@@ -1,12 +1,19 @@
 #pragma once
 
+#include "lve_bvh.hpp"
 #include "lve_device.hpp"
+#include "lve_ecs.hpp"
 #include "lve_game_object.hpp"
+#include "lve_job_system.hpp"
+#include "lve_late_latch.hpp"
+#include "lve_overdraw.hpp"
 #include "lve_renderer.hpp"
+#include "lve_scene_graph.hpp"
 #include "lve_window.hpp"
 
 // std
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace lve {
@@ -17,7 +24,55 @@ public:
   static constexpr int WIDTH = 800;
   static constexpr int HEIGHT = 600;
 
-  FirstApp();
+  // 고정 simulation 간격 (render frame rate와 무관)
+  static constexpr double SIMULATION_TICK_RATE = 120.0;
+  // render loop 최대 frame rate, 0이면 제한 없음 (present mode에만 의존)
+  static constexpr double FRAME_RATE_LIMIT = 144.0;
+  // tick rate, frame rate 출력 간격 (초)
+  static constexpr float REPORT_INTERVAL = 5.f;
+  // true면 새 입력 event를 반영한 frame마다 event -> submit 지연 출력
+  static constexpr bool MEASURE_INPUT_LATENCY = false;
+  // LveFramePacing::presets()를 순서대로 전환하는 key
+  static constexpr int FRAME_PACING_KEY = GLFW_KEY_P;
+  // true면 입력, 크기 변경, redraw 요청이 있을 때만 그림 (on-demand redraw)
+  // 그릴 것이 없는 동안은 simulation thread도 멈춤
+  static constexpr bool ON_DEMAND_REDRAW = false;
+  // on-demand redraw 전환 key
+  static constexpr int ON_DEMAND_KEY = GLFW_KEY_O;
+  // on-demand에서 event를 기다리는 최대 시간 (초)
+  static constexpr double ON_DEMAND_WAIT_TIMEOUT = 0.5;
+  // buffer에 남은 CPU/GPU 구간 전체를 TRACE_FILE로 저장하는 key
+  static constexpr int TRACE_KEY = GLFW_KEY_F9;
+  static constexpr const char *TRACE_FILE = "lve_trace.json";
+  // 마지막으로 끝난 frame 하나를 FRAME_TRACE_FILE로 저장하는 key
+  static constexpr int FRAME_TRACE_KEY = GLFW_KEY_F10;
+  static constexpr const char *FRAME_TRACE_FILE = "lve_frame_trace.json";
+  // 최근 frame 기록 ring (mmap), 치명적인 signal이나 device lost일 때 dump
+  static constexpr const char *FLIGHT_RECORDER_FILE = "lve_flight_recorder.bin";
+  static constexpr const char *FLIGHT_DUMP_FILE = "lve_flight_recorder.txt";
+  // pass별 pipeline statistics와 overdraw 측정 전환 key
+  // 측정 중에는 overdraw pass를 한 번 더 그리므로 frame time이 늘어남
+  static constexpr int MEASURE_KEY = GLFW_KEY_F8;
+  // true면 Vulkan 호출마다 CPU 시간 측정 (호출 수는 항상 집계)
+  static constexpr bool VULKAN_CALL_TIMING = false;
+  // 다음 frame의 swap chain pass command를 CAPTURE_FILE로 저장하는 key
+  // benchmarks/frame_replay로 scene 없이 다시 그려서 GPU/driver 비용만 측정
+  static constexpr int CAPTURE_KEY = GLFW_KEY_F7;
+  static constexpr const char *CAPTURE_FILE = "lve_frame.capture";
+  // BVH leaf AABB를 job system으로 나눠 계산할 때 job 하나의 entity 수
+  static constexpr size_t BVH_REFIT_GRAIN = 256;
+
+  // 실행 옵션 (main의 command line 인자)
+  struct Options {
+    // 비어 있지 않으면 simulation tick마다의 입력을 이 파일로 기록
+    std::string recordInputPath;
+    // 비어 있지 않으면 live 입력 대신 이 기록을 재생하고, 끝나면 종료
+    std::string replayInputPath;
+    // 비어 있지 않으면 이 address에서 metrics를 Prometheus text format으로 제공
+    std::string metricsAddress;
+  };
+
+  explicit FirstApp(Options options = {});
   ~FirstApp();
 
   FirstApp(const FirstApp &) = delete;
@@ -34,12 +89,48 @@ private:
    */
   void loadGameObjects();
 
+  /**
+   * @brief 현재 world matrix로 BVH leaf 갱신
+   * AABB 계산은 job system으로 나누고 tree 갱신만 main thread에서 수행
+   */
+  void updateBvh();
+
+  Options options;
+
   LveWindow lveWindow{WIDTH, HEIGHT, "Hello Vulkan!"};
 
   LveDevice lveDevice{lveWindow};
 
   LveRenderer lveRenderer{lveWindow, lveDevice};
 
-  std::vector<LveGameObject> gameObjects;
+  // submit 직전에 camera를 갱신하는 uniform buffer
+  LveLateLatch lateLatch{lveDevice};
+
+  // MEASURE_KEY로 켜는 fragment 수 측정 pass
+  LveOverdraw overdraw{lveDevice, LveSwapChain::MAX_FRAMES_IN_FLIGHT};
+
+  // model은 여기서 소유하고 entity는 ModelComponent로 참조
+  std::vector<std::unique_ptr<LveModel>> models;
+
+  LveRegistry registry;
+
+  // 모든 subsystem이 같이 사용하는 scheduler, main thread도 참여
+  LveJobSystem jobSystem{};
+
+  // parent/child 관계가 있는 entity의 world matrix
+  LveSceneGraph sceneGraph{&jobSystem};
+
+  // frustum culling, picking 등 공간 query용
+  LveBvh bvh;
+
+  // updateBvh()에서 entity마다 새 AABB를 계산할 입력과 결과
+  struct BvhRefit {
+    LveBvh::proxy_t proxy;
+    const LveModel *model;
+    TransformComponent *transform; // nullptr이면 world 사용
+    const glm::mat4 *world;
+    LveAabb bounds;
+  };
+  std::vector<BvhRefit> bvhRefits;
 };
 } // namespace lve
\ No newline at end of file
@@ -4,50 +4,73 @@
 #include <limits>
 
 namespace lve {
-void KeyboardMovementController::moveInPlaneXZ(GLFWwindow *window, float dt,
-                                               LveGameObject &gameObject) {
+std::vector<std::pair<int, uint32_t>>
+KeyboardMovementController::bindings() const {
+  return {
+      {keys.moveLeft, MOVE_LEFT},         {keys.moveRight, MOVE_RIGHT},
+      {keys.moveForward, MOVE_FORWARD},   {keys.moveBackward, MOVE_BACKWARD},
+      {keys.moveUp, MOVE_UP},             {keys.moveDown, MOVE_DOWN},
+      {keys.lookLeft, LOOK_LEFT},         {keys.lookRight, LOOK_RIGHT},
+      {keys.lookUp, LOOK_UP},             {keys.lookDown, LOOK_DOWN},
+  };
+}
+
+uint32_t KeyboardMovementController::sampleKeys(GLFWwindow *window) const {
+  uint32_t keyBits = 0;
+  for (const auto &[key, bit] : bindings()) {
+    if (glfwGetKey(window, key) == GLFW_PRESS) {
+      keyBits |= bit;
+    }
+  }
+  return keyBits;
+}
+
+void KeyboardMovementController::apply(uint32_t keyBits, float dt,
+                                       TransformComponent &transform) const {
   glm::vec3 rotate{0};
 
-  if (glfwGetKey(window, keys.lookRight) == GLFW_PRESS)
+  if (keyBits & LOOK_RIGHT)
     rotate.y += 1.f;
-  if (glfwGetKey(window, keys.lookLeft) == GLFW_PRESS)
+  if (keyBits & LOOK_LEFT)
     rotate.y -= 1.f;
-  if (glfwGetKey(window, keys.lookUp) == GLFW_PRESS)
+  if (keyBits & LOOK_UP)
     rotate.x += 1.f;
-  if (glfwGetKey(window, keys.lookDown) == GLFW_PRESS)
+  if (keyBits & LOOK_DOWN)
     rotate.x -= 1.f;
   if (glm::dot(rotate, rotate) > std::numeric_limits<float>::epsilon()) {
-    gameObject.transform.rotation += lookSpeed * dt * glm::normalize(rotate);
+    transform.rotation += lookSpeed * dt * glm::normalize(rotate);
   }
 
   // limit pitch values between about +/- 85ish degrees
-  gameObject.transform.rotation.x =
-      glm::clamp(gameObject.transform.rotation.x, -1.5f, 1.5f);
-  gameObject.transform.rotation.y =
-      glm::mod(gameObject.transform.rotation.y, glm::two_pi<float>());
+  transform.rotation.x = glm::clamp(transform.rotation.x, -1.5f, 1.5f);
+  transform.rotation.y = glm::mod(transform.rotation.y, glm::two_pi<float>());
 
   // X,Z 평면에서 이동
-  float yaw = gameObject.transform.rotation.y;
+  float yaw = transform.rotation.y;
   const glm::vec3 forwardDir{sin(yaw), 0.f, cos(yaw)};
   const glm::vec3 rightDir{forwardDir.z, 0.f, -forwardDir.x};
   const glm::vec3 upDir{0.f, -1.f, 0.f};
 
   glm::vec3 moveDir{0.f};
-  if (glfwGetKey(window, keys.moveForward) == GLFW_PRESS)
+  if (keyBits & MOVE_FORWARD)
     moveDir += forwardDir;
-  if (glfwGetKey(window, keys.moveBackward) == GLFW_PRESS)
+  if (keyBits & MOVE_BACKWARD)
     moveDir -= forwardDir;
-  if (glfwGetKey(window, keys.moveRight) == GLFW_PRESS)
+  if (keyBits & MOVE_RIGHT)
     moveDir += rightDir;
-  if (glfwGetKey(window, keys.moveLeft) == GLFW_PRESS)
+  if (keyBits & MOVE_LEFT)
     moveDir -= rightDir;
-  if (glfwGetKey(window, keys.moveUp) == GLFW_PRESS)
+  if (keyBits & MOVE_UP)
     moveDir += upDir;
-  if (glfwGetKey(window, keys.moveDown) == GLFW_PRESS)
+  if (keyBits & MOVE_DOWN)
     moveDir -= upDir;
   if (glm::dot(moveDir, moveDir) > std::numeric_limits<float>::epsilon()) {
-    gameObject.transform.translation +=
-        moveSpeed * dt * glm::normalize(moveDir);
+    transform.translation += moveSpeed * dt * glm::normalize(moveDir);
   }
 }
-} // namespace lve
\ No newline at end of file
+
+void KeyboardMovementController::moveInPlaneXZ(GLFWwindow *window, float dt,
+                                               LveGameObject &gameObject) {
+  apply(sampleKeys(window), dt, gameObject.transform);
+}
+} // namespace lve
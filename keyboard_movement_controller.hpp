@@ -3,6 +3,11 @@
 #include "lve_game_object.hpp"
 #include "lve_window.hpp"
 
+// std
+#include <cstdint>
+#include <utility>
+#include <vector>
+
 namespace lve {
 
 class KeyboardMovementController {
@@ -20,6 +25,34 @@ public:
     int lookDown = GLFW_KEY_DOWN;
   };
 
+  // sampleKeys()가 반환하는 bit, 눌린 key마다 1
+  enum KeyBit : uint32_t {
+    MOVE_LEFT = 1u << 0,
+    MOVE_RIGHT = 1u << 1,
+    MOVE_FORWARD = 1u << 2,
+    MOVE_BACKWARD = 1u << 3,
+    MOVE_UP = 1u << 4,
+    MOVE_DOWN = 1u << 5,
+    LOOK_LEFT = 1u << 6,
+    LOOK_RIGHT = 1u << 7,
+    LOOK_UP = 1u << 8,
+    LOOK_DOWN = 1u << 9,
+  };
+
+  // (glfw key, KeyBit) 목록 -> 입력 thread에서 key event를 bit로 변환할 때 사용
+  std::vector<std::pair<int, uint32_t>> bindings() const;
+
+  /**
+   * @brief 현재 key 상태를 bit mask로 읽음 (glfw 규칙상 main thread에서만 호출)
+   */
+  uint32_t sampleKeys(GLFWwindow *window) const;
+
+  /**
+   * @brief key bit mask로 transform을 dt만큼 이동
+   * window에 접근하지 않으므로 simulation thread에서 호출 가능
+   */
+  void apply(uint32_t keyBits, float dt, TransformComponent &transform) const;
+
   /**
    * @brief 게임 오브젝트를 XZ 평면상에서 이동시킵니다.
    *
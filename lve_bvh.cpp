@@ -0,0 +1,303 @@
+#include "lve_bvh.hpp"
+
+// std
+#include <algorithm>
+#include <cassert>
+
+namespace lve {
+
+LveAabb LveAabb::transformed(const glm::mat4 &matrix) const {
+  const glm::vec3 center = (min + max) * 0.5f;
+  const glm::vec3 extent = (max - min) * 0.5f;
+
+  glm::vec3 newCenter{matrix[3][0], matrix[3][1], matrix[3][2]};
+  glm::vec3 newExtent{0.f};
+  for (int column = 0; column < 3; column++) {
+    for (int row = 0; row < 3; row++) {
+      newCenter[row] += matrix[column][row] * center[column];
+      newExtent[row] += glm::abs(matrix[column][row]) * extent[column];
+    }
+  }
+  return {newCenter - newExtent, newCenter + newExtent};
+}
+
+LveFrustum LveFrustum::fromMatrix(const glm::mat4 &m) {
+  // glm은 column-major -> row i = (m[0][i], m[1][i], m[2][i], m[3][i])
+  auto row = [&](int i) { return glm::vec4{m[0][i], m[1][i], m[2][i], m[3][i]}; };
+  const glm::vec4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+
+  LveFrustum frustum{};
+  frustum.planes[0] = r3 + r0; // left
+  frustum.planes[1] = r3 - r0; // right
+  frustum.planes[2] = r3 + r1; // top (vulkan은 y가 아래 방향)
+  frustum.planes[3] = r3 - r1; // bottom
+  frustum.planes[4] = r2;      // near (depth 0..1)
+  frustum.planes[5] = r3 - r2; // far
+
+  for (auto &plane : frustum.planes) {
+    const float length = glm::length(glm::vec3{plane.x, plane.y, plane.z});
+    plane = plane * (1.f / length);
+  }
+  return frustum;
+}
+
+LveFrustum::Result LveFrustum::test(const LveAabb &aabb) const {
+  Result result = Result::INSIDE;
+  for (const auto &plane : planes) {
+    // 평면 법선 방향으로 가장 먼 점(p)과 가장 가까운 점(n)
+    const glm::vec3 p{plane.x >= 0.f ? aabb.max.x : aabb.min.x,
+                      plane.y >= 0.f ? aabb.max.y : aabb.min.y,
+                      plane.z >= 0.f ? aabb.max.z : aabb.min.z};
+    const glm::vec3 n{plane.x >= 0.f ? aabb.min.x : aabb.max.x,
+                      plane.y >= 0.f ? aabb.min.y : aabb.max.y,
+                      plane.z >= 0.f ? aabb.min.z : aabb.max.z};
+    const glm::vec3 normal{plane.x, plane.y, plane.z};
+
+    if (glm::dot(normal, p) + plane.w < 0.f) {
+      return Result::OUTSIDE;
+    }
+    if (glm::dot(normal, n) + plane.w < 0.f) {
+      result = Result::INTERSECT;
+    }
+  }
+  return result;
+}
+
+LveBvh::proxy_t LveBvh::allocateNode() {
+  if (freeList == NULL_NODE) {
+    nodes.emplace_back();
+    return static_cast<proxy_t>(nodes.size() - 1);
+  }
+  proxy_t node = freeList;
+  freeList = nodes[node].parent;
+  nodes[node] = Node{};
+  return node;
+}
+
+void LveBvh::freeNode(proxy_t node) {
+  nodes[node].parent = freeList;
+  nodes[node].height = -1;
+  freeList = node;
+}
+
+LveAabb LveBvh::fatten(const LveAabb &aabb) const {
+  const glm::vec3 margin{fatMargin};
+  return {aabb.min - margin, aabb.max + margin};
+}
+
+LveBvh::proxy_t LveBvh::insert(const LveAabb &aabb, uint32_t userData) {
+  proxy_t proxy = allocateNode();
+  nodes[proxy].aabb = fatten(aabb);
+  nodes[proxy].userData = userData;
+  nodes[proxy].height = 0;
+  insertLeaf(proxy);
+  leafCount++;
+  return proxy;
+}
+
+void LveBvh::remove(proxy_t proxy) {
+  assert(proxy >= 0 && proxy < static_cast<proxy_t>(nodes.size()) &&
+         nodes[proxy].isLeaf() && "Invalid BVH proxy");
+  removeLeaf(proxy);
+  freeNode(proxy);
+  leafCount--;
+}
+
+bool LveBvh::move(proxy_t proxy, const LveAabb &aabb) {
+  assert(nodes[proxy].isLeaf() && "Invalid BVH proxy");
+  if (nodes[proxy].aabb.contains(aabb)) {
+    return false;
+  }
+  removeLeaf(proxy);
+  nodes[proxy].aabb = fatten(aabb);
+  insertLeaf(proxy);
+  return true;
+}
+
+void LveBvh::setBounds(proxy_t proxy, const LveAabb &aabb) {
+  assert(nodes[proxy].isLeaf() && "Invalid BVH proxy");
+  if (!nodes[proxy].aabb.contains(aabb)) {
+    nodes[proxy].aabb = fatten(aabb);
+  }
+}
+
+void LveBvh::refit() {
+  if (root == NULL_NODE) {
+    return;
+  }
+  // 후위 순회 -> child가 먼저 갱신된 후 parent 계산
+  std::vector<std::pair<proxy_t, bool>> work{{root, false}};
+  while (!work.empty()) {
+    auto [node, childrenDone] = work.back();
+    work.pop_back();
+    Node &n = nodes[node];
+    if (n.isLeaf()) {
+      continue;
+    }
+    if (!childrenDone) {
+      work.push_back({node, true});
+      work.push_back({n.child1, false});
+      work.push_back({n.child2, false});
+    } else {
+      n.aabb = LveAabb::merge(nodes[n.child1].aabb, nodes[n.child2].aabb);
+    }
+  }
+}
+
+void LveBvh::insertLeaf(proxy_t leaf) {
+  if (root == NULL_NODE) {
+    root = leaf;
+    nodes[root].parent = NULL_NODE;
+    return;
+  }
+
+  // 표면적 증가량이 가장 작은 형제 node 찾기
+  const LveAabb leafAabb = nodes[leaf].aabb;
+  proxy_t index = root;
+  while (!nodes[index].isLeaf()) {
+    const Node &node = nodes[index];
+    const float area = node.aabb.surfaceArea();
+    const float combinedArea = LveAabb::merge(node.aabb, leafAabb).surfaceArea();
+
+    // 여기에 새 parent를 만드는 비용
+    const float cost = 2.f * combinedArea;
+    // 더 내려갈 때 위쪽 node들이 커지는 비용
+    const float inheritanceCost = 2.f * (combinedArea - area);
+
+    auto childCost = [&](proxy_t child) {
+      const LveAabb merged = LveAabb::merge(leafAabb, nodes[child].aabb);
+      if (nodes[child].isLeaf()) {
+        return merged.surfaceArea() + inheritanceCost;
+      }
+      return merged.surfaceArea() - nodes[child].aabb.surfaceArea() +
+             inheritanceCost;
+    };
+    const float cost1 = childCost(node.child1);
+    const float cost2 = childCost(node.child2);
+
+    if (cost < cost1 && cost < cost2) {
+      break;
+    }
+    index = cost1 < cost2 ? node.child1 : node.child2;
+  }
+
+  const proxy_t sibling = index;
+  const proxy_t oldParent = nodes[sibling].parent;
+  const proxy_t newParent = allocateNode();
+  nodes[newParent].parent = oldParent;
+  nodes[newParent].aabb = LveAabb::merge(leafAabb, nodes[sibling].aabb);
+  nodes[newParent].height = nodes[sibling].height + 1;
+  nodes[newParent].child1 = sibling;
+  nodes[newParent].child2 = leaf;
+  nodes[sibling].parent = newParent;
+  nodes[leaf].parent = newParent;
+
+  if (oldParent != NULL_NODE) {
+    if (nodes[oldParent].child1 == sibling) {
+      nodes[oldParent].child1 = newParent;
+    } else {
+      nodes[oldParent].child2 = newParent;
+    }
+  } else {
+    root = newParent;
+  }
+
+  fixUpwards(newParent);
+}
+
+void LveBvh::removeLeaf(proxy_t leaf) {
+  if (leaf == root) {
+    root = NULL_NODE;
+    return;
+  }
+
+  const proxy_t parent = nodes[leaf].parent;
+  const proxy_t grandParent = nodes[parent].parent;
+  const proxy_t sibling = nodes[parent].child1 == leaf ? nodes[parent].child2
+                                                       : nodes[parent].child1;
+
+  if (grandParent != NULL_NODE) {
+    if (nodes[grandParent].child1 == parent) {
+      nodes[grandParent].child1 = sibling;
+    } else {
+      nodes[grandParent].child2 = sibling;
+    }
+    nodes[sibling].parent = grandParent;
+    freeNode(parent);
+    fixUpwards(grandParent);
+  } else {
+    root = sibling;
+    nodes[sibling].parent = NULL_NODE;
+    freeNode(parent);
+  }
+}
+
+void LveBvh::fixUpwards(proxy_t index) {
+  while (index != NULL_NODE) {
+    index = balance(index);
+    Node &node = nodes[index];
+    node.height =
+        1 + std::max(nodes[node.child1].height, nodes[node.child2].height);
+    node.aabb = LveAabb::merge(nodes[node.child1].aabb, nodes[node.child2].aabb);
+    index = node.parent;
+  }
+}
+
+// 높이 차이가 1보다 크면 회전, 새 subtree root 반환
+LveBvh::proxy_t LveBvh::balance(proxy_t a) {
+  if (nodes[a].isLeaf() || nodes[a].height < 2) {
+    return a;
+  }
+
+  const proxy_t b = nodes[a].child1;
+  const proxy_t c = nodes[a].child2;
+  const int heightDiff = nodes[c].height - nodes[b].height;
+
+  // 높은 쪽 child(up)를 a 자리로 올리고, up의 child 중 낮은 쪽을 a에게 넘김
+  auto rotate = [&](proxy_t up, proxy_t other, bool upIsChild2) {
+    const proxy_t f = nodes[up].child1;
+    const proxy_t g = nodes[up].child2;
+
+    nodes[up].child1 = a;
+    nodes[up].parent = nodes[a].parent;
+    nodes[a].parent = up;
+
+    if (nodes[up].parent != NULL_NODE) {
+      if (nodes[nodes[up].parent].child1 == a) {
+        nodes[nodes[up].parent].child1 = up;
+      } else {
+        nodes[nodes[up].parent].child2 = up;
+      }
+    } else {
+      root = up;
+    }
+
+    const proxy_t keep = nodes[f].height > nodes[g].height ? f : g;
+    const proxy_t give = keep == f ? g : f;
+
+    nodes[up].child2 = keep;
+    if (upIsChild2) {
+      nodes[a].child2 = give;
+    } else {
+      nodes[a].child1 = give;
+    }
+    nodes[give].parent = a;
+
+    nodes[a].aabb = LveAabb::merge(nodes[other].aabb, nodes[give].aabb);
+    nodes[up].aabb = LveAabb::merge(nodes[a].aabb, nodes[keep].aabb);
+    nodes[a].height =
+        1 + std::max(nodes[other].height, nodes[give].height);
+    nodes[up].height = 1 + std::max(nodes[a].height, nodes[keep].height);
+    return up;
+  };
+
+  if (heightDiff > 1) {
+    return rotate(c, b, true);
+  }
+  if (heightDiff < -1) {
+    return rotate(b, c, false);
+  }
+  return a;
+}
+
+} // namespace lve
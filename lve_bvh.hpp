@@ -0,0 +1,274 @@
+#pragma once
+
+// libs
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+// std
+#include <cstdint>
+#include <vector>
+
+namespace lve {
+
+struct LveAabb {
+  glm::vec3 min{0.f};
+  glm::vec3 max{0.f};
+
+  bool contains(const LveAabb &other) const {
+    return min.x <= other.min.x && min.y <= other.min.y &&
+           min.z <= other.min.z && other.max.x <= max.x &&
+           other.max.y <= max.y && other.max.z <= max.z;
+  }
+
+  // SAH 비용 계산용 표면적
+  float surfaceArea() const {
+    const glm::vec3 d = max - min;
+    return 2.f * (d.x * d.y + d.y * d.z + d.z * d.x);
+  }
+
+  static LveAabb merge(const LveAabb &a, const LveAabb &b) {
+    return {glm::min(a.min, b.min), glm::max(a.max, b.max)};
+  }
+
+  /**
+   * @brief local AABB를 matrix로 변환한 world AABB (Arvo 방식)
+   */
+  LveAabb transformed(const glm::mat4 &matrix) const;
+};
+
+/**
+ * @brief projection * view에서 뽑은 6개 평면, 법선은 frustum 안쪽 방향
+ */
+struct LveFrustum {
+  glm::vec4 planes[6];
+
+  /**
+   * @brief clip space depth 0..1 (GLM_FORCE_DEPTH_ZERO_TO_ONE) 기준으로 평면 추출
+   */
+  static LveFrustum fromMatrix(const glm::mat4 &projectionView);
+
+  enum class Result { OUTSIDE, INTERSECT, INSIDE };
+  Result test(const LveAabb &aabb) const;
+};
+
+/**
+ * @brief 동적 AABB tree (Box2D b2DynamicTree 방식)
+ *
+ * leaf는 margin만큼 키운 fat AABB를 저장하므로 조금 움직인 객체는 tree를 건드리지
+ * 않음, 크게 움직이면 제거 후 SAH 기준으로 재삽입하고 회전으로 균형 유지
+ * 많은 객체가 한꺼번에 움직일 때는 setBounds() 후 refit() 한 번으로 갱신
+ */
+class LveBvh {
+public:
+  using proxy_t = int32_t;
+  static constexpr proxy_t NULL_NODE = -1;
+
+  LveBvh() = default;
+
+  LveBvh(const LveBvh &) = delete;
+  LveBvh &operator=(const LveBvh &) = delete;
+
+  proxy_t insert(const LveAabb &aabb, uint32_t userData);
+  void remove(proxy_t proxy);
+
+  /**
+   * @brief 증분 갱신, 새 AABB가 fat AABB를 벗어날 때만 재삽입
+   *
+   * @return 재삽입 여부
+   */
+  bool move(proxy_t proxy, const LveAabb &aabb);
+
+  /**
+   * @brief 일괄 갱신용, tree 구조는 그대로 두고 leaf AABB만 교체
+   * 모두 교체한 뒤 refit()을 호출해야 내부 node가 맞게 됨
+   */
+  void setBounds(proxy_t proxy, const LveAabb &aabb);
+
+  /**
+   * @brief 모든 내부 node AABB를 아래에서 위로 다시 계산
+   */
+  void refit();
+
+  uint32_t getUserData(proxy_t proxy) const { return nodes[proxy].userData; }
+  const LveAabb &getFatAabb(proxy_t proxy) const { return nodes[proxy].aabb; }
+
+  size_t size() const { return leafCount; }
+  int height() const { return root == NULL_NODE ? 0 : nodes[root].height; }
+
+  /**
+   * @brief frustum 안에 있는 leaf의 userData 전달
+   * 밖에 있는 subtree는 통째로 버리고, 완전히 안에 있는 subtree는 평면 검사 생략
+   *
+   * @param fn fn(uint32_t userData)
+   */
+  template <typename Fn> void queryFrustum(const LveFrustum &frustum, Fn fn) const;
+
+  /**
+   * @param fn fn(uint32_t userData)
+   */
+  template <typename Fn>
+  void querySphere(const glm::vec3 &center, float radius, Fn fn) const;
+
+  /**
+   * @brief ray와 fat AABB가 겹치는 leaf 전달
+   * fn이 반환한 거리로 이후 탐색 범위를 줄임 (가장 가까운 객체 picking)
+   *
+   * @param fn float fn(uint32_t userData, float tEnter) -> 새 maxDistance
+   */
+  template <typename Fn>
+  void queryRay(const glm::vec3 &origin, const glm::vec3 &direction,
+                float maxDistance, Fn fn) const;
+
+  // leaf AABB에 더하는 여유 공간
+  float fatMargin = 0.1f;
+
+private:
+  struct Node {
+    LveAabb aabb{};
+    proxy_t parent = NULL_NODE; // free list에서는 다음 free node
+    proxy_t child1 = NULL_NODE;
+    proxy_t child2 = NULL_NODE;
+    int height = 0; // leaf 0, free -1
+    uint32_t userData = 0;
+
+    bool isLeaf() const { return child1 == NULL_NODE; }
+  };
+
+  proxy_t allocateNode();
+  void freeNode(proxy_t node);
+  void insertLeaf(proxy_t leaf);
+  void removeLeaf(proxy_t leaf);
+  proxy_t balance(proxy_t node);
+  void fixUpwards(proxy_t node);
+  LveAabb fatten(const LveAabb &aabb) const;
+
+  template <typename Fn> void reportSubtree(proxy_t node, Fn &fn) const;
+
+  std::vector<Node> nodes;
+  proxy_t root = NULL_NODE;
+  proxy_t freeList = NULL_NODE;
+  size_t leafCount = 0;
+
+  // query용 stack, 재할당을 피하기 위해 재사용
+  // -> query는 한 번에 한 thread에서만 호출
+  mutable std::vector<proxy_t> stack;
+};
+
+template <typename Fn> void LveBvh::reportSubtree(proxy_t node, Fn &fn) const {
+  const size_t base = stack.size();
+  stack.push_back(node);
+  while (stack.size() > base) {
+    const proxy_t current = stack.back();
+    stack.pop_back();
+    const Node &n = nodes[current];
+    if (n.isLeaf()) {
+      fn(n.userData);
+    } else {
+      stack.push_back(n.child1);
+      stack.push_back(n.child2);
+    }
+  }
+}
+
+template <typename Fn>
+void LveBvh::queryFrustum(const LveFrustum &frustum, Fn fn) const {
+  if (root == NULL_NODE) {
+    return;
+  }
+  stack.clear();
+  stack.push_back(root);
+  while (!stack.empty()) {
+    const proxy_t current = stack.back();
+    stack.pop_back();
+    const Node &node = nodes[current];
+
+    const auto result = frustum.test(node.aabb);
+    if (result == LveFrustum::Result::OUTSIDE) {
+      continue;
+    }
+    if (result == LveFrustum::Result::INSIDE || node.isLeaf()) {
+      reportSubtree(current, fn);
+      continue;
+    }
+    stack.push_back(node.child1);
+    stack.push_back(node.child2);
+  }
+}
+
+template <typename Fn>
+void LveBvh::querySphere(const glm::vec3 &center, float radius, Fn fn) const {
+  if (root == NULL_NODE) {
+    return;
+  }
+  const float radiusSquared = radius * radius;
+  stack.clear();
+  stack.push_back(root);
+  while (!stack.empty()) {
+    const Node &node = nodes[stack.back()];
+    stack.pop_back();
+
+    // AABB 위의 가장 가까운 점까지 거리
+    const glm::vec3 closest = glm::max(node.aabb.min, glm::min(center, node.aabb.max));
+    const glm::vec3 offset = closest - center;
+    if (glm::dot(offset, offset) > radiusSquared) {
+      continue;
+    }
+    if (node.isLeaf()) {
+      fn(node.userData);
+    } else {
+      stack.push_back(node.child1);
+      stack.push_back(node.child2);
+    }
+  }
+}
+
+template <typename Fn>
+void LveBvh::queryRay(const glm::vec3 &origin, const glm::vec3 &direction,
+                      float maxDistance, Fn fn) const {
+  if (root == NULL_NODE) {
+    return;
+  }
+  // direction이 0인 축은 slab 밖이면 miss, 안이면 t 범위를 제한하지 않음
+  // ((bound - origin) * inf가 0 * inf = NaN이 되는 경우를 피함)
+  glm::vec3 inverse{0.f};
+  for (int axis = 0; axis < 3; axis++) {
+    if (direction[axis] != 0.f) {
+      inverse[axis] = 1.f / direction[axis];
+    }
+  }
+  stack.clear();
+  stack.push_back(root);
+  while (!stack.empty()) {
+    const Node &node = nodes[stack.back()];
+    stack.pop_back();
+
+    // slab test
+    float enter = 0.f;
+    float exit = maxDistance;
+    for (int axis = 0; axis < 3 && enter <= exit; axis++) {
+      if (direction[axis] == 0.f) {
+        if (origin[axis] < node.aabb.min[axis] ||
+            origin[axis] > node.aabb.max[axis]) {
+          exit = -1.f;
+        }
+        continue;
+      }
+      const float t0 = (node.aabb.min[axis] - origin[axis]) * inverse[axis];
+      const float t1 = (node.aabb.max[axis] - origin[axis]) * inverse[axis];
+      enter = glm::max(enter, glm::min(t0, t1));
+      exit = glm::min(exit, glm::max(t0, t1));
+    }
+    if (enter > exit) {
+      continue;
+    }
+    if (node.isLeaf()) {
+      maxDistance = fn(node.userData, enter);
+    } else {
+      stack.push_back(node.child1);
+      stack.push_back(node.child2);
+    }
+  }
+}
+
+} // namespace lve
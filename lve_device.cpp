@@ -1,8 +1,13 @@
 #include "lve_device.hpp"
+#include "lve_log.hpp"
+#include "lve_vulkan_dispatch.hpp"
 
 // std headers
+#include <algorithm>
+#include <cassert>
+#include <chrono>
 #include <cstring>
-#include <iostream>
+#include <iomanip>
 #include <set>
 #include <unordered_set>
 
@@ -14,7 +19,11 @@ debugCallback(VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
               VkDebugUtilsMessageTypeFlagsEXT messageType,
               const VkDebugUtilsMessengerCallbackDataEXT *pCallbackData,
               void *pUserData) {
-  std::cerr << "validation layer: " << pCallbackData->pMessage << std::endl;
+  const auto level =
+      messageSeverity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT
+          ? LveLog::Level::ERROR
+          : LveLog::Level::WARN;
+  LveLogLine{level} << "validation layer: " << pCallbackData->pMessage;
 
   return VK_FALSE;
 }
@@ -54,9 +63,15 @@ LveDevice::LveDevice(LveWindow &window) : window{window} {
   createLogicalDevice();
 
   createCommandPool();
+
+  refreshMemoryBudget();
 }
 
 LveDevice::~LveDevice() {
+  // 아직 예약된 object는 GPU가 끝난 뒤 전부 파괴
+  vkDeviceWaitIdle(device_);
+  flushDeferred();
+
   vkDestroyCommandPool(device_, commandPool, nullptr);
   vkDestroyDevice(device_, nullptr);
 
@@ -128,7 +143,7 @@ void LveDevice::pickPhysicalDevice() {
     throw std::runtime_error("failed to find GPUs with Vulkan support!");
   }
 
-  std::cout << "Device count: " << deviceCount << std::endl;
+  LVE_LOG_INFO << "Device count: " << deviceCount;
   std::vector<VkPhysicalDevice> devices(deviceCount);
   vkEnumeratePhysicalDevices(instance, &deviceCount, devices.data());
 
@@ -144,7 +159,28 @@ void LveDevice::pickPhysicalDevice() {
   }
 
   vkGetPhysicalDeviceProperties(physicalDevice, &properties);
-  std::cout << "physical device: " << properties.deviceName << std::endl;
+  vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+  LVE_LOG_INFO << "physical device: " << properties.deviceName;
+
+  // device local이면서 host visible인 memory (integrated, UMA, ReBAR)
+  VkDeviceSize directHeapSize = 0;
+  for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+    const auto &type = memoryProperties.memoryTypes[i];
+    if ((type.propertyFlags & DIRECT_WRITE_PROPERTIES) ==
+        DIRECT_WRITE_PROPERTIES) {
+      directWriteSupported = true;
+      directHeapSize = std::max(
+          directHeapSize, memoryProperties.memoryHeaps[type.heapIndex].size);
+    }
+  }
+  directUploadSupported = directHeapSize > DIRECT_UPLOAD_MIN_HEAP;
+  LVE_LOG_INFO << "uploads: "
+               << (directUploadSupported ? "direct write"
+                   : directWriteSupported
+                       ? "staging (direct write for per-frame buffers)"
+                       : "staging")
+               << ", device local host visible heap "
+               << directHeapSize / (1024 * 1024) << " MiB";
 }
 
 // 논리적 디바이스생성, GPU 큐 생성
@@ -172,6 +208,11 @@ void LveDevice::createLogicalDevice() {
   VkPhysicalDeviceFeatures deviceFeatures = {};
   // 텍스처 필터링에서 이방성 필터링(Anisotropic Filtering) 기능을 활성화
   deviceFeatures.samplerAnisotropy = VK_TRUE;
+  // 지원하면 pass별 vertex/fragment 수 측정 (pipeline statistics query)
+  VkPhysicalDeviceFeatures supportedFeatures;
+  vkGetPhysicalDeviceFeatures(physicalDevice, &supportedFeatures);
+  deviceFeatures.pipelineStatisticsQuery =
+      supportedFeatures.pipelineStatisticsQuery;
 
   // 논리적 디바이스 생성 정보 설정
   VkDeviceCreateInfo createInfo = {};
@@ -182,9 +223,35 @@ void LveDevice::createLogicalDevice() {
   createInfo.pQueueCreateInfos = queueCreateInfos.data();
 
   createInfo.pEnabledFeatures = &deviceFeatures;
-  createInfo.enabledExtensionCount =
-      static_cast<uint32_t>(deviceExtensions.size());
-  createInfo.ppEnabledExtensionNames = deviceExtensions.data();
+  enabledFeatures = deviceFeatures;
+
+  // 지원하면 heap별 예산과 사용량을 driver에서 읽음 (VK_EXT_memory_budget)
+  std::vector<const char *> extensions = deviceExtensions;
+  uint32_t extensionCount;
+  vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr,
+                                       &extensionCount, nullptr);
+  std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+  vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr,
+                                       &extensionCount,
+                                       availableExtensions.data());
+  getMemoryProperties2 =
+      reinterpret_cast<PFN_vkGetPhysicalDeviceMemoryProperties2KHR>(
+          vkGetInstanceProcAddr(instance,
+                                "vkGetPhysicalDeviceMemoryProperties2KHR"));
+  for (const auto &extension : availableExtensions) {
+    if (getMemoryProperties2 != nullptr &&
+        std::strcmp(extension.extensionName,
+                    VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) == 0) {
+      memoryBudgetSupported = true;
+      extensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    }
+  }
+  LVE_LOG_INFO << "memory budget: "
+               << (memoryBudgetSupported ? VK_EXT_MEMORY_BUDGET_EXTENSION_NAME
+                                         : "estimated from heap size");
+
+  createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+  createInfo.ppEnabledExtensionNames = extensions.data();
 
   if (enableValidationLayers) {
     createInfo.enabledLayerCount =
@@ -318,17 +385,20 @@ void LveDevice::hasGflwRequiredInstanceExtensions() {
   vkEnumerateInstanceExtensionProperties(nullptr, &extensionCount,
                                          extensions.data());
 
-  std::cout << "available extensions:" << std::endl;
+  // 목록 전체를 한 번에 넣음 -> 줄마다 record 하나
+  LveLogLine availableLog{LveLog::Level::DEBUG};
+  availableLog << "available extensions:\n";
   std::unordered_set<std::string> available;
   for (const auto &extension : extensions) {
-    std::cout << "\t" << extension.extensionName << std::endl;
+    availableLog << "\t" << extension.extensionName << "\n";
     available.insert(extension.extensionName);
   }
 
-  std::cout << "required extensions:" << std::endl;
+  LveLogLine requiredLog{LveLog::Level::INFO};
+  requiredLog << "required extensions:\n";
   auto requiredExtensions = getRequiredExtensions();
   for (const auto &required : requiredExtensions) {
-    std::cout << "\t" << required << std::endl;
+    requiredLog << "\t" << required << "\n";
     if (available.find(required) == available.end()) {
       throw std::runtime_error("Missing required glfw extension");
     }
@@ -432,13 +502,29 @@ VkFormat LveDevice::findSupportedFormat(const std::vector<VkFormat> &candidates,
   throw std::runtime_error("failed to find supported format!");
 }
 
+uint32_t LveDevice::getTimestampValidBits() {
+  QueueFamilyIndices indices = findPhysicalQueueFamilies();
+
+  uint32_t queueFamilyCount = 0;
+  vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount,
+                                           nullptr);
+  std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+  vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount,
+                                           queueFamilies.data());
+
+  if (!indices.graphicsFamilyHasValue ||
+      indices.graphicsFamily >= queueFamilyCount) {
+    return 0;
+  }
+  return queueFamilies[indices.graphicsFamily].timestampValidBits;
+}
+
 uint32_t LveDevice::findMemoryType(uint32_t typeFilter,
                                    VkMemoryPropertyFlags properties) {
-  VkPhysicalDeviceMemoryProperties memProperties;
-  vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
-  for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
-    if ((typeFilter & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags &
-                                    properties) == properties) {
+  for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+    if ((typeFilter & (1 << i)) &&
+        (memoryProperties.memoryTypes[i].propertyFlags & properties) ==
+            properties) {
       return i;
     }
   }
@@ -448,7 +534,8 @@ uint32_t LveDevice::findMemoryType(uint32_t typeFilter,
 
 void LveDevice::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage,
                              VkMemoryPropertyFlags properties, VkBuffer &buffer,
-                             VkDeviceMemory &bufferMemory) {
+                             VkDeviceMemory &bufferMemory,
+                             LveMemoryCategory category) {
   VkBufferCreateInfo bufferInfo{};
   bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
   bufferInfo.size = size;
@@ -474,6 +561,14 @@ void LveDevice::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage,
   }
 
   vkBindBufferMemory(device_, buffer, bufferMemory, 0);
+  trackAllocation(bufferMemory, memRequirements.size,
+                  allocInfo.memoryTypeIndex, category);
+}
+
+void LveDevice::destroyBuffer(VkBuffer buffer, VkDeviceMemory bufferMemory) {
+  vkDestroyBuffer(device_, buffer, nullptr);
+  vkFreeMemory(device_, bufferMemory, nullptr);
+  untrackAllocation(bufferMemory);
 }
 
 VkCommandBuffer LveDevice::beginSingleTimeCommands() {
@@ -490,20 +585,20 @@ VkCommandBuffer LveDevice::beginSingleTimeCommands() {
   beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
   beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 
-  vkBeginCommandBuffer(commandBuffer, &beginInfo);
+  vkd::beginCommandBuffer(commandBuffer, &beginInfo);
   return commandBuffer;
 }
 
 void LveDevice::endSingleTimeCommands(VkCommandBuffer commandBuffer) {
-  vkEndCommandBuffer(commandBuffer);
+  vkd::endCommandBuffer(commandBuffer);
 
   VkSubmitInfo submitInfo{};
   submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
   submitInfo.commandBufferCount = 1;
   submitInfo.pCommandBuffers = &commandBuffer;
 
-  vkQueueSubmit(graphicsQueue_, 1, &submitInfo, VK_NULL_HANDLE);
-  vkQueueWaitIdle(graphicsQueue_);
+  vkd::queueSubmit(graphicsQueue_, 1, &submitInfo, VK_NULL_HANDLE);
+  vkd::queueWaitIdle(graphicsQueue_);
 
   vkFreeCommandBuffers(device_, commandPool, 1, &commandBuffer);
 }
@@ -516,11 +611,83 @@ void LveDevice::copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer,
   copyRegion.srcOffset = 0; // Optional
   copyRegion.dstOffset = 0; // Optional
   copyRegion.size = size;
-  vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
+  vkd::cmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
 
   endSingleTimeCommands(commandBuffer);
 }
 
+LveDevice::UploadPath LveDevice::createDeviceLocalBuffer(
+    const void *data, VkDeviceSize size, VkBufferUsageFlags usage,
+    VkBuffer &buffer, VkDeviceMemory &memory, LveMemoryCategory category) {
+  const auto start = std::chrono::steady_clock::now();
+  const bool direct =
+      directUploadSupported &&
+      directUploadEnabled.load(std::memory_order_relaxed) &&
+      fitsMemoryBudget(size, bufferMemoryTypeBits(usage),
+                       DIRECT_WRITE_PROPERTIES);
+
+  if (direct) {
+    // GPU가 읽을 memory에 바로 씀 -> staging buffer, copy, queue 대기 없음
+    createBuffer(size, usage, DIRECT_WRITE_PROPERTIES, buffer, memory,
+                 category);
+    void *mapped;
+    vkMapMemory(device_, memory, 0, size, 0, &mapped);
+    std::memcpy(mapped, data, static_cast<size_t>(size));
+    vkUnmapMemory(device_, memory);
+  } else {
+    VkBuffer stagingBuffer;
+    VkDeviceMemory stagingBufferMemory;
+    createBuffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                     VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                 stagingBuffer, stagingBufferMemory,
+                 LveMemoryCategory::STAGING);
+    void *mapped;
+    vkMapMemory(device_, stagingBufferMemory, 0, size, 0, &mapped);
+    std::memcpy(mapped, data, static_cast<size_t>(size));
+    vkUnmapMemory(device_, stagingBufferMemory);
+
+    createBuffer(size, usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, buffer, memory,
+                 category);
+    copyBuffer(stagingBuffer, buffer, size);
+    destroyBuffer(stagingBuffer, stagingBufferMemory);
+  }
+
+  const UploadPath path = direct ? UploadPath::DIRECT : UploadPath::STAGING;
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  const auto pathIndex = static_cast<size_t>(path);
+  {
+    std::lock_guard<std::mutex> lock{uploadMutex};
+    auto &stats = uploadStats[pathIndex];
+    stats.count++;
+    stats.bytes += size;
+    stats.seconds += std::chrono::duration<double>(elapsed).count();
+  }
+  uploadBytesMetrics[pathIndex]->add(size);
+  uploadMicrosecondsMetrics[pathIndex]->add(static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(elapsed)
+          .count()));
+  return path;
+}
+
+VkMemoryPropertyFlags
+LveDevice::hostWriteMemoryProperties(VkDeviceSize size,
+                                     VkBufferUsageFlags usage) {
+  if (directWriteSupported &&
+      fitsMemoryBudget(size, bufferMemoryTypeBits(usage),
+                       DIRECT_WRITE_PROPERTIES)) {
+    return DIRECT_WRITE_PROPERTIES;
+  }
+  return VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+         VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+}
+
+LveDevice::UploadStats LveDevice::getUploadStats(UploadPath path) const {
+  std::lock_guard<std::mutex> lock{uploadMutex};
+  return uploadStats[static_cast<size_t>(path)];
+}
+
 void LveDevice::copyBufferToImage(VkBuffer buffer, VkImage image,
                                   uint32_t width, uint32_t height,
                                   uint32_t layerCount) {
@@ -539,15 +706,16 @@ void LveDevice::copyBufferToImage(VkBuffer buffer, VkImage image,
   region.imageOffset = {0, 0, 0};
   region.imageExtent = {width, height, 1};
 
-  vkCmdCopyBufferToImage(commandBuffer, buffer, image,
-                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+  vkd::cmdCopyBufferToImage(commandBuffer, buffer, image,
+                            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
   endSingleTimeCommands(commandBuffer);
 }
 
 void LveDevice::createImageWithInfo(const VkImageCreateInfo &imageInfo,
                                     VkMemoryPropertyFlags properties,
                                     VkImage &image,
-                                    VkDeviceMemory &imageMemory) {
+                                    VkDeviceMemory &imageMemory,
+                                    LveMemoryCategory category) {
   if (vkCreateImage(device_, &imageInfo, nullptr, &image) != VK_SUCCESS) {
     throw std::runtime_error("failed to create image!");
   }
@@ -569,6 +737,355 @@ void LveDevice::createImageWithInfo(const VkImageCreateInfo &imageInfo,
   if (vkBindImageMemory(device_, image, imageMemory, 0) != VK_SUCCESS) {
     throw std::runtime_error("failed to bind image memory!");
   }
+  trackAllocation(imageMemory, memRequirements.size,
+                  allocInfo.memoryTypeIndex, category);
+}
+
+void LveDevice::destroyImage(VkImage image, VkDeviceMemory imageMemory) {
+  vkDestroyImage(device_, image, nullptr);
+  vkFreeMemory(device_, imageMemory, nullptr);
+  untrackAllocation(imageMemory);
+}
+
+void LveDevice::trackAllocation(VkDeviceMemory memory, VkDeviceSize size,
+                                uint32_t memoryTypeIndex,
+                                LveMemoryCategory category) {
+  const uint32_t heapIndex =
+      memoryProperties.memoryTypes[memoryTypeIndex].heapIndex;
+  const auto categoryIndex = static_cast<size_t>(category);
+  bool crossedBudget = false;
+  VkDeviceSize usage;
+  VkDeviceSize budget;
+  {
+    std::lock_guard<std::mutex> lock{memoryMutex};
+    allocations[memory] = {size, category, heapIndex};
+    heapTracked[heapIndex] += size;
+    categoryBytes[categoryIndex] += size;
+    categoryAllocations[categoryIndex]++;
+
+    // 예산을 넘는 순간 한 번만 경고 (그 뒤 할당은 실패하거나 느려질 수 있음)
+    // driver 값은 frame마다 읽고 그 사이는 tracked 변화로 추정
+    usage = estimatedHeapUsage(heapIndex);
+    budget = heapBudget[heapIndex];
+    const bool over = usage > budget;
+    crossedBudget = over && !heapOverBudget[heapIndex];
+    heapOverBudget[heapIndex] = over;
+  }
+  memoryBytesMetric.add(static_cast<double>(size));
+  memoryAllocationsMetric.add(1.0);
+  categoryMetrics[categoryIndex]->add(static_cast<double>(size));
+
+  if (crossedBudget) {
+    LVE_LOG_WARN << "memory heap " << heapIndex << " over budget: "
+                 << usage / (1024 * 1024) << " / "
+                 << budget / (1024 * 1024) << " MiB after "
+                 << size / 1024 << " KiB " << memoryCategoryName(category)
+                 << " allocation";
+  }
+}
+
+void LveDevice::untrackAllocation(VkDeviceMemory memory) {
+  MemoryAllocation allocation;
+  {
+    std::lock_guard<std::mutex> lock{memoryMutex};
+    auto it = allocations.find(memory);
+    assert(it != allocations.end() && "Memory was not allocated by LveDevice");
+    allocation = it->second;
+    allocations.erase(it);
+    heapTracked[allocation.heapIndex] -= allocation.size;
+    categoryBytes[static_cast<size_t>(allocation.category)] -= allocation.size;
+    categoryAllocations[static_cast<size_t>(allocation.category)]--;
+  }
+  memoryBytesMetric.add(-static_cast<double>(allocation.size));
+  memoryAllocationsMetric.add(-1.0);
+  categoryMetrics[static_cast<size_t>(allocation.category)]->add(
+      -static_cast<double>(allocation.size));
+}
+
+void LveDevice::refreshMemoryBudget() {
+  VkPhysicalDeviceMemoryBudgetPropertiesEXT budget{};
+  budget.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+  if (memoryBudgetSupported) {
+    VkPhysicalDeviceMemoryProperties2KHR properties2{};
+    properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+    properties2.pNext = &budget;
+    getMemoryProperties2(physicalDevice, &properties2);
+  }
+
+  std::lock_guard<std::mutex> lock{memoryMutex};
+  for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++) {
+    if (memoryBudgetSupported) {
+      heapBudget[i] = budget.heapBudget[i];
+      heapUsage[i] = budget.heapUsage[i];
+      heapTrackedAtRefresh[i] = heapTracked[i];
+    } else {
+      // usage는 항상 tracked
+      heapBudget[i] = static_cast<VkDeviceSize>(
+          static_cast<double>(memoryProperties.memoryHeaps[i].size) *
+          FALLBACK_BUDGET_RATIO);
+      heapUsage[i] = 0;
+      heapTrackedAtRefresh[i] = 0;
+    }
+  }
+}
+
+VkDeviceSize LveDevice::estimatedHeapUsage(uint32_t heapIndex) const {
+  const VkDeviceSize grown = heapUsage[heapIndex] + heapTracked[heapIndex];
+  const VkDeviceSize freed = heapTrackedAtRefresh[heapIndex];
+  return grown > freed ? grown - freed : 0;
+}
+
+void LveDevice::cachedHeapBudgets(std::vector<MemoryHeapBudget> &heaps) {
+  std::lock_guard<std::mutex> lock{memoryMutex};
+  heaps.resize(memoryProperties.memoryHeapCount);
+  for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++) {
+    const VkMemoryHeap &heap = memoryProperties.memoryHeaps[i];
+    auto &result = heaps[i];
+    result.size = heap.size;
+    result.deviceLocal = (heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+    result.tracked = heapTracked[i];
+    result.budget = heapBudget[i];
+    result.usage = estimatedHeapUsage(i);
+  }
+}
+
+LveDevice::MemoryReport LveDevice::memoryReport() {
+  MemoryReport report{};
+  report.budgetExtension = memoryBudgetSupported;
+  // 가끔 호출하므로 driver 값을 새로 읽음
+  refreshMemoryBudget();
+  cachedHeapBudgets(report.heaps);
+  std::lock_guard<std::mutex> lock{memoryMutex};
+  report.categoryBytes = categoryBytes;
+  report.categoryAllocations = categoryAllocations;
+  return report;
+}
+
+bool LveDevice::fitsMemoryBudget(VkDeviceSize size, uint32_t memoryTypeBits,
+                                 VkMemoryPropertyFlags properties) {
+  // createBuffer()/createImageWithInfo()와 같은 memory type -> 같은 heap
+  for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+    const auto &type = memoryProperties.memoryTypes[i];
+    if ((memoryTypeBits & (1u << i)) &&
+        (type.propertyFlags & properties) == properties) {
+      std::lock_guard<std::mutex> lock{memoryMutex};
+      return estimatedHeapUsage(type.heapIndex) + size <=
+             heapBudget[type.heapIndex];
+    }
+  }
+  // 이 속성으로는 할당할 수 없음
+  return false;
+}
+
+uint32_t LveDevice::bufferMemoryTypeBits(VkBufferUsageFlags usage) {
+  {
+    std::lock_guard<std::mutex> lock{memoryMutex};
+    auto it = bufferTypeBits.find(usage);
+    if (it != bufferTypeBits.end()) {
+      return it->second;
+    }
+  }
+
+  // 같은 usage, flags의 buffer는 memoryTypeBits가 같음 -> usage마다 한 번만 확인
+  VkBufferCreateInfo bufferInfo{};
+  bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+  bufferInfo.size = 1;
+  bufferInfo.usage = usage;
+  bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+  VkBuffer buffer;
+  if (vkCreateBuffer(device_, &bufferInfo, nullptr, &buffer) != VK_SUCCESS) {
+    throw std::runtime_error("failed to create buffer!");
+  }
+  VkMemoryRequirements memRequirements;
+  vkGetBufferMemoryRequirements(device_, buffer, &memRequirements);
+  vkDestroyBuffer(device_, buffer, nullptr);
+
+  std::lock_guard<std::mutex> lock{memoryMutex};
+  bufferTypeBits[usage] = memRequirements.memoryTypeBits;
+  return memRequirements.memoryTypeBits;
+}
+
+void LveDevice::logMemoryReport() {
+  constexpr double MIB = 1024.0 * 1024.0;
+  const MemoryReport report = memoryReport();
+  for (size_t i = 0; i < report.heaps.size(); i++) {
+    const auto &heap = report.heaps[i];
+    if (heap.tracked == 0 && heap.usage == 0) {
+      continue;
+    }
+    LVE_LOG_INFO << std::fixed << std::setprecision(1) << "memory heap " << i
+                 << (heap.deviceLocal ? " device local" : " host") << ": "
+                 << heap.usage / MIB << " / " << heap.budget / MIB
+                 << " MiB budget ("
+                 << (heap.budget > 0 ? 100.0 * heap.usage / heap.budget : 0.0)
+                 << "%), tracked " << heap.tracked / MIB << " MiB";
+  }
+
+  LveLogLine line{LveLog::Level::INFO};
+  line << std::fixed << std::setprecision(1) << "memory by category:";
+  for (size_t i = 0; i < MEMORY_CATEGORY_COUNT; i++) {
+    line << " " << memoryCategoryName(static_cast<LveMemoryCategory>(i)) << " "
+         << report.categoryBytes[i] / MIB << " MiB ("
+         << report.categoryAllocations[i] << ")";
+  }
+}
+
+const char *LveDevice::memoryCategoryName(LveMemoryCategory category) {
+  switch (category) {
+  case LveMemoryCategory::GEOMETRY:
+    return "geometry";
+  case LveMemoryCategory::DEPTH:
+    return "depth";
+  case LveMemoryCategory::STAGING:
+    return "staging";
+  case LveMemoryCategory::UNIFORM:
+    return "uniform";
+  case LveMemoryCategory::TEXTURE:
+    return "texture";
+  case LveMemoryCategory::OTHER:
+  case LveMemoryCategory::COUNT:
+    break;
+  }
+  return "other";
+}
+
+std::array<LveGauge *, LveDevice::MEMORY_CATEGORY_COUNT>
+LveDevice::createCategoryMetrics() {
+  std::array<LveGauge *, MEMORY_CATEGORY_COUNT> metrics{};
+  for (size_t i = 0; i < MEMORY_CATEGORY_COUNT; i++) {
+    const char *name = memoryCategoryName(static_cast<LveMemoryCategory>(i));
+    metrics[i] = &LveMetrics::gauge(
+        std::string{"lve_device_memory_"} + name + "_bytes",
+        std::string{"Bytes of device memory allocated for "} + name);
+  }
+  return metrics;
+}
+
+uint64_t LveDevice::advanceSubmission() {
+  return submitted.fetch_add(1, std::memory_order_acq_rel) + 1;
+}
+
+void LveDevice::completeSubmission(uint64_t submission) {
+  // fence를 frame 순서와 다르게 확인해도 번호가 뒤로 가지 않도록
+  uint64_t previous = completed.load(std::memory_order_relaxed);
+  while (previous < submission &&
+         !completed.compare_exchange_weak(previous, submission,
+                                          std::memory_order_acq_rel)) {
+  }
+  collectDeferred();
+  // frame마다 한 번 driver 예산을 읽음 (할당 경로에서는 읽지 않음)
+  refreshMemoryBudget();
+}
+
+void LveDevice::deferDestroy(std::function<void()> destroy, VkDeviceSize bytes,
+                             uint64_t lastUse) {
+  if (lastUse == CURRENT_SUBMISSION) {
+    lastUse = submitted.load(std::memory_order_acquire) + 1;
+  }
+  std::lock_guard<std::mutex> lock{deferredMutex};
+  deferredBytesTotal += bytes;
+  deferred.push_back({lastUse, bytes, std::move(destroy)});
+  deferredMetric.add(1.0);
+  deferredBytesMetric.add(static_cast<double>(bytes));
+}
+
+void LveDevice::deferDestroyBuffer(VkBuffer buffer, VkDeviceMemory memory,
+                                   uint64_t lastUse) {
+  VkMemoryRequirements memRequirements;
+  vkGetBufferMemoryRequirements(device_, buffer, &memRequirements);
+  deferDestroy([this, buffer, memory] { destroyBuffer(buffer, memory); },
+               memRequirements.size, lastUse);
+}
+
+void LveDevice::deferDestroyImage(VkImage image, VkDeviceMemory memory,
+                                  uint64_t lastUse) {
+  VkMemoryRequirements memRequirements;
+  vkGetImageMemoryRequirements(device_, image, &memRequirements);
+  deferDestroy([this, image, memory] { destroyImage(image, memory); },
+               memRequirements.size, lastUse);
+}
+
+void LveDevice::deferDestroyImageView(VkImageView imageView,
+                                      uint64_t lastUse) {
+  deferDestroy(
+      [this, imageView] { vkDestroyImageView(device_, imageView, nullptr); },
+      0, lastUse);
+}
+
+void LveDevice::deferDestroyFramebuffer(VkFramebuffer framebuffer,
+                                        uint64_t lastUse) {
+  deferDestroy(
+      [this, framebuffer] {
+        vkDestroyFramebuffer(device_, framebuffer, nullptr);
+      },
+      0, lastUse);
+}
+
+void LveDevice::deferDestroyPipeline(VkPipeline pipeline, uint64_t lastUse) {
+  deferDestroy(
+      [this, pipeline] { vkDestroyPipeline(device_, pipeline, nullptr); },
+      0, lastUse);
+}
+
+void LveDevice::deferDestroySwapchain(VkSwapchainKHR swapChain,
+                                      uint64_t lastUse) {
+  deferDestroy(
+      [this, swapChain] { vkDestroySwapchainKHR(device_, swapChain, nullptr); },
+      0, lastUse);
+}
+
+void LveDevice::deferFreeMemory(VkDeviceMemory memory, VkDeviceSize size,
+                                uint64_t lastUse) {
+  deferDestroy(
+      [this, memory] {
+        vkFreeMemory(device_, memory, nullptr);
+        untrackAllocation(memory);
+      },
+      size, lastUse);
+}
+
+void LveDevice::collectDeferred() {
+  const uint64_t done = completed.load(std::memory_order_acquire);
+
+  // 파괴는 lock 밖에서 -> 다른 thread의 예약을 막지 않음
+  std::vector<DeferredDestruction> ready;
+  {
+    std::lock_guard<std::mutex> lock{deferredMutex};
+    while (!deferred.empty() && deferred.front().lastUse <= done) {
+      deferredBytesTotal -= deferred.front().bytes;
+      deferredMetric.add(-1.0);
+      deferredBytesMetric.add(-static_cast<double>(deferred.front().bytes));
+      ready.push_back(std::move(deferred.front()));
+      deferred.pop_front();
+    }
+  }
+  for (auto &entry : ready) {
+    entry.destroy();
+  }
+}
+
+void LveDevice::flushDeferred() {
+  std::deque<DeferredDestruction> all;
+  {
+    std::lock_guard<std::mutex> lock{deferredMutex};
+    all.swap(deferred);
+    deferredMetric.add(-static_cast<double>(all.size()));
+    deferredBytesMetric.add(-static_cast<double>(deferredBytesTotal));
+    deferredBytesTotal = 0;
+  }
+  for (auto &entry : all) {
+    entry.destroy();
+  }
+}
+
+size_t LveDevice::deferredCount() const {
+  std::lock_guard<std::mutex> lock{deferredMutex};
+  return deferred.size();
+}
+
+VkDeviceSize LveDevice::deferredBytes() const {
+  std::lock_guard<std::mutex> lock{deferredMutex};
+  return deferredBytesTotal;
 }
 
-} // namespace lve
\ No newline at end of file
+} // namespace lve
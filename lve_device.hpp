@@ -1,9 +1,18 @@
 #pragma once
 
+#include "lve_metrics.hpp"
 #include "lve_window.hpp"
 
 // std lib headers
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace lve {
@@ -22,6 +31,19 @@ struct QueueFamilyIndices {
   bool isComplete() { return graphicsFamilyHasValue && presentFamilyHasValue; }
 };
 
+/**
+ * @brief device memory 할당 용도, 용도별 사용량 집계에 사용
+ */
+enum class LveMemoryCategory : uint8_t {
+  GEOMETRY, // vertex, index buffer
+  DEPTH,    // depth attachment
+  STAGING,  // upload, readback용 host visible buffer
+  UNIFORM,  // uniform buffer
+  TEXTURE,  // sampled image
+  OTHER,    // 그 외 attachment 등
+  COUNT
+};
+
 /**
  * @brief device instance 생성
  *
@@ -63,6 +85,11 @@ public:
     return findQueueFamilies(physicalDevice);
   }
 
+  /**
+   * @brief graphics queue timestamp의 유효 bit 수, 0이면 timestamp query 미지원
+   */
+  uint32_t getTimestampValidBits();
+
   /**
    * @brief  Vulkan에서 메모리 할당을 위한 메모리 유형을 선택
    *
@@ -94,10 +121,17 @@ public:
    * @param properties 할당할 메모리의 속성 지정
    * @param buffer 버퍼 객체
    * @param bufferMemory 버퍼에 할당된 메모리를 가리킴
+   * @param category 사용량을 집계할 용도
    */
   void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage,
                     VkMemoryPropertyFlags properties, VkBuffer &buffer,
-                    VkDeviceMemory &bufferMemory);
+                    VkDeviceMemory &bufferMemory, LveMemoryCategory category);
+
+  /**
+   * @brief createBuffer()로 만든 buffer와 memory를 즉시 파괴
+   * GPU가 더 이상 사용하지 않을 때만 호출 (아니면 deferDestroyBuffer)
+   */
+  void destroyBuffer(VkBuffer buffer, VkDeviceMemory bufferMemory);
 
   /**
    * @brief  간단한 작업을 위해 일회성 커맨드 버퍼를 생성하고 시작
@@ -120,6 +154,60 @@ public:
    */
   void copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size);
 
+  // GPU가 읽는 속도 그대로 CPU에서 mapping해서 쓸 수 있는 memory
+  // (integrated GPU, UMA, resizable BAR)
+  static constexpr VkMemoryPropertyFlags DIRECT_WRITE_PROPERTIES =
+      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT |
+      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+      VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+  // heap이 이보다 작으면 (resizable BAR 없는 256 MiB 창) 매 frame 쓰는 작은
+  // buffer에만 사용하고 geometry upload는 staging으로
+  static constexpr VkDeviceSize DIRECT_UPLOAD_MIN_HEAP = 256ull * 1024 * 1024;
+
+  enum class UploadPath : uint8_t { DIRECT, STAGING };
+
+  struct UploadStats {
+    uint64_t count = 0;
+    VkDeviceSize bytes = 0;
+    double seconds = 0.0;
+
+    double mibPerSecond() const {
+      return seconds > 0.0 ? bytes / (1024.0 * 1024.0) / seconds : 0.0;
+    }
+  };
+
+  /**
+   * @brief data를 담은 device local buffer를 만듦
+   * DIRECT_WRITE_PROPERTIES memory가 있고 예산 안이면 mapping해서 바로 쓰고,
+   * 아니면 staging buffer + copyBuffer (usage에 TRANSFER_DST 추가)
+   *
+   * @return 사용한 경로
+   */
+  UploadPath createDeviceLocalBuffer(const void *data, VkDeviceSize size,
+                                     VkBufferUsageFlags usage,
+                                     VkBuffer &buffer, VkDeviceMemory &memory,
+                                     LveMemoryCategory category);
+
+  /**
+   * @brief CPU가 매 frame 쓰는 buffer (uniform 등)용 memory 속성
+   * 가능하면 DIRECT_WRITE_PROPERTIES -> GPU가 PCIe 너머 system memory를 읽지
+   * 않음, 아니면 HOST_VISIBLE | HOST_COHERENT
+   *
+   * @param usage 만들 buffer의 usage (할당될 수 있는 memory type 확인)
+   */
+  VkMemoryPropertyFlags hostWriteMemoryProperties(VkDeviceSize size,
+                                                  VkBufferUsageFlags usage);
+
+  // geometry upload에 direct write를 쓸 수 있는지
+  bool hasDirectUpload() const { return directUploadSupported; }
+  // false면 모든 upload가 staging 경로 (두 경로 비교용), 기본값 true
+  void setDirectUploadEnabled(bool enabled) {
+    directUploadEnabled.store(enabled, std::memory_order_relaxed);
+  }
+
+  // 경로별 누적 upload 수, 크기, 시간 (어느 thread에서나)
+  UploadStats getUploadStats(UploadPath path) const;
+
   /**
    * @brief   텍스처 이미지 데이터를 CPU에서 준비하여 GPU로 복사할 때 사용
    * 이미지를 CPU에서 로드 ->  그 데이터를 Vulkan 버퍼에 저장
@@ -141,16 +229,141 @@ public:
    * @param properties 할당할 메모리의 속성
    * @param image 생성된 이미지 객체
    * @param imageMemory 이미지에 할당된 메모리
+   * @param category 사용량을 집계할 용도
    */
   void createImageWithInfo(const VkImageCreateInfo &imageInfo,
                            VkMemoryPropertyFlags properties, VkImage &image,
-                           VkDeviceMemory &imageMemory);
+                           VkDeviceMemory &imageMemory,
+                           LveMemoryCategory category);
+
+  /**
+   * @brief createImageWithInfo()로 만든 image와 memory를 즉시 파괴
+   */
+  void destroyImage(VkImage image, VkDeviceMemory imageMemory);
+
+  static constexpr size_t MEMORY_CATEGORY_COUNT =
+      static_cast<size_t>(LveMemoryCategory::COUNT);
+  // VK_EXT_memory_budget이 없을 때 heap 크기 중 예산으로 보는 비율
+  static constexpr double FALLBACK_BUDGET_RATIO = 0.8;
+
+  // heap 하나의 사용량과 예산
+  struct MemoryHeapBudget {
+    VkDeviceSize size = 0;
+    // VK_EXT_memory_budget 값, 없으면 size * FALLBACK_BUDGET_RATIO
+    VkDeviceSize budget = 0;
+    // 이 process 전체 사용량 (driver 내부 할당 포함), 없으면 tracked
+    // 마지막으로 읽은 driver 값 + 그 뒤 tracked 변화
+    VkDeviceSize usage = 0;
+    // createBuffer(), createImageWithInfo()로 할당해서 살아 있는 양
+    VkDeviceSize tracked = 0;
+    bool deviceLocal = false;
+  };
+
+  struct MemoryReport {
+    bool budgetExtension = false;
+    std::vector<MemoryHeapBudget> heaps;
+    std::array<VkDeviceSize, MEMORY_CATEGORY_COUNT> categoryBytes{};
+    std::array<uint32_t, MEMORY_CATEGORY_COUNT> categoryAllocations{};
+  };
+
+  /**
+   * @brief heap별 사용량/예산과 용도별 사용량, 어느 thread에서나 호출 가능
+   */
+  MemoryReport memoryReport();
+
+  /**
+   * @brief properties로 size만큼 더 할당해도 그 heap의 예산 안인지 확인
+   * streaming에서 할당이 실패하기 전에 내릴 asset을 정할 때 사용
+   *
+   * @param memoryTypeBits 할당할 resource의 VkMemoryRequirements 값
+   * @return 해당하는 memory type이 없으면 false
+   */
+  bool fitsMemoryBudget(VkDeviceSize size, uint32_t memoryTypeBits,
+                        VkMemoryPropertyFlags properties);
+
+  /**
+   * @brief heap마다 한 줄, 용도별 사용량 한 줄을 log에 씀
+   */
+  void logMemoryReport();
+
+  bool hasMemoryBudget() const { return memoryBudgetSupported; }
+
+  static const char *memoryCategoryName(LveMemoryCategory category);
+
+  // lastUse 기본값, 지금 기록 중인 (아직 submit하지 않은) frame
+  static constexpr uint64_t CURRENT_SUBMISSION =
+      std::numeric_limits<uint64_t>::max();
+
+  /**
+   * @brief graphics queue submit 번호 (GPU timeline) 증가
+   * frame을 submit하기 직전에 호출하고 반환값을 그 frame의 fence와 같이 보관
+   *
+   * @return 이번 submit 번호, 1부터 시작
+   */
+  uint64_t advanceSubmission();
+
+  /**
+   * @brief submission 번호까지 GPU 작업이 끝났음을 알림 (fence 대기 후)
+   * 그 번호 이하로 예약된 object를 파괴
+   */
+  void completeSubmission(uint64_t submission);
+
+  uint64_t submittedSubmission() const {
+    return submitted.load(std::memory_order_acquire);
+  }
+  uint64_t completedSubmission() const {
+    return completed.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief GPU가 lastUse 번호의 submit을 끝낸 뒤에 파괴하도록 예약
+   * 어느 thread에서나 호출 가능 -> 그리는 중에 asset을 내리고 올려도
+   * vkDeviceWaitIdle이 필요 없음
+   *
+   * @param lastUse object를 마지막으로 사용한 submit 번호, 기본값은 기록 중인 frame
+   */
+  void deferDestroyBuffer(VkBuffer buffer, VkDeviceMemory memory,
+                          uint64_t lastUse = CURRENT_SUBMISSION);
+  void deferDestroyImage(VkImage image, VkDeviceMemory memory,
+                         uint64_t lastUse = CURRENT_SUBMISSION);
+  void deferDestroyImageView(VkImageView imageView,
+                             uint64_t lastUse = CURRENT_SUBMISSION);
+  void deferDestroyFramebuffer(VkFramebuffer framebuffer,
+                               uint64_t lastUse = CURRENT_SUBMISSION);
+  void deferDestroyPipeline(VkPipeline pipeline,
+                            uint64_t lastUse = CURRENT_SUBMISSION);
+  void deferDestroySwapchain(VkSwapchainKHR swapChain,
+                             uint64_t lastUse = CURRENT_SUBMISSION);
+  void deferFreeMemory(VkDeviceMemory memory, VkDeviceSize size,
+                       uint64_t lastUse = CURRENT_SUBMISSION);
+
+  /**
+   * @brief 그 외 object용, destroy는 파괴 시점에 호출
+   *
+   * @param bytes 해제될 memory 크기 (통계용)
+   */
+  void deferDestroy(std::function<void()> destroy, VkDeviceSize bytes = 0,
+                    uint64_t lastUse = CURRENT_SUBMISSION);
+
+  /**
+   * @brief 예약된 object를 모두 즉시 파괴, GPU가 idle일 때만 호출
+   */
+  void flushDeferred();
+
+  // 파괴를 기다리는 object 수와 memory 크기
+  size_t deferredCount() const;
+  VkDeviceSize deferredBytes() const;
 
   /**
    * @brief 물리적 장치의 특성 정보를 저장
    */
   VkPhysicalDeviceProperties properties;
 
+  /**
+   * @brief logical device를 만들 때 실제로 켠 기능
+   */
+  VkPhysicalDeviceFeatures enabledFeatures{};
+
 private:
   /**
    * @brief 유효성 검사 레이어 설정, 애플리케이션과 vulkan 연결 instance 생성
@@ -252,6 +465,48 @@ private:
    */
   SwapChainSupportDetails querySwapChainSupport(VkPhysicalDevice device);
 
+  // createBuffer(), createImageWithInfo()로 할당한 memory
+  struct MemoryAllocation {
+    VkDeviceSize size;
+    LveMemoryCategory category;
+    uint32_t heapIndex;
+  };
+
+  void trackAllocation(VkDeviceMemory memory, VkDeviceSize size,
+                       uint32_t memoryTypeIndex, LveMemoryCategory category);
+  void untrackAllocation(VkDeviceMemory memory);
+
+  /**
+   * @brief heap별 예산과 이 process 사용량을 driver에서 다시 읽음
+   * extension이 없으면 heap 크기와 tracked 값 사용
+   * frame마다(completeSubmission), memoryReport()에서만 호출
+   */
+  void refreshMemoryBudget();
+
+  // 마지막 refresh 값 + 그 뒤 tracked 변화, memoryMutex를 잡고 호출
+  VkDeviceSize estimatedHeapUsage(uint32_t heapIndex) const;
+
+  // refreshMemoryBudget()에서 읽은 값으로 heap별 사용량/예산을 채움
+  void cachedHeapBudgets(std::vector<MemoryHeapBudget> &heaps);
+
+  // usage로 만든 buffer가 할당될 수 있는 memory type bit (usage마다 cache)
+  uint32_t bufferMemoryTypeBits(VkBufferUsageFlags usage);
+
+  // 용도마다 lve_device_memory_<용도>_bytes gauge
+  static std::array<LveGauge *, MEMORY_CATEGORY_COUNT> createCategoryMetrics();
+
+  // 파괴를 기다리는 object
+  struct DeferredDestruction {
+    uint64_t lastUse;
+    VkDeviceSize bytes;
+    std::function<void()> destroy;
+  };
+
+  /**
+   * @brief completed 이하로 예약된 object 파괴
+   */
+  void collectDeferred();
+
   // Vulkan 객체들 (인스턴스, 디바이스, 명령 풀 등)
   VkInstance instance;
   VkDebugUtilsMessengerEXT debugMessenger;
@@ -271,6 +526,65 @@ private:
       VK_KHR_SWAPCHAIN_EXTENSION_NAME,
       "VK_KHR_portability_subset",
   };
+
+  // pickPhysicalDevice()에서 한 번 읽음
+  VkPhysicalDeviceMemoryProperties memoryProperties{};
+  bool memoryBudgetSupported = false;
+  PFN_vkGetPhysicalDeviceMemoryProperties2KHR getMemoryProperties2 = nullptr;
+  // DIRECT_WRITE_PROPERTIES memory type이 있음 / 그 heap이 충분히 큼
+  bool directWriteSupported = false;
+  bool directUploadSupported = false;
+  std::atomic<bool> directUploadEnabled{true};
+
+  mutable std::mutex uploadMutex;
+  std::array<UploadStats, 2> uploadStats{};
+
+  // loader thread도 할당하므로 lock
+  mutable std::mutex memoryMutex;
+  std::unordered_map<VkDeviceMemory, MemoryAllocation> allocations;
+  std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> heapTracked{};
+  std::array<bool, VK_MAX_MEMORY_HEAPS> heapOverBudget{};
+  // refreshMemoryBudget()에서 읽은 예산, 사용량과 그때의 heapTracked
+  std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> heapBudget{};
+  std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> heapUsage{};
+  std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> heapTrackedAtRefresh{};
+  std::unordered_map<VkBufferUsageFlags, uint32_t> bufferTypeBits;
+  std::array<VkDeviceSize, MEMORY_CATEGORY_COUNT> categoryBytes{};
+  std::array<uint32_t, MEMORY_CATEGORY_COUNT> categoryAllocations{};
+
+  // submit 번호, advanceSubmission()과 completeSubmission()은 render thread에서
+  std::atomic<uint64_t> submitted{0};
+  std::atomic<uint64_t> completed{0};
+
+  // lastUse 순서로 쌓임 (대부분 현재 번호로 예약하므로)
+  mutable std::mutex deferredMutex;
+  std::deque<DeferredDestruction> deferred;
+  VkDeviceSize deferredBytesTotal = 0;
+
+  // metrics endpoint로 내보내는 값
+  LveGauge &memoryBytesMetric = LveMetrics::gauge(
+      "lve_device_memory_bytes",
+      "Bytes of device memory allocated for buffers and images");
+  LveGauge &memoryAllocationsMetric = LveMetrics::gauge(
+      "lve_device_memory_allocations", "Live device memory allocations");
+  LveGauge &deferredMetric = LveMetrics::gauge(
+      "lve_deferred_destructions", "Objects waiting for deferred destruction");
+  LveGauge &deferredBytesMetric = LveMetrics::gauge(
+      "lve_deferred_destruction_bytes",
+      "Bytes of memory waiting for deferred destruction");
+  std::array<LveGauge *, MEMORY_CATEGORY_COUNT> categoryMetrics =
+      createCategoryMetrics();
+  // 두 값의 증가율 비 -> 경로별 upload 처리량
+  std::array<LveCounter *, 2> uploadBytesMetrics = {
+      &LveMetrics::counter("lve_upload_direct_bytes_total",
+                           "Bytes written straight into device local memory"),
+      &LveMetrics::counter("lve_upload_staging_bytes_total",
+                           "Bytes uploaded through a staging buffer copy")};
+  std::array<LveCounter *, 2> uploadMicrosecondsMetrics = {
+      &LveMetrics::counter("lve_upload_direct_microseconds_total",
+                           "Time spent in direct uploads"),
+      &LveMetrics::counter("lve_upload_staging_microseconds_total",
+                           "Time spent in staging uploads with the copy")};
 };
 
 } // namespace lve
\ No newline at end of file
@@ -0,0 +1,237 @@
+#pragma once
+
+// std
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace lve {
+
+/**
+ * @brief entity handle
+ *
+ * index는 slot 위치, generation은 slot이 재사용될 때마다 증가
+ * -> 삭제된 entity의 handle로 새 entity에 접근하는 것을 막음
+ */
+struct LveEntity {
+  static constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+  uint32_t index = INVALID_INDEX;
+  uint32_t generation = 0;
+
+  bool operator==(const LveEntity &other) const {
+    return index == other.index && generation == other.generation;
+  }
+  bool operator!=(const LveEntity &other) const { return !(*this == other); }
+};
+
+class LveComponentPoolBase {
+public:
+  virtual ~LveComponentPoolBase() = default;
+  virtual bool contains(uint32_t entityIndex) const = 0;
+  virtual void remove(uint32_t entityIndex) = 0;
+};
+
+/**
+ * @brief sparse set 기반 component 저장소
+ *
+ * sparse : entity index -> dense index
+ * dense  : component와 소유 entity를 연속 배열로 저장
+ * 추가/삭제는 O(1), 삭제 시 마지막 원소를 빈 자리로 옮겨 배열을 연속으로 유지
+ */
+template <typename T> class LveComponentPool : public LveComponentPoolBase {
+public:
+  static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+  T &emplace(uint32_t entityIndex, T component) {
+    if (entityIndex >= sparse.size()) {
+      sparse.resize(entityIndex + 1, NONE);
+    }
+    if (sparse[entityIndex] != NONE) {
+      return components[sparse[entityIndex]] = std::move(component);
+    }
+    sparse[entityIndex] = static_cast<uint32_t>(components.size());
+    entities.push_back(entityIndex);
+    components.push_back(std::move(component));
+    return components.back();
+  }
+
+  void remove(uint32_t entityIndex) override {
+    if (!contains(entityIndex)) {
+      return;
+    }
+    const uint32_t denseIndex = sparse[entityIndex];
+    const uint32_t last = entities.back();
+
+    components[denseIndex] = std::move(components.back());
+    entities[denseIndex] = last;
+    sparse[last] = denseIndex;
+
+    components.pop_back();
+    entities.pop_back();
+    sparse[entityIndex] = NONE;
+  }
+
+  bool contains(uint32_t entityIndex) const override {
+    return entityIndex < sparse.size() && sparse[entityIndex] != NONE;
+  }
+
+  T &get(uint32_t entityIndex) {
+    assert(contains(entityIndex) && "Entity does not have this component");
+    return components[sparse[entityIndex]];
+  }
+
+  // component pointer, 없으면 nullptr
+  T *tryGet(uint32_t entityIndex) {
+    return contains(entityIndex) ? &components[sparse[entityIndex]] : nullptr;
+  }
+
+  /**
+   * @brief dense index hint를 먼저 확인하고 아니면 sparse 배열로 찾음
+   * 같은 순서로 추가된 pool끼리는 hint가 맞아서 연속 접근이 됨
+   *
+   * @return component pointer, 없으면 nullptr
+   */
+  T *find(uint32_t entityIndex, size_t denseHint) {
+    if (denseHint < entities.size() && entities[denseHint] == entityIndex) {
+      return &components[denseHint];
+    }
+    return tryGet(entityIndex);
+  }
+
+  size_t size() const { return components.size(); }
+
+  // dense 배열 직접 접근 -> system에서 연속 순회
+  T *data() { return components.data(); }
+  const uint32_t *entityData() const { return entities.data(); }
+
+private:
+  std::vector<uint32_t> sparse;
+  std::vector<uint32_t> entities;
+  std::vector<T> components;
+};
+
+/**
+ * @brief entity 생성/삭제와 component pool 관리
+ *
+ * component 종류마다 LveComponentPool 하나를 가짐
+ */
+class LveRegistry {
+public:
+  LveRegistry() = default;
+
+  LveRegistry(const LveRegistry &) = delete;
+  LveRegistry &operator=(const LveRegistry &) = delete;
+
+  LveEntity create() {
+    LveEntity entity;
+    if (!freeIndices.empty()) {
+      entity.index = freeIndices.back();
+      freeIndices.pop_back();
+    } else {
+      entity.index = static_cast<uint32_t>(generations.size());
+      generations.push_back(0);
+    }
+    entity.generation = generations[entity.index];
+    aliveCount++;
+    return entity;
+  }
+
+  /**
+   * @brief entity와 모든 component 삭제, handle은 무효화됨
+   */
+  void destroy(LveEntity entity) {
+    if (!valid(entity)) {
+      return;
+    }
+    for (auto &pool : pools) {
+      if (pool) {
+        pool->remove(entity.index);
+      }
+    }
+    generations[entity.index]++;
+    freeIndices.push_back(entity.index);
+    aliveCount--;
+  }
+
+  bool valid(LveEntity entity) const {
+    return entity.index < generations.size() &&
+           generations[entity.index] == entity.generation;
+  }
+
+  size_t size() const { return aliveCount; }
+
+  template <typename T> T &add(LveEntity entity, T component = {}) {
+    assert(valid(entity) && "Cannot add component to invalid entity");
+    return pool<T>().emplace(entity.index, std::move(component));
+  }
+
+  template <typename T> void remove(LveEntity entity) {
+    if (valid(entity)) {
+      pool<T>().remove(entity.index);
+    }
+  }
+
+  template <typename T> bool has(LveEntity entity) {
+    return valid(entity) && pool<T>().contains(entity.index);
+  }
+
+  template <typename T> T &get(LveEntity entity) {
+    assert(valid(entity) && "Cannot get component of invalid entity");
+    return pool<T>().get(entity.index);
+  }
+
+  template <typename T> LveComponentPool<T> &pool() {
+    const size_t id = typeId<T>();
+    if (id >= pools.size()) {
+      pools.resize(id + 1);
+    }
+    if (!pools[id]) {
+      pools[id] = std::make_unique<LveComponentPool<T>>();
+    }
+    return *static_cast<LveComponentPool<T> *>(pools[id].get());
+  }
+
+  /**
+   * @brief First component를 가진 entity를 dense 순서로 순회
+   * Others 중 하나라도 없는 entity는 건너뜀
+   *
+   * @param fn fn(LveEntity, First&, Others&...)
+   */
+  template <typename First, typename... Others, typename Fn> void each(Fn fn) {
+    auto &first = pool<First>();
+    [[maybe_unused]] auto others = std::forward_as_tuple(pool<Others>()...);
+    const uint32_t *entities = first.entityData();
+    First *components = first.data();
+
+    for (size_t i = 0; i < first.size(); i++) {
+      const uint32_t index = entities[i];
+      [[maybe_unused]] auto found = std::make_tuple(
+          std::get<LveComponentPool<Others> &>(others).find(index, i)...);
+      if (!((std::get<Others *>(found) != nullptr) && ...)) {
+        continue;
+      }
+      fn(LveEntity{index, generations[index]}, components[i],
+         *std::get<Others *>(found)...);
+    }
+  }
+
+private:
+  template <typename T> static size_t typeId() {
+    static const size_t id = nextTypeId++;
+    return id;
+  }
+
+  static inline size_t nextTypeId = 0;
+
+  std::vector<uint32_t> generations;
+  std::vector<uint32_t> freeIndices;
+  std::vector<std::unique_ptr<LveComponentPoolBase>> pools;
+  size_t aliveCount = 0;
+};
+
+} // namespace lve
@@ -0,0 +1,377 @@
+#include "lve_flight_recorder.hpp"
+
+// std
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+// posix
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace lve {
+
+namespace {
+
+constexpr size_t MAPPING_SIZE =
+    sizeof(LveFlightRecorder::Header) +
+    LveFlightRecorder::CAPACITY * sizeof(LveFlightRecorder::FrameRecord);
+constexpr int CRASH_SIGNALS[] = {SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT};
+// stack overflow에서도 handler가 돌 수 있도록 별도 stack 사용
+constexpr size_t SIGNAL_STACK_SIZE = 64 * 1024;
+
+char dumpFilePath[256] = {};
+std::atomic<bool> deviceLostDumped{false};
+alignas(16) char signalStack[SIGNAL_STACK_SIZE];
+
+/**
+ * @brief signal handler에서 쓸 수 있는 고정 크기 줄 buffer
+ * printf 계열 대신 직접 숫자를 씀 (async-signal-safe)
+ */
+class LineWriter {
+public:
+  explicit LineWriter(const int *fds, int fdCount)
+      : fds{fds}, fdCount{fdCount} {}
+
+  LineWriter &text(const char *value) {
+    while (*value != '\0' && length < sizeof(buffer)) {
+      buffer[length++] = *value++;
+    }
+    return *this;
+  }
+
+  LineWriter &number(int64_t value) {
+    char digits[24];
+    int count = 0;
+    const bool negative = value < 0;
+    uint64_t magnitude = negative ? 0 - static_cast<uint64_t>(value)
+                                  : static_cast<uint64_t>(value);
+    do {
+      digits[count++] = static_cast<char>('0' + magnitude % 10);
+      magnitude /= 10;
+    } while (magnitude != 0);
+    if (negative) {
+      digits[count++] = '-';
+    }
+    while (count > 0 && length < sizeof(buffer)) {
+      buffer[length++] = digits[--count];
+    }
+    return *this;
+  }
+
+  // ns -> "12.345" ms
+  LineWriter &millis(int64_t ns) {
+    if (ns < 0) {
+      text("-");
+      ns = -ns;
+    }
+    const int64_t micros = ns / 1000;
+    number(micros / 1000).text(".");
+    const int64_t fraction = micros % 1000;
+    if (fraction < 100) {
+      text("0");
+    }
+    if (fraction < 10) {
+      text("0");
+    }
+    return number(fraction);
+  }
+
+  // 단계 시각을 frame 시작 기준 ms로, 기록되지 않았으면 "-"
+  LineWriter &stage(int64_t timeNs, int64_t beginNs) {
+    return timeNs == 0 ? text("-") : millis(timeNs - beginNs);
+  }
+
+  void line() {
+    text("\n");
+    for (int i = 0; i < fdCount; i++) {
+      if (fds[i] >= 0) {
+        size_t written = 0;
+        while (written < length) {
+          const ssize_t result =
+              ::write(fds[i], buffer + written, length - written);
+          if (result <= 0) {
+            break;
+          }
+          written += static_cast<size_t>(result);
+        }
+      }
+    }
+    length = 0;
+  }
+
+private:
+  const int *fds;
+  int fdCount;
+  char buffer[512];
+  size_t length = 0;
+};
+
+void writeRecord(LineWriter &out,
+                 const LveFlightRecorder::FrameRecord &record) {
+  const int64_t begin = record.beginNs;
+  out.text("frame ").number(static_cast<int64_t>(record.frame));
+  out.text(" image ").number(record.imageIndex);
+  out.text(" | acquire ").stage(record.acquireNs, begin);
+  out.text(" (fence ").millis(record.frameFenceWaitNs);
+  out.text(" ").text(LveFlightRecorder::resultName(record.fenceResult));
+  out.text(", ").text(LveFlightRecorder::resultName(record.acquireResult));
+  out.text(") record ").stage(record.recordNs, begin);
+  out.text(" submit ").stage(record.submitNs, begin);
+  out.text(" (image fence ").millis(record.imageFenceWaitNs);
+  out.text(" ").text(LveFlightRecorder::resultName(record.submitResult));
+  out.text(") present ").stage(record.presentNs, begin);
+  out.text(" (").text(LveFlightRecorder::resultName(record.presentResult));
+  out.text(") | draws ").number(record.drawCount);
+  out.text(" commands ").number(record.commandCount);
+  out.line();
+}
+
+/**
+ * @brief 오래된 frame부터 출력
+ * fds[0]에는 전부, 나머지 fd에는 최근 tailFrames개만
+ */
+void writeRecords(const LveFlightRecorder::Header &header,
+                  const LveFlightRecorder::FrameRecord *records,
+                  const char *reason, int64_t nowNs, const int *fds,
+                  int fdCount, uint32_t tailFrames) {
+  LineWriter all{fds, fdCount};
+  all.text("=== lve flight recorder: ").text(reason).text(" ===");
+  all.line();
+
+  // beginFrame()의 release store와 짝 -> count 안의 record는 초기화가 끝남
+  const uint64_t count = header.frameCount.load(std::memory_order_acquire);
+  const uint32_t capacity = header.capacity;
+  const uint64_t kept = count < capacity ? count : capacity;
+  all.text("frames ").number(static_cast<int64_t>(count));
+  all.text(", showing last ").number(static_cast<int64_t>(kept));
+  all.text(", times in ms from frame begin");
+  all.line();
+  if (kept > 0 && nowNs != 0) {
+    const auto &last = records[(count - 1) % capacity];
+    all.text("last frame began ").millis(nowNs - last.beginNs);
+    all.text(" ms ago");
+    all.line();
+  }
+
+  LineWriter head{fds, 1};
+  for (uint64_t frame = count - kept; frame < count; frame++) {
+    const bool tail = count - frame <= tailFrames;
+    writeRecord(tail ? all : head, records[frame % capacity]);
+  }
+}
+
+bool validHeader(const LveFlightRecorder::Header &header) {
+  return std::memcmp(header.magic, LveFlightRecorder::MAGIC,
+                     sizeof(header.magic)) == 0 &&
+         header.version == LveFlightRecorder::VERSION &&
+         header.recordSize == sizeof(LveFlightRecorder::FrameRecord) &&
+         header.capacity > 0;
+}
+
+void signalHandler(int signal) {
+  const char *name = "fatal signal";
+  switch (signal) {
+  case SIGSEGV:
+    name = "SIGSEGV";
+    break;
+  case SIGBUS:
+    name = "SIGBUS";
+    break;
+  case SIGFPE:
+    name = "SIGFPE";
+    break;
+  case SIGILL:
+    name = "SIGILL";
+    break;
+  case SIGABRT:
+    name = "SIGABRT";
+    break;
+  }
+  LveFlightRecorder::dump(name);
+  // SA_RESETHAND로 기본 handler가 복구됨 -> 다시 보내서 core dump, 종료
+  raise(signal);
+}
+
+} // namespace
+
+bool LveFlightRecorder::start(const std::string &path,
+                              const std::string &dumpPath) {
+  std::strncpy(dumpFilePath, dumpPath.c_str(), sizeof(dumpFilePath) - 1);
+
+  const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  bool mapped = false;
+  if (fd >= 0 && ::ftruncate(fd, MAPPING_SIZE) == 0) {
+    map(fd);
+    mapped = header != nullptr;
+  }
+  if (fd >= 0) {
+    ::close(fd);
+  }
+  if (!mapped) {
+    map(-1);
+  }
+
+  stack_t stack{};
+  stack.ss_sp = signalStack;
+  stack.ss_size = sizeof(signalStack);
+  sigaltstack(&stack, nullptr);
+
+  struct sigaction action {};
+  action.sa_handler = signalHandler;
+  action.sa_flags = SA_RESETHAND | SA_ONSTACK;
+  sigemptyset(&action.sa_mask);
+  for (int signal : CRASH_SIGNALS) {
+    sigaction(signal, &action, nullptr);
+  }
+  return mapped;
+}
+
+void LveFlightRecorder::map(int fd) {
+  if (header != nullptr) {
+    munmap(header, MAPPING_SIZE);
+    header = nullptr;
+    records = nullptr;
+  }
+
+  void *memory = fd >= 0 ? mmap(nullptr, MAPPING_SIZE, PROT_READ | PROT_WRITE,
+                                MAP_SHARED, fd, 0)
+                         : mmap(nullptr, MAPPING_SIZE, PROT_READ | PROT_WRITE,
+                                MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (memory == MAP_FAILED) {
+    return;
+  }
+  std::memset(memory, 0, MAPPING_SIZE);
+
+  auto *created = new (memory) Header{};
+  std::memcpy(created->magic, MAGIC, sizeof(created->magic));
+  created->version = VERSION;
+  created->capacity = CAPACITY;
+  created->recordSize = sizeof(FrameRecord);
+  created->startUnixNs =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count();
+  created->startSteadyNs = now();
+  records = reinterpret_cast<FrameRecord *>(created + 1);
+  header = created;
+}
+
+int64_t LveFlightRecorder::now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+LveFlightRecorder::FrameRecord *LveFlightRecorder::beginFrame() {
+  if (header == nullptr) {
+    map(-1);
+    if (header == nullptr) {
+      throw std::runtime_error("failed to map flight recorder!");
+    }
+  }
+  // 쓰는 thread는 하나뿐이므로 relaxed로 읽어도 됨
+  const uint64_t frame = header->frameCount.load(std::memory_order_relaxed);
+  FrameRecord *record = &records[frame % CAPACITY];
+  *record = FrameRecord{};
+  record->frame = frame;
+  record->beginNs = now();
+  record->fenceResult = NO_RESULT;
+  record->acquireResult = NO_RESULT;
+  record->submitResult = NO_RESULT;
+  record->presentResult = NO_RESULT;
+  // record를 비운 뒤에 늘려야 읽는 쪽이 이전 frame 값을 보지 않음
+  header->frameCount.store(frame + 1, std::memory_order_release);
+  return record;
+}
+
+bool LveFlightRecorder::checkDeviceLost(VkResult result) {
+  if (result != VK_ERROR_DEVICE_LOST) {
+    return false;
+  }
+  if (!deviceLostDumped.exchange(true)) {
+    dump("VK_ERROR_DEVICE_LOST");
+  }
+  return true;
+}
+
+void LveFlightRecorder::dump(const char *reason) {
+  if (header == nullptr) {
+    return;
+  }
+  int fds[2] = {-1, STDERR_FILENO};
+  if (dumpFilePath[0] != '\0') {
+    fds[0] = ::open(dumpFilePath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  }
+  writeRecords(*header, records, reason, now(), fds, 2, STDERR_FRAMES);
+  if (fds[0] >= 0) {
+    ::close(fds[0]);
+  }
+}
+
+bool LveFlightRecorder::printFile(const std::string &path, int fd) {
+  const int file = ::open(path.c_str(), O_RDONLY);
+  if (file < 0) {
+    return false;
+  }
+  struct stat info {};
+  if (fstat(file, &info) != 0 ||
+      static_cast<size_t>(info.st_size) < sizeof(Header)) {
+    ::close(file);
+    return false;
+  }
+  const size_t size = static_cast<size_t>(info.st_size);
+  void *memory = mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0);
+  ::close(file);
+  if (memory == MAP_FAILED) {
+    return false;
+  }
+
+  // frameCount 외의 header 값은 start() 이후 바뀌지 않음
+  // frameCount는 실행 중인 process가 계속 늘리므로 writeRecords에서 한 번만 읽음
+  const auto *mapped = static_cast<const Header *>(memory);
+  const bool valid =
+      validHeader(*mapped) &&
+      size >= sizeof(Header) + mapped->capacity * sizeof(FrameRecord);
+  if (valid) {
+    const auto *mappedRecords =
+        reinterpret_cast<const FrameRecord *>(mapped + 1);
+    writeRecords(*mapped, mappedRecords, path.c_str(), 0, &fd, 1,
+                 mapped->capacity);
+  }
+  munmap(memory, size);
+  return valid;
+}
+
+const char *LveFlightRecorder::resultName(int32_t result) {
+  switch (result) {
+  case NO_RESULT:
+    return "-";
+  case VK_SUCCESS:
+    return "VK_SUCCESS";
+  case VK_NOT_READY:
+    return "VK_NOT_READY";
+  case VK_TIMEOUT:
+    return "VK_TIMEOUT";
+  case VK_SUBOPTIMAL_KHR:
+    return "VK_SUBOPTIMAL_KHR";
+  case VK_ERROR_OUT_OF_HOST_MEMORY:
+    return "VK_ERROR_OUT_OF_HOST_MEMORY";
+  case VK_ERROR_OUT_OF_DEVICE_MEMORY:
+    return "VK_ERROR_OUT_OF_DEVICE_MEMORY";
+  case VK_ERROR_DEVICE_LOST:
+    return "VK_ERROR_DEVICE_LOST";
+  case VK_ERROR_SURFACE_LOST_KHR:
+    return "VK_ERROR_SURFACE_LOST_KHR";
+  case VK_ERROR_OUT_OF_DATE_KHR:
+    return "VK_ERROR_OUT_OF_DATE_KHR";
+  }
+  return "VK_ERROR";
+}
+
+} // namespace lve
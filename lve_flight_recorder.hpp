@@ -0,0 +1,116 @@
+#pragma once
+
+// libs
+#include <vulkan/vulkan.h>
+
+// std
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace lve {
+
+/**
+ * @brief 최근 frame의 진행 기록을 남기는 flight recorder (항상 켜져 있음)
+ *
+ * frame마다 고정 크기 record 하나를 mmap한 ring에 단계별로 직접 씀
+ * (system call, lock, 할당 없음)
+ * 파일에 mapping하면 process가 멈추거나 강제 종료되어도 파일에 남고,
+ * 실행 중에도 다른 process(benchmarks/flight_dump)가 읽을 수 있음
+ * 치명적인 signal이나 VK_ERROR_DEVICE_LOST에서는 text로 dump
+ * render thread 전용 (swap chain과 renderer가 기록)
+ */
+class LveFlightRecorder {
+public:
+  static constexpr char MAGIC[4] = {'L', 'V', 'E', 'F'};
+  static constexpr uint32_t VERSION = 1;
+  // 보관하는 frame 수
+  static constexpr uint32_t CAPACITY = 256;
+  // dump할 때 stderr에 출력하는 최근 frame 수 (파일에는 전부)
+  static constexpr uint32_t STDERR_FRAMES = 8;
+  // 아직 호출하지 않은 Vulkan 함수의 result 자리
+  static constexpr int32_t NO_RESULT = VK_RESULT_MAX_ENUM;
+
+  struct Header {
+    char magic[4];
+    uint32_t version;
+    uint32_t capacity;
+    uint32_t recordSize;
+    int64_t startUnixNs;   // 시작 시각 (system_clock)
+    int64_t startSteadyNs; // 같은 시각의 now()
+    // 기록을 시작한 frame 수, 다른 process도 읽으므로 release store로 갱신
+    std::atomic<uint64_t> frameCount;
+  };
+  // process 사이 공유 memory에서 쓰려면 lock-free여야 하고 파일 형식은 그대로
+  static_assert(std::atomic<uint64_t>::is_always_lock_free &&
+                    sizeof(std::atomic<uint64_t>) == sizeof(uint64_t),
+                "flight recorder frame count must be a lock-free uint64_t");
+
+  // 시각은 now() 값, 0이면 그 단계까지 가지 못함
+  struct FrameRecord {
+    uint64_t frame;
+    int64_t beginNs;   // beginFrame() 진입
+    int64_t acquireNs; // frame fence 대기 + image acquire 끝
+    int64_t recordNs;  // command 기록 끝 (endFrame() 진입)
+    int64_t submitNs;  // vkQueueSubmit 끝
+    int64_t presentNs; // vkQueuePresentKHR 끝
+    int64_t frameFenceWaitNs;
+    int64_t imageFenceWaitNs;
+    int32_t fenceResult;
+    int32_t acquireResult;
+    int32_t submitResult;
+    int32_t presentResult;
+    uint32_t imageIndex;
+    uint32_t drawCount;
+    uint32_t commandCount;
+    uint32_t reserved;
+  };
+
+  /**
+   * @brief ring을 path 파일에 mapping하고 crash handler 설치
+   * 호출하지 않으면 첫 frame에서 memory에만 mapping (signal dump 없음)
+   *
+   * @param dumpPath signal, device lost일 때 text dump를 쓸 파일
+   * @return 파일을 mapping하지 못하면 false (memory mapping으로 계속 기록)
+   */
+  static bool start(const std::string &path, const std::string &dumpPath);
+
+  // steady_clock ns
+  static int64_t now();
+
+  /**
+   * @brief 다음 frame record를 비우고 시작 시각 기록
+   * @return frame이 끝날 때까지 단계별 값을 채울 record
+   */
+  static FrameRecord *beginFrame();
+
+  /**
+   * @brief result가 VK_ERROR_DEVICE_LOST면 처음 한 번만 dump
+   * @return device lost 여부
+   */
+  static bool checkDeviceLost(VkResult result);
+
+  /**
+   * @brief 최근 frame을 stderr와 dump 파일에 text로 씀
+   * async-signal-safe (signal handler에서 호출)
+   */
+  static void dump(const char *reason);
+
+  /**
+   * @brief start()로 만든 ring 파일을 읽어서 fd에 text로 출력
+   * 실행 중인 process의 파일도 읽을 수 있음 (멈춘 renderer 확인)
+   *
+   * @return 파일이 없거나 형식이 다르면 false
+   */
+  static bool printFile(const std::string &path, int fd);
+
+  static const char *resultName(int32_t result);
+
+private:
+  static void map(int fd);
+
+  static inline Header *header = nullptr;
+  static inline FrameRecord *records = nullptr;
+};
+
+} // namespace lve
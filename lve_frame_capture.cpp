@@ -0,0 +1,264 @@
+#include "lve_frame_capture.hpp"
+
+// std
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace lve {
+
+namespace {
+
+template <typename T> void writeValue(std::ofstream &file, const T &value) {
+  file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T> void writeArray(std::ofstream &file, const T *values,
+                                      uint32_t count) {
+  writeValue(file, count);
+  file.write(reinterpret_cast<const char *>(values), sizeof(T) * count);
+}
+
+void writeString(std::ofstream &file, const std::string &value) {
+  writeArray(file, value.data(), static_cast<uint32_t>(value.size()));
+}
+
+template <typename T> void readValue(std::ifstream &file, T &value) {
+  file.read(reinterpret_cast<char *>(&value), sizeof(T));
+}
+
+// 잘못된 파일에서 큰 count를 읽어도 할당하지 않도록 최대 개수 제한
+constexpr uint32_t MAX_ELEMENTS = 1u << 28;
+
+template <typename T>
+void readArray(std::ifstream &file, std::vector<T> &values) {
+  uint32_t count = 0;
+  readValue(file, count);
+  if (!file || count > MAX_ELEMENTS) {
+    file.setstate(std::ios::failbit);
+    return;
+  }
+  values.resize(count);
+  file.read(reinterpret_cast<char *>(values.data()), sizeof(T) * count);
+}
+
+void readString(std::ifstream &file, std::string &value) {
+  std::vector<char> chars;
+  readArray(file, chars);
+  value.assign(chars.begin(), chars.end());
+}
+
+} // namespace
+
+void LveFrameCapture::add(Op op, uint32_t a, uint32_t b, uint32_t c) {
+  commands.push_back({op, {a, b, c}});
+}
+
+void LveFrameCapture::beginRenderPass(VkExtent2D renderExtent) {
+  inRenderPass = true;
+  extent = renderExtent;
+  boundBuffer = UINT32_MAX;
+  add(Op::BEGIN_RENDER_PASS, extent.width, extent.height);
+}
+
+void LveFrameCapture::endRenderPass() {
+  if (!inRenderPass) {
+    return;
+  }
+  inRenderPass = false;
+  add(Op::END_RENDER_PASS);
+}
+
+void LveFrameCapture::bindPipeline(const LvePipeline &pipeline) {
+  if (!inRenderPass) {
+    return;
+  }
+  auto it = std::find(capturedPipelines.begin(), capturedPipelines.end(),
+                      &pipeline);
+  if (it == capturedPipelines.end()) {
+    capturedPipelines.push_back(&pipeline);
+    pipelines.push_back(
+        {pipeline.getVertFilepath(), pipeline.getFragFilepath()});
+    it = std::prev(capturedPipelines.end());
+  }
+  add(Op::BIND_PIPELINE,
+      static_cast<uint32_t>(it - capturedPipelines.begin()));
+}
+
+void LveFrameCapture::bindGlobalSet() {
+  if (inRenderPass) {
+    add(Op::BIND_GLOBAL_SET);
+  }
+}
+
+void LveFrameCapture::pushConstants(VkShaderStageFlags stages, uint32_t size,
+                                    const void *data) {
+  if (!inRenderPass) {
+    return;
+  }
+  const auto offset = static_cast<uint32_t>(pushData.size());
+  const auto *bytes = static_cast<const uint8_t *>(data);
+  pushData.insert(pushData.end(), bytes, bytes + size);
+  pushStages |= stages;
+  pushSize = std::max(pushSize, size);
+  add(Op::PUSH_CONSTANTS, offset, size, stages);
+}
+
+void LveFrameCapture::drawModel(LveModel &model) {
+  if (!inRenderPass) {
+    return;
+  }
+  auto it = std::find(capturedModels.begin(), capturedModels.end(), &model);
+  if (it == capturedModels.end()) {
+    capturedModels.push_back(&model);
+    it = std::prev(capturedModels.end());
+  }
+  const auto buffer = static_cast<uint32_t>(it - capturedModels.begin());
+  if (buffer != boundBuffer) {
+    add(Op::BIND_BUFFERS, buffer);
+    boundBuffer = buffer;
+  }
+  if (model.getIndexCount() > 0) {
+    add(Op::DRAW_INDEXED, model.getIndexCount());
+  } else {
+    add(Op::DRAW, model.getVertexCount());
+  }
+}
+
+bool LveFrameCapture::save(const std::string &path) {
+  assert(!inRenderPass && "Can't save frame capture while render pass is open");
+  // 이미 읽은 buffer는 다시 읽지 않음
+  for (size_t i = buffers.size(); i < capturedModels.size(); i++) {
+    buffers.push_back(capturedModels[i]->readBack());
+  }
+
+  std::ofstream file{path, std::ios::binary};
+  if (!file) {
+    return false;
+  }
+  file.write(MAGIC, sizeof(MAGIC));
+  writeValue(file, VERSION);
+  writeValue(file, extent);
+  writeValue(file, pushStages);
+  writeValue(file, pushSize);
+
+  writeValue(file, static_cast<uint32_t>(pipelines.size()));
+  for (const auto &pipeline : pipelines) {
+    writeString(file, pipeline.vertFilepath);
+    writeString(file, pipeline.fragFilepath);
+  }
+  writeValue(file, static_cast<uint32_t>(buffers.size()));
+  for (const auto &buffer : buffers) {
+    writeArray(file, buffer.vertices.data(),
+               static_cast<uint32_t>(buffer.vertices.size()));
+    writeArray(file, buffer.indices.data(),
+               static_cast<uint32_t>(buffer.indices.size()));
+  }
+  writeArray(file, pushData.data(), static_cast<uint32_t>(pushData.size()));
+  writeArray(file, commands.data(), static_cast<uint32_t>(commands.size()));
+  return static_cast<bool>(file);
+}
+
+LveFrameCapture LveFrameCapture::load(const std::string &path) {
+  std::ifstream file{path, std::ios::binary};
+  if (!file) {
+    throw std::runtime_error("failed to open frame capture: " + path);
+  }
+
+  char magic[sizeof(MAGIC)];
+  uint32_t version = 0;
+  file.read(magic, sizeof(magic));
+  readValue(file, version);
+  if (!file || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      version != VERSION) {
+    throw std::runtime_error("invalid frame capture: " + path);
+  }
+
+  LveFrameCapture capture{};
+  readValue(file, capture.extent);
+  readValue(file, capture.pushStages);
+  readValue(file, capture.pushSize);
+
+  uint32_t pipelineCount = 0;
+  readValue(file, pipelineCount);
+  for (uint32_t i = 0; file && i < pipelineCount; i++) {
+    Pipeline pipeline{};
+    readString(file, pipeline.vertFilepath);
+    readString(file, pipeline.fragFilepath);
+    capture.pipelines.push_back(std::move(pipeline));
+  }
+  uint32_t bufferCount = 0;
+  readValue(file, bufferCount);
+  for (uint32_t i = 0; file && i < bufferCount; i++) {
+    LveModel::Builder buffer{};
+    readArray(file, buffer.vertices);
+    readArray(file, buffer.indices);
+    capture.buffers.push_back(std::move(buffer));
+  }
+  readArray(file, capture.pushData);
+  readArray(file, capture.commands);
+  if (!file) {
+    throw std::runtime_error("truncated frame capture: " + path);
+  }
+
+  // replay에서 범위 밖 index, buffer 범위 밖 vertex로 접근하지 않도록 미리 확인
+  for (const auto &buffer : capture.buffers) {
+    // LveModel은 triangle 하나 이상의 vertex가 필요
+    if (buffer.vertices.size() < 3) {
+      throw std::runtime_error("invalid frame capture buffer: " + path);
+    }
+    for (uint32_t index : buffer.indices) {
+      if (index >= buffer.vertices.size()) {
+        throw std::runtime_error("invalid frame capture buffer: " + path);
+      }
+    }
+  }
+  bool pipelineBound = false;
+  const LveModel::Builder *bound = nullptr;
+  for (const auto &command : capture.commands) {
+    const uint32_t *args = command.args;
+    bool valid = true;
+    switch (command.op) {
+    case Op::BEGIN_RENDER_PASS:
+      pipelineBound = false;
+      bound = nullptr;
+      break;
+    case Op::END_RENDER_PASS:
+    case Op::BIND_GLOBAL_SET:
+      break;
+    case Op::BIND_PIPELINE:
+      valid = args[0] < capture.pipelines.size();
+      pipelineBound = true;
+      break;
+    case Op::PUSH_CONSTANTS:
+      valid = static_cast<uint64_t>(args[0]) + args[1] <=
+                  capture.pushData.size() &&
+              args[1] <= capture.pushSize;
+      break;
+    case Op::BIND_BUFFERS:
+      valid = args[0] < capture.buffers.size();
+      bound = valid ? &capture.buffers[args[0]] : nullptr;
+      break;
+    case Op::DRAW:
+      valid = pipelineBound && bound != nullptr &&
+              args[0] <= bound->vertices.size();
+      break;
+    case Op::DRAW_INDEXED:
+      valid = pipelineBound && bound != nullptr &&
+              args[0] <= bound->indices.size();
+      break;
+    default:
+      valid = false;
+      break;
+    }
+    if (!valid) {
+      throw std::runtime_error("invalid frame capture command: " + path);
+    }
+  }
+  return capture;
+}
+
+} // namespace lve
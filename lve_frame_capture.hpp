@@ -0,0 +1,112 @@
+#pragma once
+
+#include "lve_model.hpp"
+#include "lve_pipeline.hpp"
+
+// std
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lve {
+
+/**
+ * @brief 한 frame의 swap chain pass command stream을 기록/저장
+ *
+ * LveRenderer::setFrameCapture()와 FrameInfo::capture로 넘기면 renderer가
+ * render pass 시작/끝을, SimpleRenderSystem이 bind, push constant, draw를 기록
+ * render pass 밖의 command(overdraw pass 등)는 기록하지 않음
+ *
+ * pipeline은 shader 경로, buffer는 model의 vertex/index 내용으로 저장하고 command는
+ * table index로 참조 -> benchmarks/frame_replay가 scene 없이 같은 frame을 다시 그림
+ * global descriptor set(late latch)은 replay에서 identity correction으로 bind
+ */
+class LveFrameCapture {
+public:
+  static constexpr char MAGIC[4] = {'L', 'V', 'E', 'C'};
+  static constexpr uint32_t VERSION = 1;
+
+  enum class Op : uint32_t {
+    BEGIN_RENDER_PASS, // args: width, height
+    END_RENDER_PASS,
+    BIND_PIPELINE,   // args: pipeline index
+    BIND_GLOBAL_SET, // set 0
+    PUSH_CONSTANTS,  // args: pushData offset, size, stage flags
+    BIND_BUFFERS,    // args: buffer index
+    DRAW,            // args: vertex count
+    DRAW_INDEXED,    // args: index count
+  };
+
+  // 고정 크기 (16 byte)
+  struct Command {
+    Op op;
+    uint32_t args[3];
+  };
+
+  struct Pipeline {
+    std::string vertFilepath;
+    std::string fragFilepath;
+  };
+
+  // --- 기록, capture하는 frame에서 renderer와 render system이 호출 ---
+
+  void beginRenderPass(VkExtent2D extent);
+  void endRenderPass();
+  void bindPipeline(const LvePipeline &pipeline);
+  void bindGlobalSet();
+  void pushConstants(VkShaderStageFlags stages, uint32_t size,
+                     const void *data);
+
+  /**
+   * @brief model의 buffer bind (바뀐 경우만)와 draw 기록
+   */
+  void drawModel(LveModel &model);
+
+  /**
+   * @brief 기록한 model의 buffer 내용을 읽어서 파일로 저장
+   * queue를 기다리므로 capture한 frame을 submit한 뒤에 호출
+   * 기록한 model은 그때까지 살아 있어야 함
+   *
+   * @return 파일을 쓰지 못하면 false
+   */
+  bool save(const std::string &path);
+
+  /**
+   * @brief 파일이 없거나 형식이 다르면 std::runtime_error
+   */
+  static LveFrameCapture load(const std::string &path);
+
+  const std::vector<Command> &getCommands() const { return commands; }
+  const std::vector<Pipeline> &getPipelines() const { return pipelines; }
+  // model 하나의 vertex/index buffer 내용
+  const std::vector<LveModel::Builder> &getBuffers() const { return buffers; }
+  const uint8_t *getPushData(uint32_t offset) const {
+    return pushData.data() + offset;
+  }
+
+  // replay pipeline layout용, 모든 push constant의 stage 합과 최대 크기
+  VkShaderStageFlags getPushConstantStages() const { return pushStages; }
+  uint32_t getPushConstantSize() const { return pushSize; }
+
+  // 마지막 render pass의 크기
+  VkExtent2D getExtent() const { return extent; }
+
+private:
+  void add(Op op, uint32_t a = 0, uint32_t b = 0, uint32_t c = 0);
+
+  std::vector<Command> commands;
+  std::vector<Pipeline> pipelines;
+  std::vector<LveModel::Builder> buffers;
+  std::vector<uint8_t> pushData;
+  VkShaderStageFlags pushStages = 0;
+  uint32_t pushSize = 0;
+  VkExtent2D extent{};
+
+  // 기록 중 상태
+  bool inRenderPass = false;
+  std::vector<const LvePipeline *> capturedPipelines;
+  std::vector<LveModel *> capturedModels; // buffers와 같은 순서
+  uint32_t boundBuffer = UINT32_MAX;
+};
+
+} // namespace lve
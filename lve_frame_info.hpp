@@ -0,0 +1,41 @@
+#pragma once
+
+#include "lve_bvh.hpp"
+#include "lve_camera.hpp"
+#include "lve_ecs.hpp"
+#include "lve_frame_capture.hpp"
+#include "lve_gpu_profiler.hpp"
+#include "lve_scene_graph.hpp"
+
+// lib
+#include <vulkan/vulkan.h>
+
+namespace lve {
+
+// BVH에 등록된 entity -> culling을 거쳐서만 그려짐
+struct BvhProxyComponent {
+  LveBvh::proxy_t proxy = LveBvh::NULL_NODE;
+};
+
+/**
+ * @brief 한 frame을 그리는 데 필요한 정보 묶음
+ * render system 인자가 늘어나지 않도록 여기에 추가
+ */
+struct FrameInfo {
+  int frameIndex;
+  float frameTime;
+  VkCommandBuffer commandBuffer;
+  LveCamera &camera;
+  // set 0, late latch camera correction
+  VkDescriptorSet globalDescriptorSet;
+  LveRegistry &registry;
+  const LveSceneGraph &sceneGraph;
+  // nullptr이면 culling 없이 모두 그림
+  const LveBvh *bvh = nullptr;
+  // nullptr이면 GPU 구간을 기록하지 않음
+  LveGpuProfiler *gpuProfiler = nullptr;
+  // nullptr이 아니면 render system이 command를 기록 (frame capture)
+  LveFrameCapture *capture = nullptr;
+};
+
+} // namespace lve
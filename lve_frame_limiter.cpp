@@ -0,0 +1,214 @@
+#include "lve_frame_limiter.hpp"
+
+// std
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+namespace lve {
+
+namespace {
+
+// sleep 한 번의 길이, 짧을수록 마지막 spin 구간이 짧아짐
+constexpr std::chrono::microseconds SLEEP_QUANTUM{1000};
+// sleep 오차 이동 평균의 가중치
+constexpr double SLEEP_SMOOTHING = 0.05;
+
+// spin 중 CPU에 대기 중임을 알림 -> 전력 소모와 hyper-thread 간섭 감소
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  asm volatile("yield");
+#endif
+}
+
+double toMs(LveFrameLimiter::Clock::duration duration) {
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+// p (0..1) 위치의 값, values의 순서는 바뀜
+double percentile(std::vector<double> &values, double p) {
+  if (values.empty()) {
+    return 0.0;
+  }
+  const size_t index =
+      std::min(values.size() - 1,
+               static_cast<size_t>(p * static_cast<double>(values.size())));
+  std::nth_element(values.begin(), values.begin() + index, values.end());
+  return values[index];
+}
+
+} // namespace
+
+LveFrameLimiter::LveFrameLimiter(double frameRate)
+    : sleepMeanMs{toMs(SLEEP_QUANTUM)} {
+  history.reserve(HISTORY_SIZE);
+  setFrameRate(frameRate);
+}
+
+void LveFrameLimiter::setFrameRate(double rate) {
+  assert(rate >= 0.0 && "Frame rate must not be negative");
+  frameRate = rate;
+  targetDuration =
+      rate > 0.0 ? std::chrono::duration_cast<Clock::duration>(
+                       std::chrono::duration<double>(1.0 / rate))
+                 : Clock::duration{0};
+  // 새 목표 기준으로 다시 시작
+  started = false;
+}
+
+void LveFrameLimiter::wait() {
+  Clock::time_point now = Clock::now();
+  if (!started) {
+    started = true;
+    lastFrame = now;
+    nextDeadline = now + targetDuration;
+    return;
+  }
+
+  if (targetDuration > Clock::duration{0}) {
+    if (now > nextDeadline + targetDuration) {
+      // 한 frame 넘게 늦음 -> 따라잡으려고 연속으로 그리지 않음
+      nextDeadline = now;
+    } else if (now < nextDeadline) {
+      sleepUntil(nextDeadline);
+    }
+  }
+
+  const Clock::time_point frameStart = Clock::now();
+  recordFrame(toMs(frameStart - lastFrame));
+  lastFrame = frameStart;
+  // 조금 늦은 frame은 다음 frame을 짧게 해서 평균 frame rate 유지
+  nextDeadline = targetDuration > Clock::duration{0}
+                     ? nextDeadline + targetDuration
+                     : frameStart;
+}
+
+void LveFrameLimiter::sleepUntil(Clock::time_point deadline) {
+  Clock::time_point now = Clock::now();
+
+  // OS가 늦게 깨워도 deadline을 넘지 않을 만큼 남아 있을 때만 sleep
+  while (true) {
+    const double spinThresholdMs = sleepMeanMs + std::sqrt(sleepVarianceMs);
+    if (toMs(deadline - now) <= spinThresholdMs) {
+      break;
+    }
+
+    const Clock::time_point sleepStart = now;
+    std::this_thread::sleep_for(SLEEP_QUANTUM);
+    now = Clock::now();
+
+    const double observedMs = toMs(now - sleepStart);
+    sleepMsSum += observedMs;
+    const double delta = observedMs - sleepMeanMs;
+    sleepMeanMs += SLEEP_SMOOTHING * delta;
+    sleepVarianceMs = (1.0 - SLEEP_SMOOTHING) *
+                      (sleepVarianceMs + SLEEP_SMOOTHING * delta * delta);
+
+    if (waitCallback) {
+      waitCallback();
+      now = Clock::now();
+    }
+  }
+
+  const Clock::time_point spinStart = Clock::now();
+  while (Clock::now() < deadline) {
+    cpuRelax();
+  }
+  spinMsSum += toMs(Clock::now() - spinStart);
+}
+
+void LveFrameLimiter::recordFrame(double frameMs) {
+  frames++;
+  averageFrameMs =
+      frames == 1 ? frameMs : averageFrameMs * 0.95 + frameMs * 0.05;
+
+  if (history.size() < HISTORY_SIZE) {
+    history.push_back(frameMs);
+  } else {
+    history[historyNext] = frameMs;
+  }
+  historyNext = (historyNext + 1) % HISTORY_SIZE;
+
+  const double targetMs =
+      frameRate > 0.0 ? 1000.0 / frameRate : averageFrameMs;
+  const double bin = std::round((frameMs - targetMs) / HISTOGRAM_BIN_MS) +
+                     static_cast<double>(HISTOGRAM_BINS / 2);
+  histogram[static_cast<size_t>(
+      std::clamp(bin, 0.0, static_cast<double>(HISTOGRAM_BINS - 1)))]++;
+}
+
+LveFrameLimiter::Stats LveFrameLimiter::getStats() const {
+  Stats stats{};
+  stats.frames = frames;
+  stats.targetMs = frameRate > 0.0 ? 1000.0 / frameRate : 0.0;
+  stats.sleepMs = sleepMsSum;
+  stats.spinMs = spinMsSum;
+  stats.spinThresholdMs = sleepMeanMs + std::sqrt(sleepVarianceMs);
+  stats.histogram = histogram;
+
+  std::vector<double> values = history;
+  stats.frameP50Ms = percentile(values, 0.50);
+  stats.frameP95Ms = percentile(values, 0.95);
+  stats.frameP99Ms = percentile(values, 0.99);
+
+  double referenceMs = stats.targetMs;
+  if (referenceMs == 0.0 && !history.empty()) {
+    for (double frameMs : history) {
+      referenceMs += frameMs;
+    }
+    referenceMs /= static_cast<double>(history.size());
+  }
+  for (size_t i = 0; i < history.size(); i++) {
+    values[i] = std::abs(history[i] - referenceMs);
+  }
+  stats.errorP50Ms = percentile(values, 0.50);
+  stats.errorP95Ms = percentile(values, 0.95);
+  stats.errorP99Ms = percentile(values, 0.99);
+  return stats;
+}
+
+void LveFrameLimiter::resetStats() {
+  frames = 0;
+  sleepMsSum = 0.0;
+  spinMsSum = 0.0;
+  history.clear();
+  historyNext = 0;
+  histogram.fill(0);
+}
+
+void LveFrameLimiter::printHistogram(const Stats &stats, std::ostream &out) {
+  size_t first = HISTOGRAM_BINS;
+  size_t last = 0;
+  uint32_t peak = 0;
+  for (size_t i = 0; i < HISTOGRAM_BINS; i++) {
+    if (stats.histogram[i] > 0) {
+      first = std::min(first, i);
+      last = i;
+      peak = std::max(peak, stats.histogram[i]);
+    }
+  }
+  if (peak == 0) {
+    return;
+  }
+
+  constexpr size_t BAR_WIDTH = 40;
+  const int center = static_cast<int>(HISTOGRAM_BINS / 2);
+  for (size_t i = first; i <= last; i++) {
+    const uint32_t count = stats.histogram[i];
+    // 양 끝 bin은 범위 밖 값 전부
+    const char *prefix = i == 0 ? "<=" : i == HISTOGRAM_BINS - 1 ? ">=" : "  ";
+    const double errorMs = (static_cast<int>(i) - center) * HISTOGRAM_BIN_MS;
+    char label[32];
+    std::snprintf(label, sizeof(label), "%s%+6.2f ms", prefix, errorMs);
+    out << label << " | " << std::string(count * BAR_WIDTH / peak, '#') << " "
+        << count << '\n';
+  }
+  out.flush();
+}
+
+} // namespace lve
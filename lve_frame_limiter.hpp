@@ -0,0 +1,108 @@
+#pragma once
+
+// std
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <vector>
+
+namespace lve {
+
+/**
+ * @brief 목표 frame time에 맞춰 render loop를 쉬게 하는 limiter
+ *
+ * 대부분의 시간은 짧게 나눈 sleep으로 보내고(CPU 사용 없음), OS가 늦게 깨울 수
+ * 있는 마지막 구간만 spin으로 기다림 -> 관측한 sleep 오차의 평균 + 표준편차를
+ * spin 구간으로 사용하므로 환경에 따라 자동으로 보정됨
+ * IMMEDIATE/MAILBOX처럼 present가 막지 않는 mode에서 CPU 낭비를 막음
+ */
+class LveFrameLimiter {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  // percentile 계산에 사용하는 최근 frame 수
+  static constexpr size_t HISTORY_SIZE = 1024;
+  // frame time 오차 histogram, 가운데 bin이 오차 0, 양 끝 bin은 범위 밖 전부
+  static constexpr size_t HISTOGRAM_BINS = 33;
+  static constexpr double HISTOGRAM_BIN_MS = 0.25;
+
+  struct Stats {
+    uint64_t frames = 0;
+    double targetMs = 0.0;
+    // 최근 HISTORY_SIZE frame의 frame time (frame 시작 간격)
+    double frameP50Ms = 0.0;
+    double frameP95Ms = 0.0;
+    double frameP99Ms = 0.0;
+    // |frame time - 목표| (목표가 없으면 평균과의 차이) -> jitter
+    double errorP50Ms = 0.0;
+    double errorP95Ms = 0.0;
+    double errorP99Ms = 0.0;
+    // 누적 대기 시간, spin이 CPU를 쓰는 부분
+    double sleepMs = 0.0;
+    double spinMs = 0.0;
+    // 현재 spin으로 넘기는 구간 (보정값)
+    double spinThresholdMs = 0.0;
+    // 목표 대비 오차 (frame time - 목표)
+    std::array<uint32_t, HISTOGRAM_BINS> histogram{};
+  };
+
+  /**
+   * @param frameRate 목표 초당 frame 수, 0이면 기다리지 않고 측정만 함
+   */
+  explicit LveFrameLimiter(double frameRate = 0.0);
+
+  void setFrameRate(double frameRate);
+  double getFrameRate() const { return frameRate; }
+
+  /**
+   * @brief 다음 frame 시작 시각까지 대기, render loop에서 frame마다 한 번 호출
+   * 한 frame 넘게 늦어지면 밀린 frame을 따라잡지 않고 지금부터 다시 맞춤
+   */
+  void wait();
+
+  /**
+   * @brief 다음 wait()부터 새로 시작, 그 사이 시간은 frame time으로 기록하지 않음
+   * on-demand redraw처럼 render loop가 한동안 멈췄다가 다시 돌 때 호출
+   */
+  void restart() { started = false; }
+
+  // 최근 frame 기준으로 percentile 계산
+  Stats getStats() const;
+  void resetStats();
+
+  /**
+   * @brief 오차 histogram을 한 bin에 한 줄씩 출력
+   * 처음과 마지막으로 값이 있는 bin 사이만 출력
+   */
+  static void printHistogram(const Stats &stats, std::ostream &out);
+
+  // sleep 사이마다 호출 (입력 처리 등), 비어 있으면 그냥 sleep
+  std::function<void()> waitCallback;
+
+private:
+  void sleepUntil(Clock::time_point deadline);
+  void recordFrame(double frameMs);
+
+  double frameRate = 0.0;
+  Clock::duration targetDuration{0};
+
+  bool started = false;
+  Clock::time_point lastFrame{};
+  Clock::time_point nextDeadline{};
+
+  // sleep 한 번의 실제 시간, 지수 이동 평균/분산
+  double sleepMeanMs;
+  double sleepVarianceMs = 0.0;
+
+  uint64_t frames = 0;
+  double averageFrameMs = 0.0;
+  double sleepMsSum = 0.0;
+  double spinMsSum = 0.0;
+  std::vector<double> history;
+  size_t historyNext = 0;
+  std::array<uint32_t, HISTOGRAM_BINS> histogram{};
+};
+
+} // namespace lve
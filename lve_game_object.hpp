@@ -47,6 +47,16 @@ struct TransformComponent {
   }
 };
 
+// LveRegistry에 저장하는 render용 component
+// model은 FirstApp이 소유, component는 소유하지 않는 pointer만 보관
+struct ModelComponent {
+  LveModel *model = nullptr;
+};
+
+struct ColorComponent {
+  glm::vec3 color{};
+};
+
 /**
  * @brief game objects 저장하는 벡터
  */
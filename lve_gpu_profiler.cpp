@@ -0,0 +1,266 @@
+#include "lve_gpu_profiler.hpp"
+#include "lve_vulkan_dispatch.hpp"
+
+// std
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+
+namespace lve {
+
+namespace {
+
+// beginFrame() ~ endFrame() 전체 구간 이름
+constexpr const char *FRAME_SCOPE = "frame";
+
+} // namespace
+
+LveGpuProfiler::LveGpuProfiler(LveDevice &device, uint32_t frameCount)
+    : lveDevice{device}, frames(frameCount) {
+  const uint32_t validBits = lveDevice.getTimestampValidBits();
+  supported = validBits > 0;
+  if (!supported) {
+    return;
+  }
+  timestampPeriodNs = lveDevice.properties.limits.timestampPeriod;
+  timestampMask =
+      validBits >= 64 ? ~uint64_t{0} : (uint64_t{1} << validBits) - 1;
+
+  VkQueryPoolCreateInfo queryPoolInfo{};
+  queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+  queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+  // 구간마다 시작, 끝 2개
+  queryPoolInfo.queryCount = MAX_SCOPES * 2;
+
+  for (auto &frame : frames) {
+    if (vkCreateQueryPool(lveDevice.device(), &queryPoolInfo, nullptr,
+                          &frame.queryPool) != VK_SUCCESS) {
+      throw std::runtime_error("failed to create timestamp query pool!");
+    }
+    frame.names.reserve(MAX_SCOPES);
+    frame.depths.reserve(MAX_SCOPES);
+  }
+  openScopes.reserve(MAX_SCOPES);
+  results.resize(MAX_SCOPES * 2 * 2);
+}
+
+LveGpuProfiler::~LveGpuProfiler() {
+  // 마지막으로 기록한 frame이 아직 query에 쓰고 있을 수 있음
+  for (auto &frame : frames) {
+    if (frame.queryPool == VK_NULL_HANDLE) {
+      continue;
+    }
+    VkDevice device = lveDevice.device();
+    VkQueryPool queryPool = frame.queryPool;
+    lveDevice.deferDestroy([device, queryPool] {
+      vkDestroyQueryPool(device, queryPool, nullptr);
+    });
+  }
+}
+
+void LveGpuProfiler::beginFrame(int frameIndex,
+                                VkCommandBuffer commandBuffer) {
+  assert(currentFrame == nullptr &&
+         "Can't call beginFrame while GPU profiler frame is in progress");
+  if (!supported || !enabled) {
+    return;
+  }
+  assert(frameIndex >= 0 && static_cast<size_t>(frameIndex) < frames.size() &&
+         "GPU profiler frame index out of range");
+
+  Frame &frame = frames[frameIndex];
+  if (frame.pending) {
+    resolve(frame);
+  }
+
+  vkd::cmdResetQueryPool(commandBuffer, frame.queryPool, 0, MAX_SCOPES * 2);
+  frame.names.clear();
+  frame.depths.clear();
+
+  currentFrame = &frame;
+  openScopes.clear();
+  beginScope(commandBuffer, FRAME_SCOPE);
+}
+
+void LveGpuProfiler::endFrame(VkCommandBuffer commandBuffer) {
+  if (currentFrame == nullptr) {
+    return;
+  }
+  endScope(commandBuffer, 0);
+  assert(openScopes.empty() && "GPU profiler scope was not ended");
+
+  currentFrame->submitUs = LveTrace::toMicroseconds(LveTrace::Clock::now());
+  currentFrame->pending = true;
+  currentFrame = nullptr;
+}
+
+LveGpuProfiler::scope_t
+LveGpuProfiler::beginScope(VkCommandBuffer commandBuffer, const char *name) {
+  if (currentFrame == nullptr || currentFrame->names.size() >= MAX_SCOPES) {
+    return INVALID_SCOPE;
+  }
+
+  const auto scope = static_cast<scope_t>(currentFrame->names.size());
+  currentFrame->names.push_back(name);
+  currentFrame->depths.push_back(static_cast<uint32_t>(openScopes.size()));
+  openScopes.push_back(scope);
+
+  vkd::cmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                         currentFrame->queryPool, scope * 2);
+  return scope;
+}
+
+void LveGpuProfiler::endScope(VkCommandBuffer commandBuffer, scope_t scope) {
+  if (currentFrame == nullptr || scope == INVALID_SCOPE) {
+    return;
+  }
+  assert(!openScopes.empty() && openScopes.back() == scope &&
+         "GPU profiler scopes must be nested");
+  openScopes.pop_back();
+
+  // 앞의 모든 command가 끝난 시점
+  vkd::cmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                         currentFrame->queryPool, scope * 2 + 1);
+}
+
+void LveGpuProfiler::resolveAll() {
+  assert(currentFrame == nullptr &&
+         "Can't resolve GPU profiler while frame is in progress");
+  for (auto &frame : frames) {
+    if (frame.pending) {
+      resolve(frame);
+    }
+  }
+}
+
+void LveGpuProfiler::resolve(Frame &frame) {
+  frame.pending = false;
+  const auto queryCount = static_cast<uint32_t>(frame.names.size() * 2);
+  if (queryCount == 0) {
+    return;
+  }
+
+  // 값과 availability를 같이 읽음 -> 일부만 끝났어도 기다리지 않음
+  // (VK_NOT_READY여도 available인 값은 유효)
+  const VkDeviceSize stride = 2 * sizeof(uint64_t);
+  vkGetQueryPoolResults(lveDevice.device(), frame.queryPool, 0, queryCount,
+                        queryCount * stride, results.data(), stride,
+                        VK_QUERY_RESULT_64_BIT |
+                            VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+  auto available = [&](uint32_t query) { return results[query * 2 + 1] != 0; };
+  auto toMicroseconds = [&](uint64_t ticks) {
+    return static_cast<double>(ticks & timestampMask) * timestampPeriodNs /
+           1000.0;
+  };
+
+  if (!available(0) || !available(1)) {
+    // frame 전체 구간이 없으면 CPU 시간에 맞출 기준이 없음
+    return;
+  }
+
+  // GPU는 submit보다 먼저 시작할 수 없음 -> frame마다 offset의 하한을 얻음
+  // queue가 밀린 frame은 하한이 느슨하므로 최근 OFFSET_WINDOW frame 중 가장
+  // 큰 값을 사용, 오래된 frame은 버려서 clock drift를 따라감
+  const double frameBeginUs = toMicroseconds(results[0]);
+  offsetSamplesUs.push_back(frame.submitUs - frameBeginUs);
+  if (offsetSamplesUs.size() > OFFSET_WINDOW) {
+    offsetSamplesUs.pop_front();
+  }
+  gpuToCpuOffsetUs =
+      *std::max_element(offsetSamplesUs.begin(), offsetSamplesUs.end());
+
+  std::vector<LveTraceEvent> events;
+  events.reserve(frame.names.size());
+
+  for (uint32_t scope = 0; scope < frame.names.size(); scope++) {
+    const uint32_t begin = scope * 2;
+    const uint32_t end = begin + 1;
+    if (!available(begin) || !available(end)) {
+      continue;
+    }
+    // timestampValidBits 범위에서 wrap되어도 차이는 맞게 나옴
+    const uint64_t ticks =
+        (results[end * 2] - results[begin * 2]) & timestampMask;
+    const double durationUs = toMicroseconds(ticks);
+    addSample(frame.names[scope], frame.depths[scope], durationUs / 1000.0);
+    // scope 0은 beginFrame()에서 시작한 frame 전체 구간
+    if (scope == 0 && frameHistogram != nullptr) {
+      frameHistogram->observe(durationUs / 1e6);
+    }
+
+    events.push_back({frame.names[scope], "gpu", LveTrace::GPU_THREAD_ID,
+                      toMicroseconds(results[begin * 2]) + gpuToCpuOffsetUs,
+                      durationUs});
+  }
+
+  traceFrames.push_back(std::move(events));
+  if (traceFrames.size() > TRACE_FRAMES) {
+    traceFrames.pop_front();
+  }
+}
+
+void LveGpuProfiler::addSample(const char *name, uint32_t depth, double ms) {
+  auto it = std::find_if(histories.begin(), histories.end(),
+                         [&](const ScopeHistory &history) {
+                           return history.name == name ||
+                                  std::strcmp(history.name, name) == 0;
+                         });
+  if (it == histories.end()) {
+    histories.emplace_back();
+    it = histories.end() - 1;
+    it->name = name;
+  }
+
+  ScopeHistory &history = *it;
+  history.depth = depth;
+  if (history.count == AVERAGE_WINDOW) {
+    history.sumMs -= history.samplesMs[history.next];
+  } else {
+    history.count++;
+  }
+  history.samplesMs[history.next] = ms;
+  history.next = (history.next + 1) % AVERAGE_WINDOW;
+  history.sumMs += ms;
+  history.lastMs = ms;
+}
+
+std::vector<LveGpuProfiler::ScopeStats> LveGpuProfiler::getScopeStats() const {
+  std::vector<ScopeStats> stats;
+  stats.reserve(histories.size());
+  for (const auto &history : histories) {
+    ScopeStats scope{};
+    scope.name = history.name;
+    scope.depth = history.depth;
+    scope.lastMs = history.lastMs;
+    scope.averageMs = history.sumMs / history.count;
+    scope.maxMs = *std::max_element(history.samplesMs.begin(),
+                                    history.samplesMs.begin() + history.count);
+    stats.push_back(scope);
+  }
+  return stats;
+}
+
+double LveGpuProfiler::averageFrameMs() const {
+  for (const auto &history : histories) {
+    if (std::strcmp(history.name, FRAME_SCOPE) == 0) {
+      return history.sumMs / history.count;
+    }
+  }
+  return 0.0;
+}
+
+void LveGpuProfiler::resetStats() {
+  histories.clear();
+  traceFrames.clear();
+}
+
+void LveGpuProfiler::collectTraceEvents(
+    std::vector<LveTraceEvent> &events) const {
+  for (const auto &frame : traceFrames) {
+    events.insert(events.end(), frame.begin(), frame.end());
+  }
+}
+
+} // namespace lve
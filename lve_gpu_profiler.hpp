@@ -0,0 +1,171 @@
+#pragma once
+
+#include "lve_device.hpp"
+#include "lve_metrics.hpp"
+#include "lve_trace.hpp"
+
+// std
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <vector>
+
+namespace lve {
+
+/**
+ * @brief 이름 붙은 구간의 GPU 시간을 timestamp query로 측정
+ *
+ * frame마다 query pool을 따로 두고 구간 시작/끝에 vkCmdWriteTimestamp 기록
+ * 결과는 같은 frame slot을 다시 쓸 때(fence 대기가 끝난 뒤) 읽으므로 기다리지 않음
+ * -> 결과는 frame in flight 수만큼 늦게 나옴
+ * 최근 AVERAGE_WINDOW frame의 이동 평균과 Chrome trace용 구간을 보관
+ */
+class LveGpuProfiler {
+public:
+  using scope_t = uint32_t;
+  static constexpr scope_t INVALID_SCOPE = std::numeric_limits<scope_t>::max();
+
+  // frame 하나에 기록할 수 있는 최대 구간 수 (frame 전체 포함)
+  static constexpr uint32_t MAX_SCOPES = 64;
+  // 이동 평균에 사용하는 frame 수
+  static constexpr size_t AVERAGE_WINDOW = 120;
+  // trace로 내보낼 수 있도록 보관하는 frame 수
+  static constexpr size_t TRACE_FRAMES = 300;
+  // GPU -> CPU 시간 offset을 추정하는 최근 frame 수
+  // (clock drift나 튀는 frame이 이 이후로는 영향을 주지 않음)
+  static constexpr size_t OFFSET_WINDOW = 64;
+
+  struct ScopeStats {
+    const char *name = "";
+    uint32_t depth = 0; // 중첩 깊이, frame 전체가 0
+    double lastMs = 0.0;
+    double averageMs = 0.0;
+    double maxMs = 0.0; // 최근 AVERAGE_WINDOW frame 중 최대
+  };
+
+  /**
+   * @param frameCount beginFrame()에 넘길 frame index 수 (frame in flight 최대값)
+   */
+  LveGpuProfiler(LveDevice &device, uint32_t frameCount);
+  ~LveGpuProfiler();
+
+  LveGpuProfiler(const LveGpuProfiler &) = delete;
+  LveGpuProfiler &operator=(const LveGpuProfiler &) = delete;
+
+  // graphics queue가 timestamp를 지원하지 않으면 모든 기록이 무시됨
+  bool isSupported() const { return supported; }
+
+  /**
+   * @brief 이 slot의 이전 결과를 읽고 query reset, frame 전체 구간 시작
+   * 이 slot의 fence 대기가 끝난 뒤, render pass 밖에서 호출
+   */
+  void beginFrame(int frameIndex, VkCommandBuffer commandBuffer);
+
+  /**
+   * @brief frame 전체 구간 끝, vkEndCommandBuffer 직전에 호출
+   */
+  void endFrame(VkCommandBuffer commandBuffer);
+
+  /**
+   * @param name 문자열 literal처럼 profiler보다 오래 유효해야 함
+   * @return endScope()에 넘길 값, 기록하지 않으면 INVALID_SCOPE
+   */
+  scope_t beginScope(VkCommandBuffer commandBuffer, const char *name);
+  void endScope(VkCommandBuffer commandBuffer, scope_t scope);
+
+  /**
+   * @brief 기록한 모든 slot의 결과 읽기
+   * device를 기다린 뒤(swap chain 재생성 등) frame index가 처음부터 다시 시작할 때 호출
+   */
+  void resolveAll();
+
+  // 처음 측정된 순서의 구간별 통계
+  std::vector<ScopeStats> getScopeStats() const;
+  // frame 전체 GPU 시간의 이동 평균
+  double averageFrameMs() const;
+  void resetStats();
+
+  /**
+   * @brief 보관 중인 GPU 구간을 events에 추가 (LveTrace::GPU_THREAD_ID track)
+   * GPU 시간은 submit보다 먼저 시작할 수 없다는 조건으로 CPU 시간에 맞춤 (근사값)
+   */
+  void collectTraceEvents(std::vector<LveTraceEvent> &events) const;
+
+  // false면 다음 beginFrame()부터 기록하지 않음
+  bool enabled = true;
+
+  // nullptr이 아니면 결과를 읽을 때마다 frame 전체 GPU 시간(초)을 기록
+  LveHistogram *frameHistogram = nullptr;
+
+private:
+  struct Frame {
+    VkQueryPool queryPool = VK_NULL_HANDLE;
+    std::vector<const char *> names;
+    std::vector<uint32_t> depths;
+    // 결과를 아직 읽지 않은 기록이 있음
+    bool pending = false;
+    double submitUs = 0.0;
+  };
+
+  struct ScopeHistory {
+    const char *name = "";
+    uint32_t depth = 0;
+    std::array<double, AVERAGE_WINDOW> samplesMs{};
+    size_t count = 0;
+    size_t next = 0;
+    double sumMs = 0.0;
+    double lastMs = 0.0;
+  };
+
+  void resolve(Frame &frame);
+  void addSample(const char *name, uint32_t depth, double ms);
+
+  LveDevice &lveDevice;
+  bool supported = false;
+  double timestampPeriodNs = 1.0;
+  uint64_t timestampMask = ~uint64_t{0};
+
+  std::vector<Frame> frames;
+  Frame *currentFrame = nullptr;
+  std::vector<scope_t> openScopes;
+
+  std::vector<ScopeHistory> histories;
+  std::deque<std::vector<LveTraceEvent>> traceFrames;
+  std::vector<uint64_t> results;
+
+  // frame마다 submit 시각 - GPU 시작 시각, 최근 OFFSET_WINDOW개
+  std::deque<double> offsetSamplesUs;
+  // GPU timestamp(us) + offset = steady_clock(us)
+  double gpuToCpuOffsetUs = 0.0;
+};
+
+/**
+ * @brief 생성자에서 beginScope(), 소멸자에서 endScope()
+ * profiler가 nullptr이면 아무것도 하지 않음
+ */
+class LveGpuScope {
+public:
+  LveGpuScope(LveGpuProfiler *profiler, VkCommandBuffer commandBuffer,
+              const char *name)
+      : profiler{profiler}, commandBuffer{commandBuffer} {
+    if (profiler != nullptr) {
+      scope = profiler->beginScope(commandBuffer, name);
+    }
+  }
+  ~LveGpuScope() {
+    if (profiler != nullptr) {
+      profiler->endScope(commandBuffer, scope);
+    }
+  }
+
+  LveGpuScope(const LveGpuScope &) = delete;
+  LveGpuScope &operator=(const LveGpuScope &) = delete;
+
+private:
+  LveGpuProfiler *profiler;
+  VkCommandBuffer commandBuffer;
+  LveGpuProfiler::scope_t scope = LveGpuProfiler::INVALID_SCOPE;
+};
+
+} // namespace lve
@@ -0,0 +1,49 @@
+#include "lve_input.hpp"
+
+namespace lve {
+
+LveInput::LveInput(LveWindow &window,
+                   std::vector<std::pair<int, uint32_t>> bindings)
+    : lveWindow{window}, bindings{std::move(bindings)} {
+  lveWindow.setKeyCallback(
+      [this](int key, int action) { onKey(key, action); });
+}
+
+LveInput::~LveInput() { lveWindow.setKeyCallback(nullptr); }
+
+void LveInput::pump() { glfwPollEvents(); }
+
+void LveInput::wait(double timeoutSeconds) {
+  glfwWaitEventsTimeout(timeoutSeconds);
+}
+
+void LveInput::onKey(int key, int action) {
+  if (action == GLFW_REPEAT) {
+    return;
+  }
+  for (const auto &[boundKey, bit] : bindings) {
+    if (boundKey != key) {
+      continue;
+    }
+    const uint32_t previous = keyBits;
+    if (action == GLFW_PRESS) {
+      keyBits |= bit;
+    } else {
+      keyBits &= ~bit;
+    }
+    if (keyBits != previous) {
+      pushSample();
+    }
+  }
+}
+
+void LveInput::pushSample() {
+  const auto now = Clock::now();
+  if (!samples.push({now, keyBits})) {
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  pushedTime = now;
+}
+
+} // namespace lve
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "lve_spsc_ring.hpp"
+#include "lve_window.hpp"
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace lve {
+
+/**
+ * @brief timestamp가 붙은 key 입력을 main thread에서 simulation thread로 전달
+ *
+ * glfw 입력 함수는 main thread에서만 호출할 수 있으므로 별도 polling thread 대신
+ * main thread가 event를 자주 처리(pump)하도록 하고, key 상태가 바뀔 때만
+ * sample을 기록
+ * -> render loop 시작뿐 아니라 frame fence, frame limiter를 기다리는 동안에도 pump
+ * glfw는 event 발생 시각을 알려주지 않으므로 sample 시각은 key callback이
+ * 호출된 시각 (실제 입력보다 최대 pump 간격만큼 늦음)
+ *
+ * consumer(simulation)는 integrate()로 tick 구간을 key 상태별로 나눠 적분
+ * -> tick 중간에 누른 key는 누른 시간만큼만 반영
+ */
+class LveInput {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Sample {
+    Clock::time_point time{};
+    uint32_t keyBits = 0;
+  };
+
+  static constexpr size_t RING_CAPACITY = 1024;
+
+  /**
+   * @param window key callback을 등록할 window
+   * @param bindings (glfw key, bit) 목록
+   */
+  LveInput(LveWindow &window, std::vector<std::pair<int, uint32_t>> bindings);
+  ~LveInput();
+
+  LveInput(const LveInput &) = delete;
+  LveInput &operator=(const LveInput &) = delete;
+
+  /**
+   * @brief main thread 전용, 쌓인 event 처리
+   * bind된 key 상태가 바뀐 event마다 sample 하나를 추가
+   */
+  void pump();
+
+  /**
+   * @brief main thread 전용, event가 올 때까지 최대 timeout초 동안 block한 뒤
+   * 쌓인 event 처리
+   * on-demand redraw에서 할 일이 없을 때 사용 -> CPU를 쓰지 않고 대기
+   */
+  void wait(double timeoutSeconds);
+
+  // main thread 전용, 현재 눌려 있는 key bit
+  uint32_t heldKeys() const { return keyBits; }
+
+  // main thread 전용, 마지막으로 추가한 sample의 시각
+  // LveSimulationState::inputTime이 이보다 이르면 아직 반영 안 된 입력이 있음
+  Clock::time_point latestPushTime() const { return pushedTime; }
+
+  /**
+   * @brief simulation thread 전용, to 이전 sample을 꺼내서 [from, to) 구간을
+   * key 상태가 같은 구간으로 나눠 fn 호출
+   *
+   * @param fn fn(uint32_t keyBits, float seconds)
+   */
+  template <typename Fn>
+  void integrate(Clock::time_point from, Clock::time_point to, Fn fn);
+
+  // simulation thread 전용, 마지막으로 꺼낸 sample(key 상태 변화)의 시각
+  Clock::time_point latestSampleTime() const { return consumedTime; }
+
+  // ring이 가득 차서 버린 sample 수
+  uint64_t droppedSamples() const {
+    return dropped.load(std::memory_order_relaxed);
+  }
+
+private:
+  void onKey(int key, int action);
+  void pushSample();
+
+  LveWindow &lveWindow;
+  std::vector<std::pair<int, uint32_t>> bindings;
+
+  // producer(main thread) 상태
+  uint32_t keyBits = 0;
+  Clock::time_point pushedTime{};
+
+  LveSpscRing<Sample, RING_CAPACITY> samples;
+  std::atomic<uint64_t> dropped{0};
+
+  // consumer(simulation thread) 상태
+  uint32_t consumedBits = 0;
+  Clock::time_point consumedTime{};
+};
+
+template <typename Fn>
+void LveInput::integrate(Clock::time_point from, Clock::time_point to, Fn fn) {
+  Clock::time_point cursor = from;
+  while (const Sample *sample = samples.peek()) {
+    if (sample->time >= to) {
+      break;
+    }
+    // 늦게 도착한 sample은 구간 시작으로 당김
+    const Clock::time_point change = std::max(sample->time, cursor);
+    if (change > cursor) {
+      fn(consumedBits, std::chrono::duration<float>(change - cursor).count());
+      cursor = change;
+    }
+    consumedBits = sample->keyBits;
+    consumedTime = sample->time;
+    samples.pop();
+  }
+  if (to > cursor) {
+    fn(consumedBits, std::chrono::duration<float>(to - cursor).count());
+  }
+}
+
+} // namespace lve
@@ -0,0 +1,100 @@
+#include "lve_input_recording.hpp"
+
+// std
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace lve {
+
+uint64_t LveInputRecording::tickCount() const {
+  uint64_t ticks = 0;
+  for (const auto &run : runs) {
+    ticks += run.ticks;
+  }
+  return ticks;
+}
+
+bool LveInputRecording::save(const std::string &path) const {
+  std::ofstream file{path, std::ios::binary};
+  if (!file) {
+    return false;
+  }
+  file.write(MAGIC, sizeof(MAGIC));
+  file.write(reinterpret_cast<const char *>(&VERSION), sizeof(VERSION));
+  file.write(reinterpret_cast<const char *>(&tickRate), sizeof(tickRate));
+  for (const auto &run : runs) {
+    file.write(reinterpret_cast<const char *>(&run.keyBits),
+               sizeof(run.keyBits));
+    file.write(reinterpret_cast<const char *>(&run.ticks), sizeof(run.ticks));
+  }
+  return static_cast<bool>(file);
+}
+
+LveInputRecording LveInputRecording::load(const std::string &path) {
+  std::ifstream file{path, std::ios::binary};
+  if (!file) {
+    throw std::runtime_error("failed to open input recording: " + path);
+  }
+
+  char magic[sizeof(MAGIC)];
+  uint32_t version = 0;
+  LveInputRecording recording{};
+  file.read(magic, sizeof(magic));
+  file.read(reinterpret_cast<char *>(&version), sizeof(version));
+  file.read(reinterpret_cast<char *>(&recording.tickRate),
+            sizeof(recording.tickRate));
+  if (!file || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      version != VERSION) {
+    throw std::runtime_error("invalid input recording: " + path);
+  }
+
+  Run run{};
+  while (file.read(reinterpret_cast<char *>(&run.keyBits), sizeof(run.keyBits))
+             .read(reinterpret_cast<char *>(&run.ticks), sizeof(run.ticks))) {
+    recording.runs.push_back(run);
+  }
+  return recording;
+}
+
+LveInputRecorder::LveInputRecorder(double tickRate) {
+  recording.tickRate = tickRate;
+}
+
+void LveInputRecorder::record(uint32_t keyBits) {
+  auto &runs = recording.runs;
+  if (runs.empty() || runs.back().keyBits != keyBits ||
+      runs.back().ticks == UINT32_MAX) {
+    runs.push_back({keyBits, 0});
+  }
+  runs.back().ticks++;
+}
+
+LveInputReplay::LveInputReplay(const std::string &path, double tickRate)
+    : recording{LveInputRecording::load(path)} {
+  // tick 간격이 다르면 같은 key 입력이라도 camera 경로가 달라짐
+  if (recording.tickRate != tickRate) {
+    throw std::runtime_error("input recording tick rate mismatch: " + path);
+  }
+  if (recording.runs.empty()) {
+    done.store(true, std::memory_order_release);
+  }
+}
+
+bool LveInputReplay::next(uint32_t &keyBits) {
+  if (run >= recording.runs.size()) {
+    keyBits = 0;
+    return false;
+  }
+  keyBits = recording.runs[run].keyBits;
+  if (++tickInRun >= recording.runs[run].ticks) {
+    run++;
+    tickInRun = 0;
+    if (run >= recording.runs.size()) {
+      done.store(true, std::memory_order_release);
+    }
+  }
+  return true;
+}
+
+} // namespace lve
@@ -0,0 +1,92 @@
+#pragma once
+
+// std
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lve {
+
+/**
+ * @brief simulation tick마다의 key bit를 기록하는 input recording
+ *
+ * 같은 key 상태가 이어지는 tick은 (keyBits, tick 수) 하나로 저장 -> 파일이 작음
+ * 파일 형식: "LVEI", version(u32), tick rate(f64), 그 뒤로 Run(u32, u32) 반복
+ * (little endian 기준, 같은 platform에서 기록/재생하는 용도)
+ *
+ * LveInputRecorder로 기록하고 LveInputReplay로 같은 tick rate에서 재생하면
+ * camera가 tick 단위로 bit 단위까지 같은 경로를 지남
+ * -> build 사이 frame time 비교에 사용
+ */
+struct LveInputRecording {
+  static constexpr char MAGIC[4] = {'L', 'V', 'E', 'I'};
+  static constexpr uint32_t VERSION = 1;
+
+  struct Run {
+    uint32_t keyBits = 0;
+    uint32_t ticks = 0;
+  };
+
+  double tickRate = 0.0;
+  std::vector<Run> runs;
+
+  uint64_t tickCount() const;
+
+  /**
+   * @return 파일을 쓰지 못하면 false
+   */
+  bool save(const std::string &path) const;
+
+  /**
+   * @brief 파일이 없거나 형식이 다르면 std::runtime_error
+   */
+  static LveInputRecording load(const std::string &path);
+};
+
+/**
+ * @brief simulation thread 전용, tick마다 record() 호출
+ * 기록은 memory에 모아 두고 simulation을 멈춘 뒤 save()로 저장
+ */
+class LveInputRecorder {
+public:
+  explicit LveInputRecorder(double tickRate);
+
+  void record(uint32_t keyBits);
+
+  bool save(const std::string &path) const { return recording.save(path); }
+
+  uint64_t tickCount() const { return recording.tickCount(); }
+
+private:
+  LveInputRecording recording;
+};
+
+/**
+ * @brief 기록한 key bit를 tick마다 하나씩 돌려줌
+ * next()는 simulation thread, finished()는 어느 thread에서나 호출 가능
+ */
+class LveInputReplay {
+public:
+  /**
+   * @param tickRate 현재 simulation tick rate, 기록과 다르면 std::runtime_error
+   */
+  LveInputReplay(const std::string &path, double tickRate);
+
+  /**
+   * @brief 다음 tick의 key bit, 기록이 끝나면 false를 반환하고 keyBits는 0
+   */
+  bool next(uint32_t &keyBits);
+
+  bool finished() const { return done.load(std::memory_order_acquire); }
+
+  uint64_t tickCount() const { return recording.tickCount(); }
+
+private:
+  LveInputRecording recording;
+  size_t run = 0;
+  uint32_t tickInRun = 0;
+  std::atomic<bool> done{false};
+};
+
+} // namespace lve
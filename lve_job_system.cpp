@@ -0,0 +1,392 @@
+#include "lve_job_system.hpp"
+
+// std
+#include <algorithm>
+#include <cassert>
+
+namespace lve {
+
+namespace {
+
+// 현재 thread가 속한 job system과 slot
+struct ThreadContext {
+  const LveJobSystem *system = nullptr;
+  size_t slot = 0;
+};
+thread_local ThreadContext threadContext{};
+
+// 잠들기 전에 job을 다시 찾아보는 횟수
+constexpr int SPIN_COUNT = 64;
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// WorkDeque
+
+LveJobSystem::WorkDeque::WorkDeque()
+    : buffer{new std::atomic<LveJob *>[DEQUE_CAPACITY]} {}
+
+bool LveJobSystem::WorkDeque::push(LveJob *job) {
+  const int64_t b = bottom.load(std::memory_order_relaxed);
+  const int64_t t = top.load(std::memory_order_acquire);
+  if (b - t >= static_cast<int64_t>(DEQUE_CAPACITY)) {
+    return false;
+  }
+  buffer[b & (DEQUE_CAPACITY - 1)].store(job, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  bottom.store(b + 1, std::memory_order_relaxed);
+  return true;
+}
+
+LveJob *LveJobSystem::WorkDeque::pop() {
+  const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+  bottom.store(b, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t t = top.load(std::memory_order_relaxed);
+
+  if (t > b) {
+    // 비어 있음
+    bottom.store(b + 1, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  LveJob *job = buffer[b & (DEQUE_CAPACITY - 1)].load(std::memory_order_relaxed);
+  if (t == b) {
+    // 마지막 하나 -> steal과 경쟁
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                     std::memory_order_relaxed)) {
+      job = nullptr;
+    }
+    bottom.store(b + 1, std::memory_order_relaxed);
+  }
+  return job;
+}
+
+LveJob *LveJobSystem::WorkDeque::steal() {
+  int64_t t = top.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const int64_t b = bottom.load(std::memory_order_acquire);
+  if (t >= b) {
+    return nullptr;
+  }
+  LveJob *job = buffer[t & (DEQUE_CAPACITY - 1)].load(std::memory_order_relaxed);
+  if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                   std::memory_order_relaxed)) {
+    return nullptr;
+  }
+  return job;
+}
+
+size_t LveJobSystem::WorkDeque::size() const {
+  const int64_t b = bottom.load(std::memory_order_relaxed);
+  const int64_t t = top.load(std::memory_order_relaxed);
+  return b > t ? static_cast<size_t>(b - t) : 0;
+}
+
+// ---------------------------------------------------------------------------
+// LveJobSystem
+
+LveJobSystem::LveJobSystem(unsigned workerCount) {
+  static_assert((DEQUE_CAPACITY & (DEQUE_CAPACITY - 1)) == 0,
+                "Deque capacity must be a power of two");
+
+  if (workerCount == 0) {
+    workerCount = std::max(1u, std::thread::hardware_concurrency()) - 1;
+  }
+
+  // slot 0은 생성한 thread
+  for (unsigned i = 0; i <= workerCount; i++) {
+    slots.push_back(std::make_unique<Slot>());
+  }
+  threadContext = {this, 0};
+
+  for (unsigned i = 1; i <= workerCount; i++) {
+    workers.emplace_back([this, i] { workerLoop(i); });
+  }
+}
+
+LveJobSystem::~LveJobSystem() {
+  // 남은 job은 모두 실행하고 종료
+  while (queuedJobs.load() > 0) {
+    if (LveJob *job = findJob(currentSlot())) {
+      execute(job, currentSlot());
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock{sleepMutex};
+    stopping.store(true);
+  }
+  wakeCondition.notify_all();
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  if (threadContext.system == this) {
+    threadContext = {};
+  }
+}
+
+size_t LveJobSystem::currentSlot() const {
+  return threadContext.system == this ? threadContext.slot : NO_SLOT;
+}
+
+void LveJobSystem::run(std::function<void()> fn, LveJobCounter *counter) {
+  if (counter != nullptr) {
+    counter->pending.fetch_add(1, std::memory_order_relaxed);
+  }
+  submit(new LveJob{std::move(fn), counter});
+}
+
+void LveJobSystem::runAfter(LveJobCounter &dependency,
+                            std::function<void()> fn, LveJobCounter *counter) {
+  if (counter != nullptr) {
+    counter->pending.fetch_add(1, std::memory_order_relaxed);
+  }
+  auto *job = new LveJob{std::move(fn), counter};
+
+  {
+    // finish()는 같은 lock 안에서 continuation을 꺼내고 0으로 만듦
+    std::lock_guard<std::mutex> lock{dependency.continuationMutex};
+    if (dependency.pending.load(std::memory_order_acquire) != 0) {
+      dependency.continuations.push_back(job);
+      return;
+    }
+  }
+  submit(job);
+}
+
+void LveJobSystem::wait(const LveJobCounter &counter) {
+  const size_t slot = currentSlot();
+  int idle = 0;
+  while (counter.pending.load(std::memory_order_acquire) != 0) {
+    if (LveJob *job = findJob(slot)) {
+      execute(job, slot);
+      idle = 0;
+    } else if (++idle > SPIN_COUNT) {
+      std::this_thread::yield();
+    }
+  }
+  // 마지막 finish()가 continuation mutex를 놓을 때까지 대기
+  // -> 반환 후 counter를 바로 파괴해도 안전
+  std::lock_guard<std::mutex> lock{counter.continuationMutex};
+}
+
+void LveJobSystem::parallelFor(size_t count, size_t grain,
+                               const std::function<void(size_t, size_t)> &fn) {
+  if (count == 0) {
+    return;
+  }
+  grain = std::max<size_t>(grain, 1);
+
+  // worker가 없거나 구간이 하나뿐이면 그냥 호출한 thread에서 처리
+  if (workers.empty() || count <= grain) {
+    fn(0, count);
+    return;
+  }
+
+  LveJobCounter counter;
+  std::function<void(size_t, size_t)> split = [&](size_t begin, size_t end) {
+    while (end - begin > grain) {
+      const size_t middle = begin + (end - begin) / 2;
+      run([&split, middle, end] { split(middle, end); }, &counter);
+      end = middle;
+    }
+    fn(begin, end);
+  };
+  split(0, count);
+  wait(counter);
+}
+
+void LveJobSystem::submit(LveJob *job) {
+  queuedJobs.fetch_add(1);
+
+  const size_t slot = currentSlot();
+  if (slot != NO_SLOT) {
+    Slot &owner = *slots[slot];
+    if (!owner.deque.push(job)) {
+      // deque가 가득 참 -> 그 자리에서 실행
+      queuedJobs.fetch_sub(1);
+      execute(job, slot);
+      return;
+    }
+    const size_t depth = owner.deque.size();
+    if (depth > owner.maxQueueDepth.load(std::memory_order_relaxed)) {
+      owner.maxQueueDepth.store(depth, std::memory_order_relaxed);
+    }
+  } else {
+    std::lock_guard<std::mutex> lock{injectionMutex};
+    injection.push_back(job);
+    injectionSize.store(injection.size(), std::memory_order_relaxed);
+  }
+
+  // queuedJobs 증가 후 확인 -> worker는 sleepingWorkers 증가 후 queuedJobs 확인
+  if (sleepingWorkers.load() > 0) {
+    { std::lock_guard<std::mutex> lock{sleepMutex}; }
+    wakeCondition.notify_one();
+  }
+}
+
+LveJob *LveJobSystem::findJob(size_t slotIndex) {
+  LveJob *job = nullptr;
+
+  if (slotIndex != NO_SLOT) {
+    job = slots[slotIndex]->deque.pop();
+  }
+
+  if (job == nullptr && injectionSize.load(std::memory_order_relaxed) > 0) {
+    std::lock_guard<std::mutex> lock{injectionMutex};
+    if (!injection.empty()) {
+      job = injection.front();
+      injection.pop_front();
+      injectionSize.store(injection.size(), std::memory_order_relaxed);
+    }
+  }
+
+  if (job == nullptr) {
+    // 다음 slot부터 차례로 훔치기 -> thread마다 시작 위치가 달라짐
+    const size_t count = slots.size();
+    const size_t start = slotIndex == NO_SLOT ? 0 : slotIndex + 1;
+    for (size_t i = 0; i < count && job == nullptr; i++) {
+      const size_t victim = (start + i) % count;
+      if (victim == slotIndex) {
+        continue;
+      }
+      job = slots[victim]->deque.steal();
+      if (slotIndex != NO_SLOT) {
+        Slot &thief = *slots[slotIndex];
+        thief.stealAttempts.fetch_add(1, std::memory_order_relaxed);
+        if (job != nullptr) {
+          thief.steals.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    }
+  }
+
+  if (job != nullptr) {
+    queuedJobs.fetch_sub(1);
+  }
+  return job;
+}
+
+void LveJobSystem::execute(LveJob *job, size_t slotIndex) {
+  job->fn();
+  finish(job->counter);
+  delete job;
+  if (slotIndex != NO_SLOT) {
+    slots[slotIndex]->executed.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void LveJobSystem::finish(LveJobCounter *counter) {
+  if (counter == nullptr) {
+    return;
+  }
+
+  // 마지막 job이 아니면 감소만 하고 counter에 더 이상 접근하지 않음
+  int64_t value = counter->pending.load(std::memory_order_relaxed);
+  while (true) {
+    assert(value > 0 && value < LveJobCounter::DRAINING &&
+           "Job counter finished more jobs than it started");
+    if (value == 1) {
+      if (counter->pending.compare_exchange_weak(
+              value, LveJobCounter::DRAINING, std::memory_order_acq_rel,
+              std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (counter->pending.compare_exchange_weak(
+                   value, value - 1, std::memory_order_acq_rel,
+                   std::memory_order_relaxed)) {
+      return;
+    }
+  }
+
+  std::vector<LveJob *> ready;
+  {
+    std::lock_guard<std::mutex> lock{counter->continuationMutex};
+    ready.swap(counter->continuations);
+    counter->pending.store(0, std::memory_order_release);
+  }
+  for (LveJob *job : ready) {
+    submit(job);
+  }
+}
+
+void LveJobSystem::workerLoop(size_t slotIndex) {
+  threadContext = {this, slotIndex};
+  Slot &slot = *slots[slotIndex];
+
+  int idle = 0;
+  while (!stopping.load(std::memory_order_relaxed)) {
+    if (LveJob *job = findJob(slotIndex)) {
+      execute(job, slotIndex);
+      idle = 0;
+      continue;
+    }
+    if (++idle < SPIN_COUNT) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    // 할 일이 없으면 새 job이 들어올 때까지 잠듦
+    sleepingWorkers.fetch_add(1);
+    {
+      std::unique_lock<std::mutex> lock{sleepMutex};
+      wakeCondition.wait(lock, [this] {
+        return stopping.load() || queuedJobs.load() > 0;
+      });
+    }
+    sleepingWorkers.fetch_sub(1);
+    slot.sleeps.fetch_add(1, std::memory_order_relaxed);
+    idle = 0;
+  }
+}
+
+size_t LveJobSystem::queueDepth() const {
+  size_t depth = injectionSize.load(std::memory_order_relaxed);
+  for (const auto &slot : slots) {
+    depth += slot->deque.size();
+  }
+  return depth;
+}
+
+std::vector<LveJobSystem::ThreadStats> LveJobSystem::getThreadStats() const {
+  std::vector<ThreadStats> result;
+  result.reserve(slots.size());
+  for (const auto &slot : slots) {
+    ThreadStats stats{};
+    stats.executed = slot->executed.load(std::memory_order_relaxed);
+    stats.steals = slot->steals.load(std::memory_order_relaxed);
+    stats.stealAttempts = slot->stealAttempts.load(std::memory_order_relaxed);
+    stats.sleeps = slot->sleeps.load(std::memory_order_relaxed);
+    stats.maxQueueDepth = slot->maxQueueDepth.load(std::memory_order_relaxed);
+    result.push_back(stats);
+  }
+  return result;
+}
+
+LveJobSystem::ThreadStats LveJobSystem::getTotalStats() const {
+  ThreadStats total{};
+  for (const auto &stats : getThreadStats()) {
+    total.executed += stats.executed;
+    total.steals += stats.steals;
+    total.stealAttempts += stats.stealAttempts;
+    total.sleeps += stats.sleeps;
+    total.maxQueueDepth = std::max(total.maxQueueDepth, stats.maxQueueDepth);
+  }
+  return total;
+}
+
+void LveJobSystem::resetStats() {
+  for (auto &slot : slots) {
+    slot->executed.store(0, std::memory_order_relaxed);
+    slot->steals.store(0, std::memory_order_relaxed);
+    slot->stealAttempts.store(0, std::memory_order_relaxed);
+    slot->sleeps.store(0, std::memory_order_relaxed);
+    slot->maxQueueDepth.store(0, std::memory_order_relaxed);
+  }
+}
+
+} // namespace lve
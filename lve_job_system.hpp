@@ -0,0 +1,188 @@
+#pragma once
+
+// std
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace lve {
+
+class LveJobCounter;
+
+struct LveJob {
+  std::function<void()> fn;
+  LveJobCounter *counter = nullptr;
+};
+
+/**
+ * @brief 남은 job 수를 세는 counter
+ *
+ * run()에 넘기면 job이 끝날 때마다 1씩 감소, wait()로 0이 될 때까지 대기
+ * runAfter()로 0이 된 뒤에 실행할 job(의존 관계)을 걸 수 있음
+ * counter를 파괴하기 전에는 반드시 LveJobSystem::wait() 호출
+ */
+class LveJobCounter {
+public:
+  LveJobCounter() = default;
+
+  LveJobCounter(const LveJobCounter &) = delete;
+  LveJobCounter &operator=(const LveJobCounter &) = delete;
+
+  // polling용 (loading 완료 확인 등)
+  bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+
+private:
+  friend class LveJobSystem;
+
+  // 마지막 job이 continuation을 꺼내는 동안 pending에 넣어두는 값
+  static constexpr int64_t DRAINING = int64_t{1} << 62;
+
+  std::atomic<int64_t> pending{0};
+
+  mutable std::mutex continuationMutex;
+  std::vector<LveJob *> continuations;
+};
+
+/**
+ * @brief work-stealing job scheduler
+ *
+ * worker thread마다 lock-free deque(Chase-Lev)를 가짐
+ * 자기 deque는 LIFO로 꺼내고(cache locality), 비면 다른 deque에서 FIFO로 훔쳐옴
+ * 생성한 thread(main thread)도 slot 0의 deque를 가지고 wait() 중에 job을 실행
+ * 그 외 thread에서 넣은 job은 mutex로 보호된 injection queue로 들어감
+ *
+ * frame마다 나눌 수 있는 작업(scene graph 전파, BVH refit 등)은 이 scheduler를
+ * 같이 사용 -> subsystem마다 thread를 따로 만들지 않음
+ * 계속 block되는 loop(simulation tick, log sink, metrics server)는 worker를
+ * 점유하므로 자기 thread를 가짐
+ */
+class LveJobSystem {
+public:
+  // deque 하나에 들어가는 최대 job 수, 가득 차면 push한 thread에서 바로 실행
+  static constexpr size_t DEQUE_CAPACITY = 4096;
+
+  // thread 하나의 누적 통계
+  struct ThreadStats {
+    uint64_t executed = 0;      // 실행한 job 수
+    uint64_t steals = 0;        // 다른 deque에서 훔쳐온 job 수
+    uint64_t stealAttempts = 0; // 훔치기 시도 수 (실패 포함)
+    uint64_t sleeps = 0;        // 할 일이 없어서 잠든 횟수
+    size_t maxQueueDepth = 0;   // 자기 deque의 최대 길이
+  };
+
+  /**
+   * @param workerCount worker 수, 0이면 (hardware thread - 1)
+   */
+  explicit LveJobSystem(unsigned workerCount = 0);
+  ~LveJobSystem();
+
+  LveJobSystem(const LveJobSystem &) = delete;
+  LveJobSystem &operator=(const LveJobSystem &) = delete;
+
+  /**
+   * @brief job 추가
+   *
+   * @param fn 실행할 함수
+   * @param counter 끝나면 감소시킬 counter, nullptr 가능
+   */
+  void run(std::function<void()> fn, LveJobCounter *counter = nullptr);
+
+  /**
+   * @brief dependency가 0이 된 뒤에 fn 실행
+   * 이미 0이면 바로 추가
+   */
+  void runAfter(LveJobCounter &dependency, std::function<void()> fn,
+                LveJobCounter *counter = nullptr);
+
+  /**
+   * @brief counter가 0이 될 때까지 job을 실행하면서 대기
+   * 대기하는 thread도 작업에 참여하므로 job 안에서 호출해도 deadlock이 없음
+   */
+  void wait(const LveJobCounter &counter);
+
+  /**
+   * @brief [0, count)를 반씩 나눠서 병렬 처리
+   * 큰 절반을 deque에 넣어두고 작은 쪽을 계속 나누므로 idle thread가 큰 덩어리를
+   * 훔쳐감, grain 이하로 작아지면 fn(begin, end) 호출, 끝날 때까지 block
+   *
+   * @param count 전체 작업 수
+   * @param grain 한 번에 처리하는 최소 작업 수
+   * @param fn fn(begin, end)
+   */
+  void parallelFor(size_t count, size_t grain,
+                   const std::function<void(size_t, size_t)> &fn);
+
+  size_t workerCount() const { return workers.size(); }
+  // main thread를 포함한 실행 thread 수
+  size_t threadCount() const { return slots.size(); }
+
+  // 현재 모든 deque와 injection queue에 쌓인 job 수 (근사값)
+  size_t queueDepth() const;
+
+  // slot 0은 main thread, 1..은 worker
+  std::vector<ThreadStats> getThreadStats() const;
+  ThreadStats getTotalStats() const;
+  void resetStats();
+
+private:
+  /**
+   * @brief Chase-Lev deque (Lê et al. 2013의 C11 memory order 버전)
+   * push/pop은 소유 thread만, steal은 어느 thread나 호출
+   */
+  class WorkDeque {
+  public:
+    WorkDeque();
+
+    bool push(LveJob *job);
+    LveJob *pop();
+    LveJob *steal();
+    size_t size() const;
+
+  private:
+    alignas(64) std::atomic<int64_t> top{0};
+    alignas(64) std::atomic<int64_t> bottom{0};
+    std::unique_ptr<std::atomic<LveJob *>[]> buffer;
+  };
+
+  // thread 하나의 deque와 통계, false sharing을 막기 위해 cache line 정렬
+  struct alignas(64) Slot {
+    WorkDeque deque;
+    std::atomic<uint64_t> executed{0};
+    std::atomic<uint64_t> steals{0};
+    std::atomic<uint64_t> stealAttempts{0};
+    std::atomic<uint64_t> sleeps{0};
+    std::atomic<size_t> maxQueueDepth{0};
+  };
+
+  void submit(LveJob *job);
+  LveJob *findJob(size_t slotIndex);
+  void execute(LveJob *job, size_t slotIndex);
+  void finish(LveJobCounter *counter);
+  void workerLoop(size_t slotIndex);
+
+  // 현재 thread의 slot, 이 job system의 thread가 아니면 NO_SLOT
+  static constexpr size_t NO_SLOT = ~size_t{0};
+  size_t currentSlot() const;
+
+  std::vector<std::unique_ptr<Slot>> slots;
+  std::vector<std::thread> workers;
+
+  mutable std::mutex injectionMutex;
+  std::deque<LveJob *> injection;
+  std::atomic<size_t> injectionSize{0};
+
+  // 잠든 worker 깨우기
+  std::mutex sleepMutex;
+  std::condition_variable wakeCondition;
+  std::atomic<int64_t> queuedJobs{0};
+  std::atomic<int> sleepingWorkers{0};
+  std::atomic<bool> stopping{false};
+};
+
+} // namespace lve
@@ -0,0 +1,124 @@
+#include "lve_late_latch.hpp"
+
+// std
+#include <algorithm>
+#include <stdexcept>
+
+namespace lve {
+
+LveLateLatch::LveLateLatch(LveDevice &device) : lveDevice{device} {
+  createBuffers();
+  createDescriptors();
+}
+
+LveLateLatch::~LveLateLatch() {
+  // descriptor set은 pool과 같이 해제됨
+  vkDestroyDescriptorPool(lveDevice.device(), descriptorPool, nullptr);
+  vkDestroyDescriptorSetLayout(lveDevice.device(), descriptorSetLayout,
+                               nullptr);
+  for (auto &frame : frames) {
+    vkUnmapMemory(lveDevice.device(), frame.memory);
+    lveDevice.destroyBuffer(frame.buffer, frame.memory);
+  }
+}
+
+void LveLateLatch::createBuffers() {
+  for (auto &frame : frames) {
+    // HOST_COHERENT -> submit 전에 쓴 값이 flush 없이 GPU에 보임
+    // 매 frame 쓰므로 가능하면 device local memory에 바로 씀
+    lveDevice.createBuffer(
+        sizeof(Ubo), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+        lveDevice.hostWriteMemoryProperties(sizeof(Ubo),
+                                            VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT),
+        frame.buffer, frame.memory, LveMemoryCategory::UNIFORM);
+
+    // 프로그램이 끝날 때까지 mapping 유지
+    void *data;
+    vkMapMemory(lveDevice.device(), frame.memory, 0, sizeof(Ubo), 0, &data);
+    frame.mapped = static_cast<Ubo *>(data);
+    *frame.mapped = Ubo{};
+  }
+}
+
+void LveLateLatch::createDescriptors() {
+  VkDescriptorSetLayoutBinding binding{};
+  binding.binding = 0;
+  binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  binding.descriptorCount = 1;
+  binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+
+  VkDescriptorSetLayoutCreateInfo layoutInfo{};
+  layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+  layoutInfo.bindingCount = 1;
+  layoutInfo.pBindings = &binding;
+
+  if (vkCreateDescriptorSetLayout(lveDevice.device(), &layoutInfo, nullptr,
+                                  &descriptorSetLayout) != VK_SUCCESS) {
+    throw std::runtime_error("failed to create descriptor set layout!");
+  }
+
+  VkDescriptorPoolSize poolSize{};
+  poolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  poolSize.descriptorCount = static_cast<uint32_t>(frames.size());
+
+  VkDescriptorPoolCreateInfo poolInfo{};
+  poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+  poolInfo.maxSets = static_cast<uint32_t>(frames.size());
+  poolInfo.poolSizeCount = 1;
+  poolInfo.pPoolSizes = &poolSize;
+
+  if (vkCreateDescriptorPool(lveDevice.device(), &poolInfo, nullptr,
+                             &descriptorPool) != VK_SUCCESS) {
+    throw std::runtime_error("failed to create descriptor pool!");
+  }
+
+  for (auto &frame : frames) {
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = descriptorPool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &descriptorSetLayout;
+
+    if (vkAllocateDescriptorSets(lveDevice.device(), &allocInfo,
+                                 &frame.descriptorSet) != VK_SUCCESS) {
+      throw std::runtime_error("failed to allocate descriptor set!");
+    }
+
+    VkDescriptorBufferInfo bufferInfo{};
+    bufferInfo.buffer = frame.buffer;
+    bufferInfo.offset = 0;
+    bufferInfo.range = sizeof(Ubo);
+
+    VkWriteDescriptorSet write{};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = frame.descriptorSet;
+    write.dstBinding = 0;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    write.pBufferInfo = &bufferInfo;
+    vkUpdateDescriptorSets(lveDevice.device(), 1, &write, 0, nullptr);
+  }
+}
+
+void LveLateLatch::record(int frameIndex, const glm::mat4 &projectionView) {
+  Frame &frame = frames[frameIndex];
+  frame.recordedProjectionView = projectionView;
+  frame.recordTime = Clock::now();
+  frame.mapped->correction = glm::mat4{1.f};
+}
+
+void LveLateLatch::latch(int frameIndex, const glm::mat4 &projectionView) {
+  Frame &frame = frames[frameIndex];
+  frame.mapped->correction =
+      projectionView * glm::inverse(frame.recordedProjectionView);
+
+  const double delayMs = std::chrono::duration<double, std::milli>(
+                             Clock::now() - frame.recordTime)
+                             .count();
+  stats.latches++;
+  delayMsSum += delayMs;
+  stats.averageDelayMs = delayMsSum / static_cast<double>(stats.latches);
+  stats.maxDelayMs = std::max(stats.maxDelayMs, delayMs);
+}
+
+} // namespace lve
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "lve_device.hpp"
+#include "lve_swap_chain.hpp"
+
+// libs
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+// std
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace lve {
+
+/**
+ * @brief submit 직전에 최신 camera를 반영하는 uniform buffer
+ *
+ * push constant에는 기록 시점의 projection * view가 이미 곱해져 있으므로
+ * correction = 최신 PV * inverse(기록 시점 PV)를 mapped UBO에 써서 shader에서 앞에 곱함
+ * -> command buffer를 다시 기록하지 않고 camera만 최신 상태로 바뀜
+ * frame마다 buffer를 따로 두고, 해당 frame의 fence가 signal된 뒤에만 씀
+ */
+class LveLateLatch {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  // shader의 set 0, binding 0과 같은 layout
+  struct Ubo {
+    glm::mat4 correction{1.f};
+  };
+
+  struct Stats {
+    uint64_t latches = 0;
+    // record() -> latch() 사이 시간, 그만큼 더 최근 camera로 그려짐
+    double averageDelayMs = 0.0;
+    double maxDelayMs = 0.0;
+  };
+
+  explicit LveLateLatch(LveDevice &device);
+  ~LveLateLatch();
+
+  LveLateLatch(const LveLateLatch &) = delete;
+  LveLateLatch &operator=(const LveLateLatch &) = delete;
+
+  VkDescriptorSetLayout getDescriptorSetLayout() const {
+    return descriptorSetLayout;
+  }
+  VkDescriptorSet getDescriptorSet(int frameIndex) const {
+    return frames[frameIndex].descriptorSet;
+  }
+
+  /**
+   * @brief command 기록에 사용한 projection * view 저장, correction은 identity
+   */
+  void record(int frameIndex, const glm::mat4 &projectionView);
+
+  /**
+   * @brief 최신 projection * view로 correction 갱신
+   * vkQueueSubmit 직전 (LveRenderer::setBeforeSubmitCallback)에서 호출
+   */
+  void latch(int frameIndex, const glm::mat4 &projectionView);
+
+  const Stats &getStats() const { return stats; }
+  void resetStats() {
+    stats = Stats{};
+    delayMsSum = 0.0;
+  }
+
+private:
+  struct Frame {
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    Ubo *mapped = nullptr;
+    VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+    glm::mat4 recordedProjectionView{1.f};
+    Clock::time_point recordTime{};
+  };
+
+  void createBuffers();
+  void createDescriptors();
+
+  LveDevice &lveDevice;
+
+  VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
+  VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+  std::array<Frame, LveSwapChain::MAX_FRAMES_IN_FLIGHT> frames{};
+
+  Stats stats{};
+  double delayMsSum = 0.0;
+};
+
+} // namespace lve
@@ -0,0 +1,195 @@
+#include "lve_log.hpp"
+#include "lve_mpsc_ring.hpp"
+
+// std
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+namespace lve {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// 비어 있을 때 sink thread가 queue를 다시 확인하는 간격
+constexpr auto SINK_INTERVAL = std::chrono::milliseconds{2};
+
+struct State {
+  State() : start{Clock::now()} {
+    sink = std::thread{[this] { run(); }};
+  }
+
+  void run() {
+    while (running.load(std::memory_order_acquire)) {
+      if (drain() == 0) {
+        std::this_thread::sleep_for(SINK_INTERVAL);
+      }
+    }
+    drain();
+  }
+
+  // queue에 있는 record를 모두 쓰고 쓴 개수를 반환 (sink thread 전용)
+  size_t drain() {
+    std::lock_guard<std::mutex> lock{outputMutex};
+    size_t count = 0;
+    while (const LveLog::Record *record = queue.peek()) {
+      std::fprintf(output, "[%10.3f] [%-5s] [t%u] %.*s\n",
+                   static_cast<double>(record->timeNs) / 1e9,
+                   LveLog::levelName(record->level), record->threadId,
+                   static_cast<int>(record->length), record->text);
+      queue.pop();
+      count++;
+    }
+
+    const uint64_t dropped = droppedRecords.load(std::memory_order_relaxed);
+    if (dropped != reportedDrops) {
+      std::fprintf(output, "[log] %llu records dropped (queue full)\n",
+                   static_cast<unsigned long long>(dropped - reportedDrops));
+      reportedDrops = dropped;
+    }
+    if (count > 0) {
+      std::fflush(output);
+      written.fetch_add(count, std::memory_order_release);
+    }
+    return count;
+  }
+
+  void stop() {
+    running.store(false, std::memory_order_release);
+    if (sink.joinable()) {
+      sink.join();
+    }
+    std::lock_guard<std::mutex> lock{outputMutex};
+    if (output != stdout) {
+      std::fclose(output);
+      output = stdout;
+    }
+  }
+
+  const Clock::time_point start;
+  LveMpscRing<LveLog::Record, LveLog::QUEUE_CAPACITY> queue;
+  std::atomic<uint64_t> queued{0};
+  std::atomic<uint64_t> written{0};
+  std::atomic<uint64_t> droppedRecords{0};
+  std::atomic<uint32_t> nextThreadId{0};
+  std::atomic<bool> running{true};
+
+  // sink thread와 setFile()만 사용, record를 넣는 thread는 잡지 않음
+  std::mutex outputMutex;
+  std::FILE *output = stdout;
+  uint64_t reportedDrops = 0;
+
+  std::thread sink;
+};
+
+// 다른 static object의 소멸자에서도 log를 남길 수 있도록 해제하지 않음
+// 종료할 때 atexit에서 남은 record를 씀
+State &state() {
+  static State *instance = [] {
+    auto *created = new State{};
+    std::atexit([] { state().stop(); });
+    return created;
+  }();
+  return *instance;
+}
+
+uint32_t currentThreadId() {
+  static thread_local const uint32_t id =
+      state().nextThreadId.fetch_add(1, std::memory_order_relaxed);
+  return id;
+}
+
+} // namespace
+
+bool LveLog::setFile(const std::string &path) {
+  State &log = state();
+  std::FILE *file = stdout;
+  if (!path.empty()) {
+    file = std::fopen(path.c_str(), "w");
+    if (file == nullptr) {
+      return false;
+    }
+  }
+  std::lock_guard<std::mutex> lock{log.outputMutex};
+  if (log.output != stdout) {
+    std::fclose(log.output);
+  }
+  log.output = file;
+  return true;
+}
+
+void LveLog::write(Level level, const char *text, size_t length) {
+  State &log = state();
+
+  Record record;
+  record.timeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      Clock::now() - log.start)
+                      .count();
+  record.threadId = currentThreadId();
+  record.level = level;
+  // 긴 줄(validation layer message 등)은 MAX_MESSAGE씩 이어지는 record로 나눔
+  // 같은 thread, 같은 시각 -> 다른 thread record가 끼어도 구분 가능
+  do {
+    const size_t part = std::min(length, MAX_MESSAGE);
+    std::memcpy(record.text, text, part);
+    record.length = static_cast<uint16_t>(part);
+    text += part;
+    length -= part;
+
+    if (log.queue.push(record)) {
+      log.queued.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      log.droppedRecords.fetch_add(1, std::memory_order_relaxed);
+    }
+  } while (length > 0);
+}
+
+void LveLog::flush() {
+  State &log = state();
+  const uint64_t target = log.queued.load(std::memory_order_relaxed);
+  while (log.written.load(std::memory_order_acquire) < target &&
+         log.running.load(std::memory_order_acquire)) {
+    std::this_thread::sleep_for(SINK_INTERVAL);
+  }
+}
+
+uint64_t LveLog::droppedCount() {
+  return state().droppedRecords.load(std::memory_order_relaxed);
+}
+
+const char *LveLog::levelName(Level level) {
+  switch (level) {
+  case Level::DEBUG:
+    return "debug";
+  case Level::INFO:
+    return "info";
+  case Level::WARN:
+    return "warn";
+  case Level::ERROR:
+    return "error";
+  }
+  return "?";
+}
+
+LveLogLine::~LveLogLine() {
+  if (!LveLog::enabled(level)) {
+    return;
+  }
+  // 줄마다 record 하나 -> 파일에서 줄마다 시각, level이 붙음
+  const char *begin = buffer.begin();
+  const char *end = begin + buffer.size();
+  while (begin < end) {
+    const char *newline = std::find(begin, end, '\n');
+    if (newline > begin) {
+      LveLog::write(level, begin, static_cast<size_t>(newline - begin));
+    }
+    begin = newline + 1;
+  }
+}
+
+} // namespace lve
@@ -0,0 +1,135 @@
+#pragma once
+
+// std
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+namespace lve {
+
+/**
+ * @brief 비동기 logger
+ *
+ * 호출한 thread에서 한 줄씩 문자열로 만든 record를 lock-free queue에 넣고
+ * background thread가 stdout이나 파일에 씀 -> render, loader thread는 I/O나
+ * flush를 기다리지 않음
+ * queue가 가득 차면 record를 버리고 개수만 셈 (호출한 thread는 기다리지 않음)
+ * 프로그램이 끝날 때 남은 record를 모두 쓰고 종료
+ */
+class LveLog {
+public:
+  enum class Level : uint8_t { DEBUG, INFO, WARN, ERROR };
+
+  // record 하나의 최대 길이, 넘으면 여러 record로 나눔
+  static constexpr size_t MAX_MESSAGE = 480;
+  // queue에 담을 수 있는 record 수 (2의 거듭제곱)
+  static constexpr size_t QUEUE_CAPACITY = 1024;
+
+  struct Record {
+    int64_t timeNs = 0; // logger 시작 기준 steady_clock
+    uint32_t threadId = 0;
+    Level level = Level::INFO;
+    uint16_t length = 0;
+    char text[MAX_MESSAGE];
+  };
+
+  static bool enabled(Level level) {
+    return level >= minimumLevel.load(std::memory_order_relaxed);
+  }
+  // 이보다 낮은 level은 문자열을 만들지 않고 버림, 기본값 INFO
+  static void setLevel(Level level) {
+    minimumLevel.store(level, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief 이후 record를 path 파일에 씀, 빈 문자열이면 stdout
+   * @return 파일을 열지 못하면 false (기존 출력 유지)
+   */
+  static bool setFile(const std::string &path);
+
+  /**
+   * @brief record를 queue에 넣음, 줄바꿈 없는 한 줄
+   * MAX_MESSAGE보다 길면 이어지는 record 여러 개로 나눔
+   * 어느 thread에서나 호출 가능하고 block되지 않음
+   */
+  static void write(Level level, const char *text, size_t length);
+
+  /**
+   * @brief 지금까지 넣은 record를 모두 쓸 때까지 대기
+   * 프로그램을 끝내기 직전 등 출력 순서가 중요할 때만 호출
+   */
+  static void flush();
+
+  // queue가 가득 차서 버린 record 수
+  static uint64_t droppedCount();
+
+  static const char *levelName(Level level);
+
+private:
+  static inline std::atomic<Level> minimumLevel{Level::INFO};
+};
+
+/**
+ * @brief stream 문법으로 record를 만드는 임시 object
+ * 소멸자에서 줄마다 record 하나씩 LveLog에 넣음 (heap 할당 없음)
+ *
+ * LVE_LOG_INFO << "vertex count " << count;
+ * 여러 문장으로 한 줄을 만들 때는 object를 직접 만들어서 사용
+ */
+class LveLogLine {
+public:
+  // 한 번에 모을 수 있는 최대 길이 (여러 줄 합계)
+  static constexpr size_t BUFFER_SIZE = 4096;
+
+  explicit LveLogLine(LveLog::Level level)
+      : level{level}, stream{&buffer} {}
+  ~LveLogLine();
+
+  LveLogLine(const LveLogLine &) = delete;
+  LveLogLine &operator=(const LveLogLine &) = delete;
+
+  template <typename T> LveLogLine &operator<<(const T &value) {
+    stream << value;
+    return *this;
+  }
+
+  // std::ostream을 받는 함수에 넘길 때
+  std::ostream &getStream() { return stream; }
+
+private:
+  // 고정 크기 배열에 쓰고, 가득 차면 나머지를 버리는 streambuf
+  class Buffer : public std::streambuf {
+  public:
+    Buffer() { setp(data, data + BUFFER_SIZE); }
+    const char *begin() const { return data; }
+    size_t size() const { return static_cast<size_t>(pptr() - pbase()); }
+
+  protected:
+    int_type overflow(int_type c) override {
+      return traits_type::not_eof(c);
+    }
+
+  private:
+    char data[BUFFER_SIZE];
+  };
+
+  LveLog::Level level;
+  Buffer buffer;
+  std::ostream stream;
+};
+
+} // namespace lve
+
+// level이 꺼져 있으면 인자를 계산하지 않음
+#define LVE_LOG(level)                                                         \
+  if (!::lve::LveLog::enabled(::lve::LveLog::Level::level)) {                  \
+  } else                                                                       \
+    ::lve::LveLogLine { ::lve::LveLog::Level::level }
+
+#define LVE_LOG_DEBUG LVE_LOG(DEBUG)
+#define LVE_LOG_INFO LVE_LOG(INFO)
+#define LVE_LOG_WARN LVE_LOG(WARN)
+#define LVE_LOG_ERROR LVE_LOG(ERROR)
@@ -0,0 +1,192 @@
+#include "lve_metrics.hpp"
+
+// std
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <mutex>
+
+namespace lve {
+
+namespace {
+
+enum class MetricType { COUNTER, GAUGE, HISTOGRAM };
+
+struct Entry {
+  std::string name;
+  std::string help;
+  MetricType type;
+  std::unique_ptr<LveCounter> counter;
+  std::unique_ptr<LveGauge> gauge;
+  std::unique_ptr<LveHistogram> histogram;
+};
+
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<Entry>> entries;
+};
+
+// metric 참조가 프로그램 끝까지 유효하도록 해제하지 않음
+Registry &registry() {
+  static Registry *instance = new Registry{};
+  return *instance;
+}
+
+// 같은 이름이 있으면 그 entry, 없으면 새 entry (lock을 잡고 호출)
+Entry &findOrAdd(Registry &state, const std::string &name,
+                 const std::string &help, MetricType type) {
+  for (auto &entry : state.entries) {
+    if (entry->name == name) {
+      assert(entry->type == type && "Metric registered with another type");
+      return *entry;
+    }
+  }
+  state.entries.push_back(std::make_unique<Entry>());
+  Entry &entry = *state.entries.back();
+  entry.name = name;
+  entry.help = help;
+  entry.type = type;
+  return entry;
+}
+
+std::string formatValue(double value) {
+  if (std::isinf(value)) {
+    return value > 0 ? "+Inf" : "-Inf";
+  }
+  if (std::isnan(value)) {
+    return "NaN";
+  }
+  char text[32];
+  std::snprintf(text, sizeof(text), "%.9g", value);
+  return text;
+}
+
+// HELP 안의 \와 줄바꿈은 escape
+std::string escapeHelp(const std::string &help) {
+  std::string escaped;
+  for (char c : help) {
+    if (c == '\\') {
+      escaped += "\\\\";
+    } else if (c == '\n') {
+      escaped += "\\n";
+    } else {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+} // namespace
+
+LveHistogram::LveHistogram(std::vector<double> upperBounds)
+    : upperBounds{std::move(upperBounds)},
+      buckets{new std::atomic<uint64_t>[this->upperBounds.size() + 1]} {
+  for (size_t i = 0; i <= this->upperBounds.size(); i++) {
+    buckets[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+LveHistogram::Snapshot LveHistogram::snapshot() const {
+  Snapshot result{};
+  result.upperBounds = upperBounds;
+  result.cumulativeCounts.reserve(upperBounds.size() + 1);
+  uint64_t cumulative = 0;
+  for (size_t i = 0; i <= upperBounds.size(); i++) {
+    cumulative += buckets[i].load(std::memory_order_relaxed);
+    result.cumulativeCounts.push_back(cumulative);
+  }
+  result.sum = sum.load(std::memory_order_relaxed);
+  return result;
+}
+
+LveCounter &LveMetrics::counter(const std::string &name,
+                                const std::string &help) {
+  Registry &state = registry();
+  std::lock_guard<std::mutex> lock{state.mutex};
+  Entry &entry = findOrAdd(state, name, help, MetricType::COUNTER);
+  if (!entry.counter) {
+    entry.counter = std::make_unique<LveCounter>();
+  }
+  return *entry.counter;
+}
+
+LveGauge &LveMetrics::gauge(const std::string &name, const std::string &help) {
+  Registry &state = registry();
+  std::lock_guard<std::mutex> lock{state.mutex};
+  Entry &entry = findOrAdd(state, name, help, MetricType::GAUGE);
+  if (!entry.gauge) {
+    entry.gauge = std::make_unique<LveGauge>();
+  }
+  return *entry.gauge;
+}
+
+LveHistogram &LveMetrics::histogram(const std::string &name,
+                                    const std::string &help,
+                                    std::vector<double> upperBounds) {
+  Registry &state = registry();
+  std::lock_guard<std::mutex> lock{state.mutex};
+  Entry &entry = findOrAdd(state, name, help, MetricType::HISTOGRAM);
+  if (!entry.histogram) {
+    entry.histogram = std::make_unique<LveHistogram>(std::move(upperBounds));
+  } else {
+    assert(entry.histogram->getUpperBounds() == upperBounds &&
+           "Histogram registered with other buckets");
+  }
+  return *entry.histogram;
+}
+
+std::vector<double> LveMetrics::exponentialBuckets(double start, double factor,
+                                                   size_t count) {
+  std::vector<double> bounds;
+  bounds.reserve(count);
+  double bound = start;
+  for (size_t i = 0; i < count; i++) {
+    bounds.push_back(bound);
+    bound *= factor;
+  }
+  return bounds;
+}
+
+std::vector<double> LveMetrics::frameTimeBuckets() {
+  // 240, 144, 120, 60, 30, 20, 10, 4 fps 경계
+  return {1.0 / 240, 1.0 / 144, 1.0 / 120, 1.0 / 60,
+          1.0 / 30,  1.0 / 20,  1.0 / 10,  1.0 / 4};
+}
+
+std::string LveMetrics::exposition() {
+  Registry &state = registry();
+  std::lock_guard<std::mutex> lock{state.mutex};
+
+  std::string text;
+  for (const auto &entry : state.entries) {
+    text += "# HELP " + entry->name + " " + escapeHelp(entry->help) + "\n";
+    switch (entry->type) {
+    case MetricType::COUNTER:
+      text += "# TYPE " + entry->name + " counter\n";
+      text += entry->name + " " + std::to_string(entry->counter->get()) + "\n";
+      break;
+    case MetricType::GAUGE:
+      text += "# TYPE " + entry->name + " gauge\n";
+      text += entry->name + " " + formatValue(entry->gauge->get()) + "\n";
+      break;
+    case MetricType::HISTOGRAM: {
+      text += "# TYPE " + entry->name + " histogram\n";
+      const auto snapshot = entry->histogram->snapshot();
+      for (size_t i = 0; i < snapshot.cumulativeCounts.size(); i++) {
+        const std::string bound = i < snapshot.upperBounds.size()
+                                      ? formatValue(snapshot.upperBounds[i])
+                                      : "+Inf";
+        text += entry->name + "_bucket{le=\"" + bound + "\"} " +
+                std::to_string(snapshot.cumulativeCounts[i]) + "\n";
+      }
+      text += entry->name + "_sum " + formatValue(snapshot.sum) + "\n";
+      text += entry->name + "_count " +
+              std::to_string(snapshot.cumulativeCounts.back()) + "\n";
+      break;
+    }
+    }
+  }
+  return text;
+}
+
+} // namespace lve
@@ -0,0 +1,119 @@
+#pragma once
+
+// std
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace lve {
+
+/**
+ * @brief 증가만 하는 값 (frame 수, upload byte 수 등)
+ */
+class LveCounter {
+public:
+  void add(uint64_t amount = 1) {
+    value.fetch_add(amount, std::memory_order_relaxed);
+  }
+  uint64_t get() const { return value.load(std::memory_order_relaxed); }
+
+private:
+  std::atomic<uint64_t> value{0};
+};
+
+/**
+ * @brief 임의로 바뀌는 현재 값 (draw 수, memory 사용량 등)
+ */
+class LveGauge {
+public:
+  void set(double newValue) {
+    value.store(newValue, std::memory_order_relaxed);
+  }
+  void add(double amount) {
+    double previous = value.load(std::memory_order_relaxed);
+    while (!value.compare_exchange_weak(previous, previous + amount,
+                                        std::memory_order_relaxed)) {
+    }
+  }
+  double get() const { return value.load(std::memory_order_relaxed); }
+
+private:
+  std::atomic<double> value{0.0};
+};
+
+/**
+ * @brief 고정 bucket 분포 (frame time 등), percentile은 scrape한 쪽에서 계산
+ */
+class LveHistogram {
+public:
+  // upperBounds는 오름차순, 마지막 +Inf bucket은 자동으로 추가
+  explicit LveHistogram(std::vector<double> upperBounds);
+
+  void observe(double value) {
+    size_t bucket = 0;
+    while (bucket < upperBounds.size() && value > upperBounds[bucket]) {
+      bucket++;
+    }
+    buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    double previous = sum.load(std::memory_order_relaxed);
+    while (!sum.compare_exchange_weak(previous, previous + value,
+                                      std::memory_order_relaxed)) {
+    }
+  }
+
+  struct Snapshot {
+    std::vector<double> upperBounds;
+    // bucket별 누적 개수, 마지막이 +Inf (= 전체 개수)
+    std::vector<uint64_t> cumulativeCounts;
+    double sum = 0.0;
+  };
+
+  /**
+   * @brief 기록 중인 thread를 멈추지 않고 읽음
+   * bucket마다 따로 읽으므로 동시에 기록한 값 하나 정도는 어긋날 수 있음
+   */
+  Snapshot snapshot() const;
+
+  const std::vector<double> &getUpperBounds() const { return upperBounds; }
+
+private:
+  const std::vector<double> upperBounds;
+  std::unique_ptr<std::atomic<uint64_t>[]> buckets;
+  std::atomic<double> sum{0.0};
+};
+
+/**
+ * @brief 이름 붙은 counter, gauge, histogram 등록소
+ *
+ * 등록(생성자 등 초기화 시점)만 lock을 잡고, 반환한 metric은 프로그램이 끝날 때까지
+ * 유효하므로 subsystem이 참조를 보관하고 render thread에서 atomic으로만 갱신
+ * 같은 이름으로 다시 등록하면 기존 metric을 반환 (renderer가 여러 개여도 합산)
+ * LveMetricsServer가 exposition()으로 Prometheus text format을 내보냄
+ */
+class LveMetrics {
+public:
+  // name은 Prometheus metric 이름 규칙 ([a-zA-Z_:][a-zA-Z0-9_:]*)
+  static LveCounter &counter(const std::string &name, const std::string &help);
+  static LveGauge &gauge(const std::string &name, const std::string &help);
+  static LveHistogram &histogram(const std::string &name,
+                                 const std::string &help,
+                                 std::vector<double> upperBounds);
+
+  /**
+   * @brief start부터 factor배씩 count개의 bucket 경계
+   */
+  static std::vector<double> exponentialBuckets(double start, double factor,
+                                                size_t count);
+
+  // frame time용 bucket (초), 240 Hz부터 4 fps까지
+  static std::vector<double> frameTimeBuckets();
+
+  /**
+   * @brief 등록된 모든 metric을 Prometheus text format (0.0.4)으로 반환
+   */
+  static std::string exposition();
+};
+
+} // namespace lve
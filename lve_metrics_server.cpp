@@ -0,0 +1,207 @@
+#include "lve_metrics_server.hpp"
+#include "lve_metrics.hpp"
+
+// std
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+// posix
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace lve {
+
+namespace {
+
+constexpr const char *UNIX_PREFIX = "unix:";
+// stop 요청을 확인하는 간격
+constexpr int POLL_TIMEOUT_MS = 100;
+// 요청을 보내지 않는 client도 이 시간 뒤에는 응답
+constexpr int REQUEST_TIMEOUT_MS = 100;
+
+#ifdef MSG_NOSIGNAL
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+constexpr int SEND_FLAGS = 0;
+#endif
+
+struct SocketAddress {
+  sockaddr_storage storage{};
+  socklen_t length = 0;
+  bool isUnix = false;
+  std::string unixPath;
+};
+
+SocketAddress parseAddress(const std::string &address) {
+  SocketAddress result{};
+  if (address.rfind(UNIX_PREFIX, 0) == 0) {
+    result.isUnix = true;
+    result.unixPath = address.substr(std::strlen(UNIX_PREFIX));
+    auto *unixAddress = reinterpret_cast<sockaddr_un *>(&result.storage);
+    if (result.unixPath.empty() ||
+        result.unixPath.size() >= sizeof(unixAddress->sun_path)) {
+      throw std::runtime_error("invalid unix socket path: " + address);
+    }
+    unixAddress->sun_family = AF_UNIX;
+    std::memcpy(unixAddress->sun_path, result.unixPath.c_str(),
+                result.unixPath.size() + 1);
+    result.length = sizeof(sockaddr_un);
+    return result;
+  }
+
+  const size_t colon = address.rfind(':');
+  auto *inetAddress = reinterpret_cast<sockaddr_in *>(&result.storage);
+  inetAddress->sin_family = AF_INET;
+  if (colon == std::string::npos ||
+      inet_pton(AF_INET, address.substr(0, colon).c_str(),
+                &inetAddress->sin_addr) != 1) {
+    throw std::runtime_error("invalid metrics address: " + address);
+  }
+  const int port = std::atoi(address.c_str() + colon + 1);
+  if (port <= 0 || port > 65535) {
+    throw std::runtime_error("invalid metrics port: " + address);
+  }
+  inetAddress->sin_port = htons(static_cast<uint16_t>(port));
+  result.length = sizeof(sockaddr_in);
+  return result;
+}
+
+bool sendAll(int socket, const std::string &data) {
+  size_t sent = 0;
+  while (sent < data.size()) {
+    const ssize_t written =
+        send(socket, data.data() + sent, data.size() - sent, SEND_FLAGS);
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+    if (written <= 0) {
+      return false;
+    }
+    sent += static_cast<size_t>(written);
+  }
+  return true;
+}
+
+void disableSigpipe(int socket) {
+#ifdef SO_NOSIGPIPE
+  int on = 1;
+  setsockopt(socket, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#else
+  (void)socket;
+#endif
+}
+
+} // namespace
+
+LveMetricsServer::LveMetricsServer(const std::string &address)
+    : address{address} {
+  const SocketAddress socketAddress = parseAddress(address);
+
+  listenSocket =
+      socket(socketAddress.isUnix ? AF_UNIX : AF_INET, SOCK_STREAM, 0);
+  if (listenSocket < 0) {
+    throw std::runtime_error("failed to create metrics socket!");
+  }
+  if (socketAddress.isUnix) {
+    // 이전 실행이 남긴 socket 파일
+    unlink(socketAddress.unixPath.c_str());
+  } else {
+    int reuse = 1;
+    setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+  }
+
+  if (bind(listenSocket,
+           reinterpret_cast<const sockaddr *>(&socketAddress.storage),
+           socketAddress.length) != 0 ||
+      listen(listenSocket, 8) != 0) {
+    const std::string reason = std::strerror(errno);
+    close(listenSocket);
+    throw std::runtime_error("failed to listen on " + address + ": " + reason);
+  }
+
+  thread = std::thread{[this] { serve(); }};
+}
+
+LveMetricsServer::~LveMetricsServer() {
+  running.store(false, std::memory_order_relaxed);
+  thread.join();
+  close(listenSocket);
+  if (address.rfind(UNIX_PREFIX, 0) == 0) {
+    unlink(address.c_str() + std::strlen(UNIX_PREFIX));
+  }
+}
+
+void LveMetricsServer::serve() {
+  while (running.load(std::memory_order_relaxed)) {
+    pollfd listenPoll{listenSocket, POLLIN, 0};
+    if (poll(&listenPoll, 1, POLL_TIMEOUT_MS) <= 0) {
+      continue;
+    }
+    const int client = accept(listenSocket, nullptr, nullptr);
+    if (client < 0) {
+      continue;
+    }
+    disableSigpipe(client);
+
+    // 요청 내용과 무관하게 모든 metric을 응답 -> 요청 header만 버림
+    pollfd clientPoll{client, POLLIN, 0};
+    if (poll(&clientPoll, 1, REQUEST_TIMEOUT_MS) > 0) {
+      char request[1024];
+      recv(client, request, sizeof(request), 0);
+    }
+
+    const std::string body = LveMetrics::exposition();
+    const std::string header =
+        "HTTP/1.0 200 OK\r\n"
+        "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+        "Content-Length: " +
+        std::to_string(body.size()) + "\r\n\r\n";
+    if (sendAll(client, header) && sendAll(client, body)) {
+      scrapes.fetch_add(1, std::memory_order_relaxed);
+    }
+    close(client);
+  }
+}
+
+std::string LveMetricsServer::scrape(const std::string &address) {
+  const SocketAddress socketAddress = parseAddress(address);
+  const int client =
+      socket(socketAddress.isUnix ? AF_UNIX : AF_INET, SOCK_STREAM, 0);
+  if (client < 0) {
+    throw std::runtime_error("failed to create metrics socket!");
+  }
+  disableSigpipe(client);
+  if (connect(client,
+              reinterpret_cast<const sockaddr *>(&socketAddress.storage),
+              socketAddress.length) != 0) {
+    const std::string reason = std::strerror(errno);
+    close(client);
+    throw std::runtime_error("failed to connect to " + address + ": " +
+                             reason);
+  }
+
+  std::string response;
+  if (sendAll(client, "GET /metrics HTTP/1.0\r\n\r\n")) {
+    char buffer[4096];
+    ssize_t received;
+    while ((received = recv(client, buffer, sizeof(buffer), 0)) > 0) {
+      response.append(buffer, static_cast<size_t>(received));
+    }
+  }
+  close(client);
+
+  const size_t bodyStart = response.find("\r\n\r\n");
+  if (response.rfind("HTTP/1.0 200", 0) != 0 ||
+      bodyStart == std::string::npos) {
+    throw std::runtime_error("invalid metrics response from " + address);
+  }
+  return response.substr(bodyStart + 4);
+}
+
+} // namespace lve
@@ -0,0 +1,56 @@
+#pragma once
+
+// std
+#include <atomic>
+#include <string>
+#include <thread>
+
+namespace lve {
+
+/**
+ * @brief LveMetrics를 local socket으로 내보내는 background thread
+ *
+ * 연결마다 HTTP/1.0 응답 하나 (Prometheus text format)를 보내고 닫음
+ * render thread는 metric atomic만 갱신하고 이 thread와 lock을 공유하지 않음
+ *
+ * address 형식
+ *   "unix:/tmp/lve_metrics.sock" -> Unix domain socket
+ *   "127.0.0.1:9464"             -> TCP (IPv4 숫자 주소)
+ */
+class LveMetricsServer {
+public:
+  static constexpr const char *DEFAULT_ADDRESS = "127.0.0.1:9464";
+
+  /**
+   * @brief socket을 열고 thread 시작, 열지 못하면 std::runtime_error
+   */
+  explicit LveMetricsServer(const std::string &address = DEFAULT_ADDRESS);
+  ~LveMetricsServer();
+
+  LveMetricsServer(const LveMetricsServer &) = delete;
+  LveMetricsServer &operator=(const LveMetricsServer &) = delete;
+
+  const std::string &getAddress() const { return address; }
+
+  // 지금까지 응답한 scrape 수
+  uint64_t scrapeCount() const {
+    return scrapes.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief address의 server에 GET /metrics를 보내고 응답 본문을 반환
+   * 연결, 응답에 실패하면 std::runtime_error
+   */
+  static std::string scrape(const std::string &address);
+
+private:
+  void serve();
+
+  const std::string address;
+  int listenSocket = -1;
+  std::atomic<bool> running{true};
+  std::atomic<uint64_t> scrapes{0};
+  std::thread thread;
+};
+
+} // namespace lve
@@ -1,57 +1,79 @@
 #include "lve_model.hpp"
-#include "lve_utils.hpp"
+#include "lve_log.hpp"
+#include "lve_metrics.hpp"
+#include "lve_profiler.hpp"
+#include "lve_vulkan_dispatch.hpp"
 
 // libs
 #define TINYOBJLOADER_IMPLEMENTATION
 #include <tiny_obj_loader.h>
-// hash function
-#define GLM_ENABLE_EXPERIMENTAL
-#include <glm/gtx/hash.hpp>
 
 // std
 #include <cassert>
+#include <chrono>
 #include <cstring>
-#include <iostream>
 #include <unordered_map>
 
-namespace std {
-template <> struct hash<lve::LveModel::Vertex> {
-  size_t operator()(lve::LveModel::Vertex const &vertex) const {
-    size_t seed = 0;
-    lve::hashCombine(seed, vertex.position, vertex.color, vertex.normal,
-                     vertex.uv);
-    return seed;
-  }
+namespace lve {
+
+namespace {
+
+// model을 읽는 모든 thread가 같이 갱신하는 asset loader metric
+struct ModelMetrics {
+  LveCounter &loads =
+      LveMetrics::counter("lve_model_loads_total", "Models loaded from file");
+  LveHistogram &loadSeconds = LveMetrics::histogram(
+      "lve_model_load_seconds", "Time to parse and upload a model file",
+      LveMetrics::exponentialBuckets(0.001, 4.0, 8));
+  LveCounter &uploadBytes = LveMetrics::counter(
+      "lve_upload_bytes_total", "Bytes uploaded to device local buffers");
 };
-} // namespace std
 
-namespace lve {
+ModelMetrics &modelMetrics() {
+  static ModelMetrics metrics{};
+  return metrics;
+}
+
+} // namespace
 
 LveModel::LveModel(LveDevice &device, const LveModel::Builder &builder)
     : lveDevice{device} {
+  if (!builder.vertices.empty()) {
+    boundingBox = {builder.vertices[0].position, builder.vertices[0].position};
+    for (const auto &vertex : builder.vertices) {
+      boundingBox.min = glm::min(boundingBox.min, vertex.position);
+      boundingBox.max = glm::max(boundingBox.max, vertex.position);
+    }
+  }
   createVertexBuffers(builder.vertices);
   createIndexBuffers(builder.indices);
 }
 
 LveModel::~LveModel() {
-  vkDestroyBuffer(lveDevice.device(), vertexBuffer, nullptr);
-  vkFreeMemory(lveDevice.device(), vertexBufferMemory, nullptr);
+  // 이미 기록한 frame이 아직 이 buffer를 읽고 있을 수 있음
+  lveDevice.deferDestroyBuffer(vertexBuffer, vertexBufferMemory);
 
   if (hasIndexBuffer) {
-    vkDestroyBuffer(lveDevice.device(), indexBuffer, nullptr);
-    vkFreeMemory(lveDevice.device(), indexBufferMemory, nullptr);
+    lveDevice.deferDestroyBuffer(indexBuffer, indexBufferMemory);
   }
 }
 
 std::unique_ptr<LveModel>
 LveModel::createModelFromFile(LveDevice &device, const std::string &filepath) {
+  const auto start = std::chrono::steady_clock::now();
   Builder builder{};
   builder.loadModel(filepath);
 
   // index buffer로 계산할때와 vertex buffer로 계산할때 차이
-  std::cout << "Vertex count " << builder.vertices.size() << std::endl;
-
-  return std::make_unique<LveModel>(device, builder);
+  LVE_LOG_INFO << "Vertex count " << builder.vertices.size();
+
+  auto model = std::make_unique<LveModel>(device, builder);
+  auto &metrics = modelMetrics();
+  metrics.loads.add();
+  metrics.loadSeconds.observe(std::chrono::duration<double>(
+                                  std::chrono::steady_clock::now() - start)
+                                  .count());
+  return model;
 }
 
 void LveModel::createVertexBuffers(const std::vector<Vertex> &vertices) {
@@ -60,33 +82,13 @@ void LveModel::createVertexBuffers(const std::vector<Vertex> &vertices) {
   assert(vertexCount >= 3 && "Vertex count must be at least 3");
   VkDeviceSize bufferSize = sizeof(vertices[0]) * vertexCount;
 
-  VkBuffer stagingBuffer;
-  VkDeviceMemory stagingBufferMemory;
-
-  // 버퍼 생성 -> VK_BUFFER_USAGE_TRANSFER_SRC_BIT
-  // 해당 옵션이 vulkan에게 이 버퍼가 다른 버퍼로 복사될 것이라고 알려줌
-  // VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT -> staging buffer는 host에서 볼수있음
-  // VK_MEMORY_PROPERTY_HOST_COHERENT_BIT-> host와device간의 메모리 일관성을유지
-  lveDevice.createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-                             VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                         stagingBuffer, stagingBufferMemory);
-
-  void *data;
-  //  장치 메모리에 매핑된 호스트 메모리 생성, 매핑된 메모리 가져오기
-  vkMapMemory(lveDevice.device(), stagingBufferMemory, 0, bufferSize, 0, &data);
-  memcpy(data, vertices.data(), static_cast<size_t>(bufferSize));
-  vkUnmapMemory(lveDevice.device(), stagingBufferMemory);
-
-  lveDevice.createBuffer(
-      bufferSize,
-      VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vertexBuffer, vertexBufferMemory);
-
-  lveDevice.copyBuffer(stagingBuffer, vertexBuffer, bufferSize);
-
-  vkDestroyBuffer(lveDevice.device(), stagingBuffer, nullptr);
-  vkFreeMemory(lveDevice.device(), stagingBufferMemory, nullptr);
+  // staging buffer 없이 바로 쓸 수 있으면 direct write (LveDevice가 결정)
+  auto &metrics = modelMetrics();
+  lveDevice.createDeviceLocalBuffer(
+      vertices.data(), bufferSize,
+      VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+      vertexBuffer, vertexBufferMemory, LveMemoryCategory::GEOMETRY);
+  metrics.uploadBytes.add(bufferSize);
 }
 
 void LveModel::createIndexBuffers(const std::vector<uint32_t> &indices) {
@@ -99,36 +101,54 @@ void LveModel::createIndexBuffers(const std::vector<uint32_t> &indices) {
   }
 
   VkDeviceSize bufferSize = sizeof(indices[0]) * indexCount;
-  VkBuffer stagingBuffer;
-  VkDeviceMemory stagingBufferMemory;
-
-  lveDevice.createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-                             VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                         stagingBuffer, stagingBufferMemory);
-  void *data;
 
-  vkMapMemory(lveDevice.device(), stagingBufferMemory, 0, bufferSize, 0, &data);
-  memcpy(data, indices.data(), static_cast<size_t>(bufferSize));
-  vkUnmapMemory(lveDevice.device(), stagingBufferMemory);
-
-  lveDevice.createBuffer(
-      bufferSize,
-      VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, indexBuffer, indexBufferMemory);
+  auto &metrics = modelMetrics();
+  lveDevice.createDeviceLocalBuffer(
+      indices.data(), bufferSize,
+      VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+      indexBuffer, indexBufferMemory, LveMemoryCategory::GEOMETRY);
+  metrics.uploadBytes.add(bufferSize);
+}
 
-  lveDevice.copyBuffer(stagingBuffer, indexBuffer, bufferSize);
+LveModel::Builder LveModel::readBack() {
+  // device local buffer -> host visible staging buffer -> dst
+  auto download = [&](VkBuffer buffer, VkDeviceSize bufferSize, void *dst) {
+    VkBuffer stagingBuffer;
+    VkDeviceMemory stagingBufferMemory;
+    lveDevice.createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                           VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                               VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                           stagingBuffer, stagingBufferMemory,
+                           LveMemoryCategory::STAGING);
+    lveDevice.copyBuffer(buffer, stagingBuffer, bufferSize);
+
+    void *data;
+    vkMapMemory(lveDevice.device(), stagingBufferMemory, 0, bufferSize, 0,
+                &data);
+    memcpy(dst, data, static_cast<size_t>(bufferSize));
+    vkUnmapMemory(lveDevice.device(), stagingBufferMemory);
+
+    lveDevice.destroyBuffer(stagingBuffer, stagingBufferMemory);
+  };
 
-  vkDestroyBuffer(lveDevice.device(), stagingBuffer, nullptr);
-  vkFreeMemory(lveDevice.device(), stagingBufferMemory, nullptr);
+  Builder builder{};
+  builder.vertices.resize(vertexCount);
+  download(vertexBuffer, sizeof(Vertex) * vertexCount,
+           builder.vertices.data());
+  if (hasIndexBuffer) {
+    builder.indices.resize(indexCount);
+    download(indexBuffer, sizeof(uint32_t) * indexCount,
+             builder.indices.data());
+  }
+  return builder;
 }
 
 void LveModel::draw(VkCommandBuffer commandBuffer) {
   //   vkCmdDraw(commandBuffer, vertexCount, 1, 0, 0);
   if (hasIndexBuffer) {
-    vkCmdDrawIndexed(commandBuffer, indexCount, 1, 0, 0, 0);
+    vkd::cmdDrawIndexed(commandBuffer, indexCount, 1, 0, 0, 0);
   } else {
-    vkCmdDraw(commandBuffer, vertexCount, 1, 0, 0);
+    vkd::cmdDraw(commandBuffer, vertexCount, 1, 0, 0);
   }
 }
 
@@ -136,10 +156,11 @@ void LveModel::bind(VkCommandBuffer commandBuffer) {
   VkBuffer buffers[] = {vertexBuffer};
   VkDeviceSize offsets[] = {0};
 
-  vkCmdBindVertexBuffers(commandBuffer, 0, 1, buffers, offsets);
+  vkd::cmdBindVertexBuffers(commandBuffer, 0, 1, buffers, offsets);
 
   if (hasIndexBuffer) {
-    vkCmdBindIndexBuffer(commandBuffer, indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+    vkd::cmdBindIndexBuffer(commandBuffer, indexBuffer, 0,
+                            VK_INDEX_TYPE_UINT32);
   }
 }
 
@@ -174,6 +195,7 @@ LveModel::Vertex::getAttributeDescriptions() {
 }
 
 void LveModel::Builder::loadModel(const std::string &filepath) {
+  LVE_PROFILE_FUNCTION();
   tinyobj::attrib_t attrib;
   std::vector<tinyobj::shape_t> shapes;
   std::vector<tinyobj::material_t> materials;
@@ -184,10 +206,12 @@ void LveModel::Builder::loadModel(const std::string &filepath) {
     throw std::runtime_error(warn + err);
   }
 
-  vertices.clear();
-  indices.clear();
-
-  std::unordered_map<Vertex, uint32_t> uniqueVertices{};
+  size_t indexCount = 0;
+  for (const auto &shape : shapes) {
+    indexCount += shape.mesh.indices.size();
+  }
+  std::vector<Vertex> stream;
+  stream.reserve(indexCount);
 
   for (const auto &shape : shapes) {
     for (const auto &index : shape.mesh.indices) {
@@ -228,14 +252,24 @@ void LveModel::Builder::loadModel(const std::string &filepath) {
         };
       }
 
-      //   vertices.push_back(vertex);
+      stream.push_back(vertex);
+    }
+  }
 
-      if (uniqueVertices.count(vertex) == 0) {
-        uniqueVertices[vertex] = static_cast<uint32_t>(vertices.size());
-        vertices.push_back(vertex);
-      }
-      indices.push_back(uniqueVertices[vertex]);
+  weldVertices(stream);
+}
+
+void LveModel::Builder::weldVertices(const std::vector<Vertex> &stream) {
+  vertices.clear();
+  indices.clear();
+
+  std::unordered_map<Vertex, uint32_t> uniqueVertices{};
+  for (const auto &vertex : stream) {
+    if (uniqueVertices.count(vertex) == 0) {
+      uniqueVertices[vertex] = static_cast<uint32_t>(vertices.size());
+      vertices.push_back(vertex);
     }
+    indices.push_back(uniqueVertices[vertex]);
   }
 }
 
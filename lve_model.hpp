@@ -1,11 +1,16 @@
 #pragma once
 
+#include "lve_bvh.hpp"
 #include "lve_device.hpp"
+#include "lve_utils.hpp"
 
 // libs
 #define GLM_FORCE_RADIANS
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
 #include <glm/glm.hpp>
+// hash function
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/hash.hpp>
 
 // std
 #include <memory>
@@ -44,6 +49,12 @@ public:
     std::vector<uint32_t> indices{};
 
     void loadModel(const std::string &filepath);
+
+    /**
+     * @brief index 순서의 vertex stream에서 중복 vertex를 합쳐서
+     * vertices, indices를 채움 (loadModel과 benchmark가 같이 사용)
+     */
+    void weldVertices(const std::vector<Vertex> &stream);
   };
 
   LveModel(LveDevice &device, const LveModel::Builder &builder);
@@ -58,12 +69,27 @@ public:
   void bind(VkCommandBuffer commandBuffer);
   void draw(VkCommandBuffer commandBuffer);
 
+  // model space AABB -> culling, BVH 삽입용
+  const LveAabb &getBoundingBox() const { return boundingBox; }
+
+  uint32_t getVertexCount() const { return vertexCount; }
+  // index buffer가 없으면 0
+  uint32_t getIndexCount() const { return hasIndexBuffer ? indexCount : 0; }
+
+  /**
+   * @brief GPU buffer 내용을 다시 읽어서 Builder로 반환 (frame capture용)
+   * staging buffer로 복사하고 queue를 기다림 -> frame 기록 중에는 호출하지 않음
+   */
+  Builder readBack();
+
 private:
   void createVertexBuffers(const std::vector<Vertex> &vertices);
   void createIndexBuffers(const std::vector<uint32_t> &indices);
 
   LveDevice &lveDevice;
 
+  LveAabb boundingBox{};
+
   VkBuffer vertexBuffer;
   VkDeviceMemory vertexBufferMemory;
   uint32_t vertexCount;
@@ -74,4 +100,16 @@ private:
   uint32_t indexCount;
 };
 
-} // namespace lve
\ No newline at end of file
+} // namespace lve
+
+// Builder::loadModel()의 중복 vertex 제거(welding)에 사용
+namespace std {
+template <> struct hash<lve::LveModel::Vertex> {
+  size_t operator()(lve::LveModel::Vertex const &vertex) const {
+    size_t seed = 0;
+    lve::hashCombine(seed, vertex.position, vertex.color, vertex.normal,
+                     vertex.uv);
+    return seed;
+  }
+};
+} // namespace std
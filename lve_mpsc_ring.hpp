@@ -0,0 +1,86 @@
+#pragma once
+
+// std
+#include <atomic>
+#include <cstddef>
+
+namespace lve {
+
+/**
+ * @brief producer 여러 개, consumer 하나 사이의 고정 크기 lock-free ring
+ *
+ * slot마다 sequence 번호를 두고 producer는 CAS로 칸을 예약한 뒤 채움
+ * (bounded MPMC queue의 consumer 쪽만 단순화)
+ * 가득 차면 push()가 false를 반환 (producer가 기다리지 않음)
+ * 원소가 크면 new로 만들어서 사용 (stack에 두지 않도록)
+ */
+template <typename T, size_t Capacity> class LveMpscRing {
+  static_assert((Capacity & (Capacity - 1)) == 0,
+                "Ring capacity must be a power of two");
+
+public:
+  LveMpscRing() {
+    for (size_t i = 0; i < Capacity; i++) {
+      slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  LveMpscRing(const LveMpscRing &) = delete;
+  LveMpscRing &operator=(const LveMpscRing &) = delete;
+
+  // 어느 thread에서나 호출 가능
+  bool push(const T &value) {
+    size_t head = writeIndex.load(std::memory_order_relaxed);
+    Slot *slot;
+    for (;;) {
+      slot = &slots[head & (Capacity - 1)];
+      const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(sequence - head);
+      if (diff == 0) {
+        // 비어 있는 칸 -> 예약
+        if (writeIndex.compare_exchange_weak(head, head + 1,
+                                             std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        // consumer가 아직 비우지 않은 칸 -> 가득 참
+        return false;
+      } else {
+        // 다른 producer가 먼저 예약함
+        head = writeIndex.load(std::memory_order_relaxed);
+      }
+    }
+    slot->value = value;
+    slot->sequence.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // consumer 전용, 비어 있거나 다음 칸을 아직 채우는 중이면 nullptr
+  const T *peek() const {
+    const Slot &slot = slots[readIndex & (Capacity - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != readIndex + 1) {
+      return nullptr;
+    }
+    return &slot.value;
+  }
+
+  // consumer 전용, peek()으로 확인한 원소 제거
+  void pop() {
+    slots[readIndex & (Capacity - 1)].sequence.store(
+        readIndex + Capacity, std::memory_order_release);
+    readIndex++;
+  }
+
+private:
+  struct Slot {
+    std::atomic<size_t> sequence{0};
+    T value;
+  };
+
+  Slot slots[Capacity];
+  alignas(64) std::atomic<size_t> writeIndex{0};
+  // consumer만 접근
+  alignas(64) size_t readIndex = 0;
+};
+
+} // namespace lve
@@ -0,0 +1,314 @@
+#include "lve_overdraw.hpp"
+#include "lve_vulkan_dispatch.hpp"
+
+// std
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace lve {
+
+namespace {
+
+// IEEE half -> float, blend 결과는 2048까지 정확한 정수
+float halfToFloat(uint16_t value) {
+  const int exponent = (value >> 10) & 0x1f;
+  const int mantissa = value & 0x3ff;
+  float magnitude;
+  if (exponent == 0) {
+    magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+  } else if (exponent == 0x1f) {
+    magnitude = std::numeric_limits<float>::infinity();
+  } else {
+    magnitude = std::ldexp(static_cast<float>(mantissa + 0x400), exponent - 25);
+  }
+  return (value & 0x8000) != 0 ? -magnitude : magnitude;
+}
+
+} // namespace
+
+LveOverdraw::LveOverdraw(LveDevice &device, uint32_t frameCount)
+    : lveDevice{device}, readbacks(frameCount) {
+  createRenderPass();
+}
+
+LveOverdraw::~LveOverdraw() {
+  // 마지막으로 기록한 frame이 아직 target과 buffer를 쓰고 있을 수 있음
+  retireTarget();
+  for (auto &readback : readbacks) {
+    if (readback.buffer != VK_NULL_HANDLE) {
+      lveDevice.deferDestroyBuffer(readback.buffer, readback.memory,
+                                   lveDevice.submittedSubmission());
+    }
+  }
+  VkDevice device = lveDevice.device();
+  VkRenderPass pass = renderPass;
+  lveDevice.deferDestroy(
+      [device, pass] { vkDestroyRenderPass(device, pass, nullptr); }, 0,
+      lveDevice.submittedSubmission());
+}
+
+void LveOverdraw::createRenderPass() {
+  VkAttachmentDescription colorAttachment = {};
+  colorAttachment.format = TARGET_FORMAT;
+  colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+  colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+  colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+  colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+  colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+  colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+  // pass가 끝나면 바로 buffer로 복사
+  colorAttachment.finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+  VkAttachmentReference colorAttachmentRef = {};
+  colorAttachmentRef.attachment = 0;
+  colorAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+  VkSubpassDescription subpass = {};
+  subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+  subpass.colorAttachmentCount = 1;
+  subpass.pColorAttachments = &colorAttachmentRef;
+
+  std::array<VkSubpassDependency, 2> dependencies{};
+  // 이전 frame의 복사가 끝난 뒤에 clear
+  dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+  dependencies[0].dstSubpass = 0;
+  dependencies[0].srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+  dependencies[0].srcAccessMask = 0;
+  dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+  dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT |
+                                  VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+  // blend 결과를 다 쓴 뒤에 복사
+  dependencies[1].srcSubpass = 0;
+  dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+  dependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+  dependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+  dependencies[1].dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+  dependencies[1].dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+  VkRenderPassCreateInfo renderPassInfo = {};
+  renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+  renderPassInfo.attachmentCount = 1;
+  renderPassInfo.pAttachments = &colorAttachment;
+  renderPassInfo.subpassCount = 1;
+  renderPassInfo.pSubpasses = &subpass;
+  renderPassInfo.dependencyCount = static_cast<uint32_t>(dependencies.size());
+  renderPassInfo.pDependencies = dependencies.data();
+
+  if (vkCreateRenderPass(lveDevice.device(), &renderPassInfo, nullptr,
+                         &renderPass) != VK_SUCCESS) {
+    throw std::runtime_error("failed to create overdraw render pass!");
+  }
+}
+
+void LveOverdraw::createTarget(VkExtent2D extent) {
+  VkImageCreateInfo imageInfo{};
+  imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+  imageInfo.imageType = VK_IMAGE_TYPE_2D;
+  imageInfo.extent.width = extent.width;
+  imageInfo.extent.height = extent.height;
+  imageInfo.extent.depth = 1;
+  imageInfo.mipLevels = 1;
+  imageInfo.arrayLayers = 1;
+  imageInfo.format = TARGET_FORMAT;
+  imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+  imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+  imageInfo.usage =
+      VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+  imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+  imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+  imageInfo.flags = 0;
+
+  lveDevice.createImageWithInfo(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                image, imageMemory, LveMemoryCategory::OTHER);
+
+  VkImageViewCreateInfo viewInfo{};
+  viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+  viewInfo.image = image;
+  viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+  viewInfo.format = TARGET_FORMAT;
+  viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  viewInfo.subresourceRange.baseMipLevel = 0;
+  viewInfo.subresourceRange.levelCount = 1;
+  viewInfo.subresourceRange.baseArrayLayer = 0;
+  viewInfo.subresourceRange.layerCount = 1;
+
+  if (vkCreateImageView(lveDevice.device(), &viewInfo, nullptr, &imageView) !=
+      VK_SUCCESS) {
+    throw std::runtime_error("failed to create overdraw image view!");
+  }
+
+  VkFramebufferCreateInfo framebufferInfo = {};
+  framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+  framebufferInfo.renderPass = renderPass;
+  framebufferInfo.attachmentCount = 1;
+  framebufferInfo.pAttachments = &imageView;
+  framebufferInfo.width = extent.width;
+  framebufferInfo.height = extent.height;
+  framebufferInfo.layers = 1;
+
+  if (vkCreateFramebuffer(lveDevice.device(), &framebufferInfo, nullptr,
+                          &framebuffer) != VK_SUCCESS) {
+    throw std::runtime_error("failed to create overdraw framebuffer!");
+  }
+  targetExtent = extent;
+}
+
+void LveOverdraw::retireTarget() {
+  if (image == VK_NULL_HANDLE) {
+    return;
+  }
+  // 기록 중인 frame은 아직 이 target을 쓰지 않았음
+  const uint64_t lastUse = lveDevice.submittedSubmission();
+  lveDevice.deferDestroyFramebuffer(framebuffer, lastUse);
+  lveDevice.deferDestroyImageView(imageView, lastUse);
+  lveDevice.deferDestroyImage(image, imageMemory, lastUse);
+  framebuffer = VK_NULL_HANDLE;
+  imageView = VK_NULL_HANDLE;
+  image = VK_NULL_HANDLE;
+  imageMemory = VK_NULL_HANDLE;
+  targetExtent = {};
+}
+
+void LveOverdraw::resizeReadback(Readback &readback, VkDeviceSize size) {
+  if (readback.size >= size) {
+    return;
+  }
+  // 이 slot의 fence를 기다렸으므로 이전 buffer는 GPU가 다 썼음
+  if (readback.buffer != VK_NULL_HANDLE) {
+    lveDevice.deferDestroyBuffer(readback.buffer, readback.memory,
+                                 lveDevice.submittedSubmission());
+  }
+  lveDevice.createBuffer(size, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                             VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                         readback.buffer, readback.memory,
+                         LveMemoryCategory::STAGING);
+  readback.size = size;
+
+  // 버퍼를 파괴할 때까지 mapping 유지
+  void *data;
+  vkMapMemory(lveDevice.device(), readback.memory, 0, size, 0, &data);
+  readback.mapped = static_cast<const uint16_t *>(data);
+}
+
+void LveOverdraw::beginPass(VkCommandBuffer commandBuffer, int frameIndex,
+                            VkExtent2D extent) {
+  assert(currentReadback == nullptr &&
+         "Can't call beginPass while overdraw pass is in progress");
+  assert(frameIndex >= 0 &&
+         static_cast<size_t>(frameIndex) < readbacks.size() &&
+         "Overdraw frame index out of range");
+
+  Readback &readback = readbacks[frameIndex];
+  if (readback.pending) {
+    resolve(readback);
+  }
+
+  if (extent.width != targetExtent.width ||
+      extent.height != targetExtent.height) {
+    retireTarget();
+    createTarget(extent);
+  }
+  resizeReadback(readback, static_cast<VkDeviceSize>(extent.width) *
+                               extent.height * sizeof(uint16_t));
+  readback.extent = extent;
+  currentReadback = &readback;
+
+  VkRenderPassBeginInfo renderPassInfo{};
+  renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+  renderPassInfo.renderPass = renderPass;
+  renderPassInfo.framebuffer = framebuffer;
+  renderPassInfo.renderArea.offset = {0, 0};
+  renderPassInfo.renderArea.extent = extent;
+
+  VkClearValue clearValue{};
+  clearValue.color = {0.0f, 0.0f, 0.0f, 0.0f};
+  renderPassInfo.clearValueCount = 1;
+  renderPassInfo.pClearValues = &clearValue;
+  vkd::cmdBeginRenderPass(commandBuffer, &renderPassInfo,
+                          VK_SUBPASS_CONTENTS_INLINE);
+
+  VkViewport viewport{};
+  viewport.x = 0.0f;
+  viewport.y = 0.0f;
+  viewport.width = static_cast<float>(extent.width);
+  viewport.height = static_cast<float>(extent.height);
+  viewport.minDepth = 0.0f;
+  viewport.maxDepth = 1.0f;
+
+  VkRect2D scissor{{0, 0}, extent};
+  vkd::cmdSetViewport(commandBuffer, 0, 1, &viewport);
+  vkd::cmdSetScissor(commandBuffer, 0, 1, &scissor);
+}
+
+void LveOverdraw::endPass(VkCommandBuffer commandBuffer) {
+  assert(currentReadback != nullptr &&
+         "Can't call endPass if overdraw pass is not in progress");
+  vkd::cmdEndRenderPass(commandBuffer);
+
+  // render pass가 끝나면 target은 TRANSFER_SRC_OPTIMAL
+  VkBufferImageCopy region{};
+  region.bufferOffset = 0;
+  region.bufferRowLength = 0;
+  region.bufferImageHeight = 0;
+  region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  region.imageSubresource.mipLevel = 0;
+  region.imageSubresource.baseArrayLayer = 0;
+  region.imageSubresource.layerCount = 1;
+  region.imageOffset = {0, 0, 0};
+  region.imageExtent = {targetExtent.width, targetExtent.height, 1};
+  vkd::cmdCopyImageToBuffer(commandBuffer, image,
+                            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                            currentReadback->buffer, 1, &region);
+
+  // fence만으로는 host에서 보이지 않음 -> host read barrier
+  VkBufferMemoryBarrier barrier{};
+  barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+  barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+  barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+  barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.buffer = currentReadback->buffer;
+  barrier.offset = 0;
+  barrier.size = VK_WHOLE_SIZE;
+  vkd::cmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                          VK_PIPELINE_STAGE_HOST_BIT, 0, 0, nullptr, 1,
+                          &barrier, 0, nullptr);
+
+  currentReadback->pending = true;
+  currentReadback = nullptr;
+}
+
+void LveOverdraw::resolve(Readback &readback) {
+  readback.pending = false;
+  const size_t pixelCount =
+      static_cast<size_t>(readback.extent.width) * readback.extent.height;
+  if (pixelCount == 0) {
+    return;
+  }
+
+  uint64_t fragments = 0;
+  size_t covered = 0;
+  uint32_t maxCount = 0;
+  for (size_t i = 0; i < pixelCount; i++) {
+    const auto count =
+        static_cast<uint32_t>(std::lround(halfToFloat(readback.mapped[i])));
+    fragments += count;
+    covered += count > 0 ? 1 : 0;
+    maxCount = std::max(maxCount, count);
+  }
+
+  stats.width = readback.extent.width;
+  stats.height = readback.extent.height;
+  stats.averageOverdraw = static_cast<double>(fragments) / pixelCount;
+  stats.coveredAverageOverdraw =
+      covered > 0 ? static_cast<double>(fragments) / covered : 0.0;
+  stats.maxOverdraw = maxCount;
+  stats.coverage = static_cast<double>(covered) / pixelCount;
+}
+
+} // namespace lve
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "lve_device.hpp"
+
+// std
+#include <cstdint>
+#include <vector>
+
+namespace lve {
+
+/**
+ * @brief pixel마다 fragment 수를 세는 overdraw 측정 pass
+ *
+ * LvePipeline::overdrawPipelineConfigInfo()로 만든 pipeline을 이 render pass에서
+ * 그리면 R16_SFLOAT target에 fragment 수가 누적됨
+ * pass가 끝나면 target을 frame slot별 host buffer로 복사하고, 같은 slot을 다시
+ * 쓸 때(fence 대기가 끝난 뒤) 읽으므로 기다리지 않음
+ */
+class LveOverdraw {
+public:
+  static constexpr VkFormat TARGET_FORMAT = VK_FORMAT_R16_SFLOAT;
+
+  struct Stats {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    // 화면 전체 pixel 기준 평균 fragment 수
+    double averageOverdraw = 0.0;
+    // 한 번 이상 그려진 pixel 기준 평균
+    double coveredAverageOverdraw = 0.0;
+    uint32_t maxOverdraw = 0;
+    // 그려진 pixel 비율 (0 ~ 1)
+    double coverage = 0.0;
+  };
+
+  /**
+   * @param frameCount beginPass()에 넘길 frame index 수 (frame in flight 최대값)
+   */
+  LveOverdraw(LveDevice &device, uint32_t frameCount);
+  ~LveOverdraw();
+
+  LveOverdraw(const LveOverdraw &) = delete;
+  LveOverdraw &operator=(const LveOverdraw &) = delete;
+
+  // overdraw pipeline을 만들 때 사용
+  VkRenderPass getRenderPass() const { return renderPass; }
+
+  /**
+   * @brief 이 slot의 이전 결과를 읽고 overdraw render pass 시작
+   * extent가 바뀌면 target을 다시 만듦 (이전 target은 deferred destruction)
+   * viewport, scissor도 설정
+   */
+  void beginPass(VkCommandBuffer commandBuffer, int frameIndex,
+                 VkExtent2D extent);
+
+  /**
+   * @brief render pass를 끝내고 target을 이 slot의 host buffer로 복사
+   */
+  void endPass(VkCommandBuffer commandBuffer);
+
+  // 마지막으로 결과를 읽은 frame
+  const Stats &getStats() const { return stats; }
+
+private:
+  struct Readback {
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize size = 0;
+    const uint16_t *mapped = nullptr;
+    VkExtent2D extent{};
+    bool pending = false;
+  };
+
+  void createRenderPass();
+  void createTarget(VkExtent2D extent);
+  void retireTarget();
+  void resizeReadback(Readback &readback, VkDeviceSize size);
+  void resolve(Readback &readback);
+
+  LveDevice &lveDevice;
+  VkRenderPass renderPass = VK_NULL_HANDLE;
+
+  VkImage image = VK_NULL_HANDLE;
+  VkDeviceMemory imageMemory = VK_NULL_HANDLE;
+  VkImageView imageView = VK_NULL_HANDLE;
+  VkFramebuffer framebuffer = VK_NULL_HANDLE;
+  VkExtent2D targetExtent{};
+
+  std::vector<Readback> readbacks;
+  Readback *currentReadback = nullptr;
+
+  Stats stats{};
+};
+
+} // namespace lve
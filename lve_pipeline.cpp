@@ -1,5 +1,6 @@
 #include "lve_pipeline.hpp"
 #include "lve_model.hpp"
+#include "lve_vulkan_dispatch.hpp"
 
 // std
 #include <cassert>
@@ -12,14 +13,16 @@ namespace lve {
 LvePipeline::LvePipeline(LveDevice &device, const std::string &vertFilepath,
                          const std::string &fragFilepath,
                          const PipelineConfigInfo &configInfo)
-    : lveDevice{device} {
+    : lveDevice{device}, vertFilepath{vertFilepath},
+      fragFilepath{fragFilepath} {
   createGraphicsPipeline(vertFilepath, fragFilepath, configInfo);
 }
 
 LvePipeline::~LvePipeline() {
   vkDestroyShaderModule(lveDevice.device(), vertShaderModule, nullptr);
   vkDestroyShaderModule(lveDevice.device(), fragShaderModule, nullptr);
-  vkDestroyPipeline(lveDevice.device(), graphicsPipeline, nullptr);
+  // shader module은 pipeline 생성 후 필요 없지만 pipeline은 기록된 frame이 사용
+  lveDevice.deferDestroyPipeline(graphicsPipeline);
 }
 
 std::vector<char> LvePipeline::readFile(const std::string &filepath) {
@@ -145,8 +148,8 @@ void LvePipeline::createShaderModule(const std::vector<char> &code,
 }
 
 void LvePipeline::bind(VkCommandBuffer commandBuffer) {
-  vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                    graphicsPipeline);
+  vkd::cmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                       graphicsPipeline);
 }
 
 void LvePipeline::defaultPipelineConfigInfo(PipelineConfigInfo &configInfo) {
@@ -243,4 +246,22 @@ void LvePipeline::defaultPipelineConfigInfo(PipelineConfigInfo &configInfo) {
   //   return configInfo;
 }
 
+void LvePipeline::overdrawPipelineConfigInfo(PipelineConfigInfo &configInfo) {
+  defaultPipelineConfigInfo(configInfo);
+
+  // dst = src + dst -> attachment 값이 그 pixel의 fragment 수
+  configInfo.colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT;
+  configInfo.colorBlendAttachment.blendEnable = VK_TRUE;
+  configInfo.colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
+  configInfo.colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE;
+  configInfo.colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
+  configInfo.colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+  configInfo.colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+  configInfo.colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
+
+  // overdraw pass에는 depth attachment가 없음
+  configInfo.depthStencilInfo.depthTestEnable = VK_FALSE;
+  configInfo.depthStencilInfo.depthWriteEnable = VK_FALSE;
+}
+
 } // namespace lve
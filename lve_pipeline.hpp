@@ -44,6 +44,10 @@ public:
    */
   void bind(VkCommandBuffer commandBuffer);
 
+  // 생성에 사용한 shader 경로 (frame capture에서 pipeline을 다시 만들 때 사용)
+  const std::string &getVertFilepath() const { return vertFilepath; }
+  const std::string &getFragFilepath() const { return fragFilepath; }
+
   /**
    * @brief graphics pipeline 초기화
    *
@@ -51,6 +55,15 @@ public:
    */
   static void defaultPipelineConfigInfo(PipelineConfigInfo &configInfo);
 
+  /**
+   * @brief overdraw 측정용 설정, default 설정에서 blend만 바꿈
+   * fragment마다 1을 R channel에 더함 (additive blend)
+   * depth test를 끄므로 가려진 fragment까지 모두 셈
+   *
+   * @param configInfo
+   */
+  static void overdrawPipelineConfigInfo(PipelineConfigInfo &configInfo);
+
 private:
   /**
    * @brief 바이너리 모드로 읽어와 그 데이터를 벡터 형태로 반환
@@ -83,6 +96,8 @@ private:
                           VkShaderModule *shaderModule);
 
   LveDevice &lveDevice;
+  std::string vertFilepath;
+  std::string fragFilepath;
   VkPipeline graphicsPipeline;
   VkShaderModule vertShaderModule;
   VkShaderModule fragShaderModule;
@@ -0,0 +1,173 @@
+#include "lve_pipeline_statistics.hpp"
+#include "lve_vulkan_dispatch.hpp"
+
+// std
+#include <cassert>
+#include <stdexcept>
+
+namespace lve {
+
+namespace {
+
+// Counters의 member 순서와 같은 bit 순서
+constexpr VkQueryPipelineStatisticFlags STATISTIC_FLAGS =
+    VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT |
+    VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |
+    VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+    VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT |
+    VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+    VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT;
+constexpr uint32_t STATISTIC_COUNT = 6;
+// query 하나의 결과 = counter + availability
+constexpr uint32_t RESULT_STRIDE = STATISTIC_COUNT + 1;
+
+} // namespace
+
+LvePipelineStatistics::Counters &
+LvePipelineStatistics::Counters::operator+=(const Counters &other) {
+  inputVertices += other.inputVertices;
+  inputPrimitives += other.inputPrimitives;
+  vertexInvocations += other.vertexInvocations;
+  clippingInvocations += other.clippingInvocations;
+  clippingPrimitives += other.clippingPrimitives;
+  fragmentInvocations += other.fragmentInvocations;
+  return *this;
+}
+
+LvePipelineStatistics::LvePipelineStatistics(LveDevice &device,
+                                             uint32_t frameCount)
+    : lveDevice{device}, frames(frameCount) {
+  supported = lveDevice.enabledFeatures.pipelineStatisticsQuery == VK_TRUE;
+  if (!supported) {
+    return;
+  }
+
+  VkQueryPoolCreateInfo queryPoolInfo{};
+  queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+  queryPoolInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+  queryPoolInfo.queryCount = MAX_PASSES;
+  queryPoolInfo.pipelineStatistics = STATISTIC_FLAGS;
+
+  for (auto &frame : frames) {
+    if (vkCreateQueryPool(lveDevice.device(), &queryPoolInfo, nullptr,
+                          &frame.queryPool) != VK_SUCCESS) {
+      throw std::runtime_error("failed to create pipeline statistics pool!");
+    }
+    frame.names.reserve(MAX_PASSES);
+  }
+  results.resize(MAX_PASSES * RESULT_STRIDE);
+}
+
+LvePipelineStatistics::~LvePipelineStatistics() {
+  // 마지막으로 기록한 frame이 아직 query에 쓰고 있을 수 있음
+  for (auto &frame : frames) {
+    if (frame.queryPool == VK_NULL_HANDLE) {
+      continue;
+    }
+    VkDevice device = lveDevice.device();
+    VkQueryPool queryPool = frame.queryPool;
+    lveDevice.deferDestroy([device, queryPool] {
+      vkDestroyQueryPool(device, queryPool, nullptr);
+    });
+  }
+}
+
+void LvePipelineStatistics::beginFrame(int frameIndex,
+                                       VkCommandBuffer commandBuffer) {
+  assert(currentFrame == nullptr &&
+         "Can't call beginFrame while statistics frame is in progress");
+  if (!supported) {
+    return;
+  }
+  assert(frameIndex >= 0 && static_cast<size_t>(frameIndex) < frames.size() &&
+         "Pipeline statistics frame index out of range");
+
+  // 측정을 끈 뒤에도 마지막 결과는 읽어 둠
+  Frame &frame = frames[frameIndex];
+  if (frame.pending) {
+    resolve(frame);
+  }
+  if (!enabled) {
+    return;
+  }
+
+  vkd::cmdResetQueryPool(commandBuffer, frame.queryPool, 0, MAX_PASSES);
+  frame.names.clear();
+  currentFrame = &frame;
+}
+
+void LvePipelineStatistics::endFrame() {
+  if (currentFrame == nullptr) {
+    return;
+  }
+  assert(!passOpen && "Pipeline statistics pass was not ended");
+  currentFrame->pending = !currentFrame->names.empty();
+  currentFrame = nullptr;
+}
+
+void LvePipelineStatistics::beginPass(VkCommandBuffer commandBuffer,
+                                      const char *name) {
+  assert(!passOpen && "Pipeline statistics passes can't be nested");
+  if (currentFrame == nullptr || currentFrame->names.size() >= MAX_PASSES) {
+    return;
+  }
+  const auto query = static_cast<uint32_t>(currentFrame->names.size());
+  currentFrame->names.push_back(name);
+  passOpen = true;
+  vkd::cmdBeginQuery(commandBuffer, currentFrame->queryPool, query, 0);
+}
+
+void LvePipelineStatistics::endPass(VkCommandBuffer commandBuffer) {
+  if (!passOpen) {
+    return;
+  }
+  passOpen = false;
+  const auto query = static_cast<uint32_t>(currentFrame->names.size() - 1);
+  vkd::cmdEndQuery(commandBuffer, currentFrame->queryPool, query);
+}
+
+void LvePipelineStatistics::resolveAll() {
+  assert(currentFrame == nullptr &&
+         "Can't resolve pipeline statistics while frame is in progress");
+  for (auto &frame : frames) {
+    if (frame.pending) {
+      resolve(frame);
+    }
+  }
+}
+
+void LvePipelineStatistics::resolve(Frame &frame) {
+  frame.pending = false;
+  const auto queryCount = static_cast<uint32_t>(frame.names.size());
+
+  // availability를 같이 읽음 -> 끝나지 않은 pass가 있어도 기다리지 않음
+  const VkDeviceSize stride = RESULT_STRIDE * sizeof(uint64_t);
+  vkGetQueryPoolResults(lveDevice.device(), frame.queryPool, 0, queryCount,
+                        queryCount * stride, results.data(), stride,
+                        VK_QUERY_RESULT_64_BIT |
+                            VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+  FrameStatistics statistics{};
+  for (uint32_t query = 0; query < queryCount; query++) {
+    const uint64_t *values = &results[query * RESULT_STRIDE];
+    if (values[STATISTIC_COUNT] == 0) {
+      continue;
+    }
+    PassStatistics pass{};
+    pass.name = frame.names[query];
+    pass.counters.inputVertices = values[0];
+    pass.counters.inputPrimitives = values[1];
+    pass.counters.vertexInvocations = values[2];
+    pass.counters.clippingInvocations = values[3];
+    pass.counters.clippingPrimitives = values[4];
+    pass.counters.fragmentInvocations = values[5];
+    statistics.total += pass.counters;
+    statistics.passes.push_back(pass);
+  }
+
+  if (!statistics.passes.empty()) {
+    lastFrame = std::move(statistics);
+  }
+}
+
+} // namespace lve
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "lve_device.hpp"
+
+// std
+#include <cstdint>
+#include <vector>
+
+namespace lve {
+
+/**
+ * @brief render pass별 vertex/primitive/fragment 수를 pipeline statistics
+ * query로 측정
+ *
+ * frame마다 query pool을 따로 두고, 같은 frame slot을 다시 쓸 때(fence 대기가
+ * 끝난 뒤) 결과를 읽으므로 기다리지 않음 -> 결과는 frame in flight 수만큼 늦음
+ * 같은 종류의 query는 동시에 active일 수 없어서 pass는 중첩하지 않음
+ */
+class LvePipelineStatistics {
+public:
+  // frame 하나에 측정할 수 있는 최대 pass 수
+  static constexpr uint32_t MAX_PASSES = 16;
+
+  // query에 요청한 bit 순서대로 결과가 나옴
+  struct Counters {
+    uint64_t inputVertices = 0;
+    uint64_t inputPrimitives = 0;
+    uint64_t vertexInvocations = 0;
+    // clipping 단계에 들어온 primitive와 clipping 뒤 남은 primitive
+    uint64_t clippingInvocations = 0;
+    uint64_t clippingPrimitives = 0;
+    uint64_t fragmentInvocations = 0;
+
+    Counters &operator+=(const Counters &other);
+  };
+
+  struct PassStatistics {
+    const char *name = "";
+    Counters counters{};
+  };
+
+  struct FrameStatistics {
+    std::vector<PassStatistics> passes;
+    Counters total{};
+  };
+
+  /**
+   * @param frameCount beginFrame()에 넘길 frame index 수 (frame in flight 최대값)
+   */
+  LvePipelineStatistics(LveDevice &device, uint32_t frameCount);
+  ~LvePipelineStatistics();
+
+  LvePipelineStatistics(const LvePipelineStatistics &) = delete;
+  LvePipelineStatistics &operator=(const LvePipelineStatistics &) = delete;
+
+  // device에서 pipelineStatisticsQuery를 켜지 못했으면 모든 기록이 무시됨
+  bool isSupported() const { return supported; }
+
+  /**
+   * @brief 이 slot의 이전 결과를 읽고 query reset
+   * 이 slot의 fence 대기가 끝난 뒤, render pass 밖에서 호출
+   */
+  void beginFrame(int frameIndex, VkCommandBuffer commandBuffer);
+  void endFrame();
+
+  /**
+   * @brief render pass 밖에서 pass 전체를 감싸도록 호출
+   * @param name 문자열 literal처럼 측정기보다 오래 유효해야 함
+   */
+  void beginPass(VkCommandBuffer commandBuffer, const char *name);
+  void endPass(VkCommandBuffer commandBuffer);
+
+  /**
+   * @brief 기록한 모든 slot의 결과 읽기
+   * device를 기다린 뒤 frame index가 처음부터 다시 시작할 때 호출
+   */
+  void resolveAll();
+
+  // 마지막으로 결과를 읽은 frame
+  const FrameStatistics &getLastFrame() const { return lastFrame; }
+
+  // false면 다음 beginFrame()부터 기록하지 않음
+  bool enabled = false;
+
+private:
+  struct Frame {
+    VkQueryPool queryPool = VK_NULL_HANDLE;
+    std::vector<const char *> names;
+    bool pending = false;
+  };
+
+  void resolve(Frame &frame);
+
+  LveDevice &lveDevice;
+  bool supported = false;
+
+  std::vector<Frame> frames;
+  Frame *currentFrame = nullptr;
+  bool passOpen = false;
+
+  FrameStatistics lastFrame{};
+  std::vector<uint64_t> results;
+};
+
+} // namespace lve
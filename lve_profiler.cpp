@@ -0,0 +1,194 @@
+#include "lve_profiler.hpp"
+
+// std
+#include <algorithm>
+#include <array>
+#include <mutex>
+
+namespace lve {
+
+namespace {
+
+int64_t steadyNanoseconds() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             LveProfiler::Clock::now().time_since_epoch())
+      .count();
+}
+
+struct Registry {
+  Registry() : baseTicks{LveProfiler::ticks()}, baseNs{steadyNanoseconds()} {}
+
+  std::mutex mutex;
+  std::vector<std::unique_ptr<LveProfiler::ThreadBuffer>> buffers;
+  std::vector<std::string> names;
+
+  // ticks -> ns 변환 기준점
+  const uint64_t baseTicks;
+  const int64_t baseNs;
+
+  std::mutex frameMutex;
+  std::array<uint64_t, LveProfiler::FRAME_HISTORY> frameStarts{};
+  uint64_t frameCount = 0;
+};
+
+// thread의 buffer가 프로그램 끝까지 유효하도록 해제하지 않음
+Registry &registry() {
+  static Registry *instance = new Registry{};
+  return *instance;
+}
+
+/**
+ * @brief 지금까지의 구간으로 tick 속도를 측정해서 ns로 변환
+ * TSC는 invariant라고 가정 (최근 x86 CPU)
+ */
+class TickConverter {
+public:
+  TickConverter() {
+#if defined(__x86_64__) || defined(__i386__)
+    Registry &state = registry();
+    baseTicks = state.baseTicks;
+    baseNs = state.baseNs;
+    const uint64_t nowTicks = LveProfiler::ticks();
+    const int64_t nowNs = steadyNanoseconds();
+    if (nowTicks > baseTicks && nowNs > baseNs) {
+      nsPerTick = static_cast<double>(nowNs - baseNs) /
+                  static_cast<double>(nowTicks - baseTicks);
+    }
+#endif
+  }
+
+  int64_t operator()(uint64_t value) const {
+#if defined(__x86_64__) || defined(__i386__)
+    const double delta = static_cast<double>(static_cast<int64_t>(
+        value - baseTicks));
+    return baseNs + static_cast<int64_t>(delta * nsPerTick);
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               LveProfiler::Clock::duration{
+                   static_cast<LveProfiler::Clock::rep>(value)})
+        .count();
+#endif
+  }
+
+private:
+  uint64_t baseTicks = 0;
+  int64_t baseNs = 0;
+  double nsPerTick = 1.0;
+};
+
+} // namespace
+
+LveProfiler::ThreadBuffer *LveProfiler::registerThread() {
+  auto buffer = std::make_unique<ThreadBuffer>();
+  buffer->slots = std::make_unique<Slot[]>(THREAD_CAPACITY);
+
+  Registry &state = registry();
+  std::lock_guard<std::mutex> lock{state.mutex};
+  buffer->threadId = static_cast<uint32_t>(state.buffers.size());
+  state.buffers.push_back(std::move(buffer));
+  state.names.emplace_back();
+  return state.buffers.back().get();
+}
+
+void LveProfiler::setThreadName(const std::string &name) {
+  const uint32_t threadId = currentThreadId();
+  Registry &state = registry();
+  std::lock_guard<std::mutex> lock{state.mutex};
+  state.names[threadId] = name;
+}
+
+std::vector<LveTraceThread> LveProfiler::threads() {
+  Registry &state = registry();
+  std::lock_guard<std::mutex> lock{state.mutex};
+  std::vector<LveTraceThread> result;
+  result.reserve(state.names.size());
+  for (uint32_t threadId = 0; threadId < state.names.size(); threadId++) {
+    const auto &name = state.names[threadId];
+    result.push_back({threadId, name.empty()
+                                    ? "thread " + std::to_string(threadId)
+                                    : name});
+  }
+  return result;
+}
+
+void LveProfiler::markFrame() {
+  const uint64_t now = ticks();
+  Registry &state = registry();
+  std::lock_guard<std::mutex> lock{state.frameMutex};
+  state.frameStarts[state.frameCount % FRAME_HISTORY] = now;
+  state.frameCount++;
+}
+
+bool LveProfiler::frameRange(size_t framesAgo, uint64_t &beginTicks,
+                             uint64_t &endTicks) {
+  Registry &state = registry();
+  std::lock_guard<std::mutex> lock{state.frameMutex};
+  // 끝난 frame은 시작과 다음 frame 시작이 모두 남아 있어야 함
+  const uint64_t stored = std::min<uint64_t>(state.frameCount, FRAME_HISTORY);
+  if (framesAgo + 2 > stored) {
+    return false;
+  }
+  const uint64_t end = state.frameCount - 1 - framesAgo;
+  beginTicks = state.frameStarts[(end - 1) % FRAME_HISTORY];
+  endTicks = state.frameStarts[end % FRAME_HISTORY];
+  return true;
+}
+
+int64_t LveProfiler::ticksToNanoseconds(uint64_t value) {
+  return TickConverter{}(value);
+}
+
+void LveProfiler::collectTraceEvents(std::vector<LveTraceEvent> &events,
+                                     uint64_t fromTicks, uint64_t toTicks) {
+  std::vector<ThreadBuffer *> buffers;
+  {
+    Registry &state = registry();
+    std::lock_guard<std::mutex> lock{state.mutex};
+    for (auto &buffer : state.buffers) {
+      buffers.push_back(buffer.get());
+    }
+  }
+
+  const TickConverter toNanoseconds{};
+  struct Copy {
+    uint64_t index;
+    const char *name;
+    uint64_t begin;
+    uint64_t end;
+  };
+  std::vector<Copy> copies;
+
+  for (ThreadBuffer *buffer : buffers) {
+    // seqlock처럼 읽기 전후의 head로 덮어쓰지 않은 구간만 사용
+    const uint64_t before = buffer->head.load(std::memory_order_acquire);
+    const uint64_t first =
+        before > THREAD_CAPACITY ? before - THREAD_CAPACITY : 0;
+
+    copies.clear();
+    for (uint64_t index = first; index < before; index++) {
+      const Slot &slot = buffer->slots[index & (THREAD_CAPACITY - 1)];
+      copies.push_back({index, slot.name.load(std::memory_order_relaxed),
+                        slot.begin.load(std::memory_order_relaxed),
+                        slot.end.load(std::memory_order_relaxed)});
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t after = buffer->head.load(std::memory_order_relaxed);
+
+    for (const auto &copy : copies) {
+      // 기록 중인 after 번째 칸이 index + THREAD_CAPACITY == after인 칸을 덮어씀
+      if (copy.index + THREAD_CAPACITY <= after) {
+        continue;
+      }
+      if (copy.end <= fromTicks || copy.begin >= toTicks) {
+        continue;
+      }
+      const int64_t beginNs = toNanoseconds(copy.begin);
+      const int64_t endNs = toNanoseconds(copy.end);
+      events.push_back({copy.name, "cpu", buffer->threadId, beginNs / 1000.0,
+                        (endNs - beginNs) / 1000.0});
+    }
+  }
+}
+
+} // namespace lve
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "lve_trace.hpp"
+
+// std
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// 0이면 LVE_PROFILE_* macro가 모두 사라짐 (-DLVE_PROFILER=0)
+#ifndef LVE_PROFILER
+#define LVE_PROFILER 1
+#endif
+
+namespace lve {
+
+/**
+ * @brief CPU 구간(zone) profiler
+ *
+ * thread마다 고정 크기 ring buffer를 가지고, 구간이 끝날 때 소유 thread만
+ * 기록하므로 lock이나 atomic RMW가 없음 (release store 하나)
+ * buffer가 가득 차면 가장 오래된 구간부터 덮어씀
+ * 시간은 x86에서는 TSC, 그 외에는 steady_clock으로 읽고 내보낼 때 변환
+ */
+class LveProfiler {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  // thread 하나가 보관하는 최근 구간 수 (2의 거듭제곱)
+  static constexpr size_t THREAD_CAPACITY = size_t{1} << 16;
+  // markFrame()으로 기록한 frame 시작 시각 보관 수
+  static constexpr size_t FRAME_HISTORY = 256;
+
+  // collectTraceEvents() 범위 기본값 (전체)
+  static constexpr uint64_t FIRST_TICK = 0;
+  static constexpr uint64_t LAST_TICK = std::numeric_limits<uint64_t>::max();
+
+  // ring buffer의 한 칸, 읽는 thread와 겹칠 수 있어서 relaxed atomic으로 접근
+  struct Slot {
+    std::atomic<const char *> name{nullptr};
+    std::atomic<uint64_t> begin{0};
+    std::atomic<uint64_t> end{0};
+  };
+
+  struct ThreadBuffer {
+    std::atomic<uint64_t> head{0};
+    uint32_t threadId = 0;
+    std::unique_ptr<Slot[]> slots;
+  };
+
+  // 기록 시각, 단위는 ticksToNanoseconds()로 변환
+  static uint64_t ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(Clock::now().time_since_epoch().count());
+#endif
+  }
+
+  static ThreadBuffer &threadBuffer() {
+    if (localBuffer == nullptr) {
+      localBuffer = registerThread();
+    }
+    return *localBuffer;
+  }
+
+  /**
+   * @brief 구간 하나 기록, buffer를 소유한 thread에서만 호출
+   * 중첩은 시간 범위로 알 수 있으므로 따로 저장하지 않음
+   */
+  static void record(ThreadBuffer &buffer, const char *name, uint64_t begin,
+                     uint64_t end) {
+    const uint64_t head = buffer.head.load(std::memory_order_relaxed);
+    Slot &slot = buffer.slots[head & (THREAD_CAPACITY - 1)];
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.begin.store(begin, std::memory_order_relaxed);
+    slot.end.store(end, std::memory_order_relaxed);
+    buffer.head.store(head + 1, std::memory_order_release);
+  }
+
+  // 현재 thread의 trace thread id, 처음 호출한 순서대로 0부터
+  static uint32_t currentThreadId() { return threadBuffer().threadId; }
+
+  /**
+   * @brief 현재 thread의 trace track 이름
+   */
+  static void setThreadName(const std::string &name);
+
+  /**
+   * @brief frame 경계 기록, main loop에서 frame마다 한 번 호출
+   */
+  static void markFrame();
+
+  /**
+   * @brief 최근 frame의 [시작, 끝) 시각 (ticks)
+   * 구간과 같은 단위로 비교하므로 frame 경계에서 변환 오차가 없음
+   *
+   * @param framesAgo 0이면 마지막으로 끝난 frame
+   * @return 보관 중인 frame이 아니면 false
+   */
+  static bool frameRange(size_t framesAgo, uint64_t &beginTicks,
+                         uint64_t &endTicks);
+
+  /**
+   * @brief [fromTicks, toTicks)와 겹치는 구간을 events에 추가
+   * 기록 중인 thread를 멈추지 않음, 읽는 동안 덮어쓴 구간은 버림
+   */
+  static void collectTraceEvents(std::vector<LveTraceEvent> &events,
+                                 uint64_t fromTicks = FIRST_TICK,
+                                 uint64_t toTicks = LAST_TICK);
+
+  // 등록된 thread의 trace track 이름
+  static std::vector<LveTraceThread> threads();
+
+  // ticks() 값을 steady_clock 기준 ns로 변환
+  static int64_t ticksToNanoseconds(uint64_t value);
+
+private:
+  static ThreadBuffer *registerThread();
+
+  static inline thread_local ThreadBuffer *localBuffer = nullptr;
+};
+
+/**
+ * @brief 생성자에서 시작, 소멸자에서 기록하는 구간
+ */
+class LveProfileScope {
+public:
+  explicit LveProfileScope(const char *name)
+      : buffer{LveProfiler::threadBuffer()}, name{name},
+        begin{LveProfiler::ticks()} {}
+  ~LveProfileScope() {
+    LveProfiler::record(buffer, name, begin, LveProfiler::ticks());
+  }
+
+  LveProfileScope(const LveProfileScope &) = delete;
+  LveProfileScope &operator=(const LveProfileScope &) = delete;
+
+private:
+  LveProfiler::ThreadBuffer &buffer;
+  const char *name;
+  uint64_t begin;
+};
+
+} // namespace lve
+
+#define LVE_PROFILE_CONCAT_INNER(a, b) a##b
+#define LVE_PROFILE_CONCAT(a, b) LVE_PROFILE_CONCAT_INNER(a, b)
+
+#if LVE_PROFILER
+// name은 문자열 literal (trace를 내보낼 때까지 유효해야 함)
+#define LVE_PROFILE_SCOPE(name)                                                \
+  ::lve::LveProfileScope LVE_PROFILE_CONCAT(lveProfileScope, __LINE__) { name }
+#define LVE_PROFILE_FUNCTION() LVE_PROFILE_SCOPE(__func__)
+#define LVE_PROFILE_FRAME() ::lve::LveProfiler::markFrame()
+#define LVE_PROFILE_THREAD(name) ::lve::LveProfiler::setThreadName(name)
+#else
+#define LVE_PROFILE_SCOPE(name) ((void)0)
+#define LVE_PROFILE_FUNCTION() ((void)0)
+#define LVE_PROFILE_FRAME() ((void)0)
+#define LVE_PROFILE_THREAD(name) ((void)0)
+#endif
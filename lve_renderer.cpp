@@ -1,43 +1,97 @@
 #include "lve_renderer.hpp"
+#include "lve_profiler.hpp"
+#include "lve_vulkan_dispatch.hpp"
 
 // std
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <chrono>
 #include <stdexcept>
 
 namespace lve {
 
 LveRenderer::LveRenderer(LveWindow &window, LveDevice &device)
     : lveWindow{window}, lveDevice{device} {
-  recreateSwapChain();
+  gpuProfiler.frameHistogram = &gpuFrameTimeMetric;
+  rebuildSwapChain();
   createCommandBuffers();
 }
 
 LveRenderer::~LveRenderer() { freeCommandBuffers(); }
 
-void LveRenderer::recreateSwapChain() {
+VkExtent2D LveRenderer::waitForExtent() {
   auto extent = lveWindow.getExtent();
 
   while (extent.width == 0 || extent.height == 0) {
     extent = lveWindow.getExtent();
     glfwWaitEvents();
   }
+  return extent;
+}
+
+void LveRenderer::recreateSwapChain() {
+  LVE_PROFILE_FUNCTION();
+  const auto extent = waitForExtent();
+
+  // 이전 object는 swap chain이 GPU 사용이 끝난 뒤 파괴 -> device를 기다리지 않음
+  const auto start = std::chrono::steady_clock::now();
+  lveSwapChain->recreate(extent);
+  const double elapsedMs = std::chrono::duration<double, std::milli>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+
+  resizeStats.count++;
+  resizeStats.lastMs = elapsedMs;
+  resizeStats.maxMs = std::max(resizeStats.maxMs, elapsedMs);
+  resizeStats.totalMs += elapsedMs;
+  swapChainRecreationsMetric.add();
+}
+
+void LveRenderer::rebuildSwapChain() {
+  const auto extent = waitForExtent();
 
+  // sync object까지 다시 만들므로 사용 중인 frame이 모두 끝나야 함
   vkDeviceWaitIdle(lveDevice.device());
 
   if (lveSwapChain == nullptr) {
-    lveSwapChain = std::make_unique<LveSwapChain>(lveDevice, extent);
+    lveSwapChain =
+        std::make_unique<LveSwapChain>(lveDevice, extent, framePacing);
   } else {
     std::shared_ptr<LveSwapChain> oldSwapChain = std::move(lveSwapChain);
 
-    lveSwapChain =
-        std::make_unique<LveSwapChain>(lveDevice, extent, oldSwapChain);
+    lveSwapChain = std::make_unique<LveSwapChain>(lveDevice, extent,
+                                                  framePacing, oldSwapChain);
 
     if (!oldSwapChain->compareSwapFormats(*lveSwapChain.get())) {
       throw std::runtime_error(
           "Swap chain image(or depth) format has changed!");
     }
   }
+  lveSwapChain->waitCallback = waitCallback;
+  lveSwapChain->beforeSubmitCallback = beforeSubmitCallback;
+  // device가 idle -> 다른 slot에 남은 timestamp를 index가 돌아오기 전에 읽음
+  gpuProfiler.resolveAll();
+  pipelineStatistics.resolveAll();
+  currentFrameIndex = 0;
+}
+
+void LveRenderer::setWaitCallback(std::function<void()> callback) {
+  waitCallback = std::move(callback);
+  lveSwapChain->waitCallback = waitCallback;
+}
+
+void LveRenderer::setBeforeSubmitCallback(std::function<void()> callback) {
+  beforeSubmitCallback = std::move(callback);
+  lveSwapChain->beforeSubmitCallback = beforeSubmitCallback;
+}
+
+void LveRenderer::setFramePacing(const LveFramePacing &pacing) {
+  assert(pacing.framesInFlight >= 1 &&
+         pacing.framesInFlight <= LveSwapChain::MAX_FRAMES_IN_FLIGHT &&
+         "Frames in flight must be between 1 and MAX_FRAMES_IN_FLIGHT");
+  framePacing = pacing;
+  framePacingChanged = true;
 }
 
 void LveRenderer::createCommandBuffers() {
@@ -63,8 +117,29 @@ void LveRenderer::freeCommandBuffers() {
 }
 
 VkCommandBuffer LveRenderer::beginFrame() {
+  LVE_PROFILE_FUNCTION();
   assert(!isFrameStarted && "Can't call beginFrame while already in progress");
+  // fence 대기, acquire부터 다음 beginFrame()까지를 한 frame으로 집계
+  frameStats = LveVulkanStats::take();
+  drawCallsMetric.set(static_cast<double>(frameStats.drawCount()));
+  commandsMetric.set(static_cast<double>(frameStats.commandCount()));
+  drawCallsTotalMetric.add(frameStats.drawCount());
+
+  const auto now = std::chrono::steady_clock::now();
+  if (lastFrameBegin != std::chrono::steady_clock::time_point{}) {
+    frameTimeMetric.observe(
+        std::chrono::duration<double>(now - lastFrameBegin).count());
+  }
+  lastFrameBegin = now;
+  framesMetric.add();
 
+  if (framePacingChanged) {
+    framePacingChanged = false;
+    rebuildSwapChain();
+  }
+
+  flightRecord = LveFlightRecorder::beginFrame();
+  lveSwapChain->flightRecord = flightRecord;
   auto result = lveSwapChain->acquireNextImage(&currentImageIndex);
   if (result == VK_ERROR_OUT_OF_DATE_KHR) {
     recreateSwapChain();
@@ -81,24 +156,41 @@ VkCommandBuffer LveRenderer::beginFrame() {
   VkCommandBufferBeginInfo beginInfo{};
   beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 
-  if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
+  if (vkd::beginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
     throw std::runtime_error("failed to begin recording command buffer!");
   }
+  // 이 slot의 fence를 기다렸으므로 이전 timestamp를 바로 읽을 수 있음
+  gpuProfiler.beginFrame(currentFrameIndex, commandBuffer);
+  pipelineStatistics.beginFrame(currentFrameIndex, commandBuffer);
 
   return commandBuffer;
 }
 
 void LveRenderer::endFrame() {
+  LVE_PROFILE_FUNCTION();
   assert(isFrameStarted &&
          "Can't call endFrame while frame is not in progress");
 
   auto commandBuffer = getCurrentCommandBuffer();
-  if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+  gpuProfiler.endFrame(commandBuffer);
+  pipelineStatistics.endFrame();
+  if (vkd::endCommandBuffer(commandBuffer) != VK_SUCCESS) {
     throw std::runtime_error("failed to record command buffer!");
   }
+  const auto &recorded = LveVulkanStats::current();
+  flightRecord->recordNs = LveFlightRecorder::now();
+  flightRecord->drawCount = static_cast<uint32_t>(recorded.drawCount());
+  flightRecord->commandCount = static_cast<uint32_t>(recorded.commandCount());
 
   auto result =
       lveSwapChain->submitCommandBuffers(&commandBuffer, &currentImageIndex);
+
+  //  여러 프레임을 동시에 처리하는 다중 버퍼링이 가능해져 CPU와 GPU가 병렬로
+  //  작업을 수행할 수 있게 됨
+  // submit한 swap chain과 같이 증가 (재생성 전에)
+  currentFrameIndex =
+      (currentFrameIndex + 1) % lveSwapChain->getFramesInFlight();
+
   if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR ||
       lveWindow.wasWindowResized()) {
     lveWindow.resetWindowResizedFlag();
@@ -108,11 +200,6 @@ void LveRenderer::endFrame() {
   }
 
   isFrameStarted = false;
-
-  //  여러 프레임을 동시에 처리하는 다중 버퍼링이 가능해져 CPU와 GPU가 병렬로
-  //  작업을 수행할 수 있게 됨
-  currentFrameIndex =
-      (currentFrameIndex + 1) % LveSwapChain::MAX_FRAMES_IN_FLIGHT;
 }
 
 void LveRenderer::beginSwapChainRenderPass(VkCommandBuffer commandBuffer) {
@@ -133,8 +220,10 @@ void LveRenderer::beginSwapChainRenderPass(VkCommandBuffer commandBuffer) {
   clearValues[1].depthStencil = {1.0f, 0};
   renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
   renderPassInfo.pClearValues = clearValues.data();
-  vkCmdBeginRenderPass(commandBuffer, &renderPassInfo,
-                       VK_SUBPASS_CONTENTS_INLINE);
+  renderPassScope = gpuProfiler.beginScope(commandBuffer, "swap chain pass");
+  pipelineStatistics.beginPass(commandBuffer, "swap chain pass");
+  vkd::cmdBeginRenderPass(commandBuffer, &renderPassInfo,
+                          VK_SUBPASS_CONTENTS_INLINE);
   VkViewport viewport{};
   viewport.x = 0.0f;
   viewport.y = 0.0f;
@@ -145,8 +234,12 @@ void LveRenderer::beginSwapChainRenderPass(VkCommandBuffer commandBuffer) {
   viewport.maxDepth = 1.0f;
 
   VkRect2D scissor{{0, 0}, lveSwapChain->getSwapChainExtent()};
-  vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
-  vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+  vkd::cmdSetViewport(commandBuffer, 0, 1, &viewport);
+  vkd::cmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+  if (frameCapture != nullptr) {
+    frameCapture->beginRenderPass(lveSwapChain->getSwapChainExtent());
+  }
 }
 
 void LveRenderer::endSwapChainRenderPass(VkCommandBuffer commandBuffer) {
@@ -156,7 +249,13 @@ void LveRenderer::endSwapChainRenderPass(VkCommandBuffer commandBuffer) {
   assert(commandBuffer == getCurrentCommandBuffer() &&
          "Can't end render pass on command buffer from a different frame");
 
-  vkCmdEndRenderPass(commandBuffer);
+  vkd::cmdEndRenderPass(commandBuffer);
+  if (frameCapture != nullptr) {
+    frameCapture->endRenderPass();
+  }
+  pipelineStatistics.endPass(commandBuffer);
+  gpuProfiler.endScope(commandBuffer, renderPassScope);
+  renderPassScope = LveGpuProfiler::INVALID_SCOPE;
 }
 
 } // namespace lve
\ No newline at end of file
@@ -1,11 +1,19 @@
 #pragma once
 
 #include "lve_device.hpp"
+#include "lve_flight_recorder.hpp"
+#include "lve_frame_capture.hpp"
+#include "lve_gpu_profiler.hpp"
+#include "lve_metrics.hpp"
+#include "lve_pipeline_statistics.hpp"
 #include "lve_swap_chain.hpp"
+#include "lve_vulkan_dispatch.hpp"
 #include "lve_window.hpp"
 
 // std
 #include <cassert>
+#include <chrono>
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -73,6 +81,10 @@ public:
    */
   float getAspectRatio() const { return lveSwapChain->extentAspectRatio(); }
 
+  VkExtent2D getSwapChainExtent() const {
+    return lveSwapChain->getSwapChainExtent();
+  }
+
   // getter function
   bool isFrameInProgress() { return isFrameStarted; }
 
@@ -88,6 +100,65 @@ public:
     return currentFrameIndex;
   }
 
+  /**
+   * @brief frame fence를 기다리는 동안 호출할 callback 등록
+   * swap chain을 다시 만들어도 유지됨
+   */
+  void setWaitCallback(std::function<void()> callback);
+
+  /**
+   * @brief vkQueueSubmit 직전에 호출할 callback 등록 (late latch)
+   * callback 안에서 getFrameIndex()로 현재 frame을 알 수 있음
+   */
+  void setBeforeSubmitCallback(std::function<void()> callback);
+
+  /**
+   * @brief frames in flight와 present mode 변경
+   * 다음 beginFrame()에서 swap chain을 다시 만들면서 적용
+   */
+  void setFramePacing(const LveFramePacing &pacing);
+  const LveFramePacing &getFramePacing() const { return framePacing; }
+  // 실제로 사용 중인 present mode (요청한 mode가 없으면 FIFO)
+  VkPresentModeKHR getPresentMode() const {
+    return lveSwapChain->getPresentMode();
+  }
+
+  // 창 크기 변경으로 swap chain을 다시 만든 CPU 시간
+  struct ResizeStats {
+    uint32_t count = 0;
+    double lastMs = 0.0;
+    double maxMs = 0.0;
+    double totalMs = 0.0;
+  };
+  const ResizeStats &getResizeStats() const { return resizeStats; }
+
+  /**
+   * @brief frame 전체와 swap chain render pass의 GPU 시간을 측정하는 profiler
+   * render system은 FrameInfo::gpuProfiler로 자기 구간을 추가
+   */
+  LveGpuProfiler &getGpuProfiler() { return gpuProfiler; }
+
+  /**
+   * @brief swap chain render pass의 vertex/fragment 수를 측정 (기본값 꺼짐)
+   * 다른 pass는 render pass 밖에서 beginPass()/endPass()로 감싸서 추가
+   */
+  LvePipelineStatistics &getPipelineStatistics() { return pipelineStatistics; }
+
+  /**
+   * @brief 직전 frame (이전 beginFrame()부터 이번 beginFrame()까지)의 Vulkan 호출 수
+   * LveVulkanStats::timingEnabled면 호출별 CPU 시간도 포함
+   * LVE_VULKAN_STATS=0으로 빌드하면 모두 0
+   */
+  const LveVulkanStats::FrameStats &getFrameStats() const {
+    return frameStats;
+  }
+
+  /**
+   * @brief swap chain render pass 시작/끝을 capture에 기록, nullptr이면 기록 안 함
+   * render system의 command는 FrameInfo::capture로 기록
+   */
+  void setFrameCapture(LveFrameCapture *capture) { frameCapture = capture; }
+
 private:
   /**
    * @brief  렌더링 루프에서 각 프레임마다 사용할 커맨드 버퍼들을 미리 생성
@@ -102,21 +173,70 @@ private:
 
   /**
    * @brief  창 크기 변경 등으로 인해 스왑체인을 재생성
+   * extent에 의존하는 object만 새로 만들고 device를 기다리지 않음
    *
    */
   void recreateSwapChain();
 
+  /**
+   * @brief 스왑체인 전체를 새로 생성 (처음 생성, frame pacing 변경)
+   * sync object 수가 바뀔 수 있으므로 device가 idle이 될 때까지 기다림
+   */
+  void rebuildSwapChain();
+
+  /**
+   * @brief 창이 최소화되어 있으면 크기가 생길 때까지 event 대기
+   */
+  VkExtent2D waitForExtent();
+
   LveWindow &lveWindow;
   LveDevice &lveDevice;
   std::unique_ptr<LveSwapChain> lveSwapChain;
   std::vector<VkCommandBuffer> commandBuffers;
+  LveGpuProfiler gpuProfiler{lveDevice, LveSwapChain::MAX_FRAMES_IN_FLIGHT};
+  LveGpuProfiler::scope_t renderPassScope = LveGpuProfiler::INVALID_SCOPE;
+  LvePipelineStatistics pipelineStatistics{lveDevice,
+                                           LveSwapChain::MAX_FRAMES_IN_FLIGHT};
 
   // 현재 진행중인 프레임 상태 추적
   uint32_t currentImageIndex;
 
   //   frame index를 추적, 이미지 인덱스에 연결되지 않은 프레임중
-  int currentFrameIndex;
-
-  bool isFrameStarted;
+  // swap chain의 currentFrame과 같은 값 -> rebuildSwapChain()에서 둘 다 0으로
+  int currentFrameIndex{0};
+
+  bool isFrameStarted{false};
+
+  LveFramePacing framePacing = LveFramePacing::presets()[0];
+  bool framePacingChanged = false;
+  ResizeStats resizeStats{};
+
+  std::function<void()> waitCallback;
+  std::function<void()> beforeSubmitCallback;
+
+  LveFrameCapture *frameCapture = nullptr;
+
+  LveVulkanStats::FrameStats frameStats{};
+  // 진행 중인 frame의 flight recorder record (mmap한 ring 안)
+  LveFlightRecorder::FrameRecord *flightRecord = nullptr;
+
+  // metrics endpoint로 내보내는 값, render thread에서 atomic으로만 갱신
+  std::chrono::steady_clock::time_point lastFrameBegin{};
+  LveCounter &framesMetric =
+      LveMetrics::counter("lve_frames_total", "Frames started by beginFrame");
+  LveHistogram &frameTimeMetric = LveMetrics::histogram(
+      "lve_frame_time_seconds", "CPU time between consecutive beginFrame calls",
+      LveMetrics::frameTimeBuckets());
+  LveHistogram &gpuFrameTimeMetric = LveMetrics::histogram(
+      "lve_gpu_frame_time_seconds", "GPU time of a whole frame",
+      LveMetrics::frameTimeBuckets());
+  LveGauge &drawCallsMetric =
+      LveMetrics::gauge("lve_draw_calls", "Draw calls in the last frame");
+  LveGauge &commandsMetric = LveMetrics::gauge(
+      "lve_vulkan_commands", "vkCmd* calls recorded in the last frame");
+  LveCounter &drawCallsTotalMetric =
+      LveMetrics::counter("lve_draw_calls_total", "Draw calls recorded");
+  LveCounter &swapChainRecreationsMetric = LveMetrics::counter(
+      "lve_swap_chain_recreations_total", "Swap chain recreations on resize");
 };
 } // namespace lve
\ No newline at end of file
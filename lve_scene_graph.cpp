@@ -0,0 +1,314 @@
+#include "lve_scene_graph.hpp"
+#include "lve_transform_system.hpp"
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+
+namespace lve {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+// local matrix 계산 시 한 번에 SoA로 모으는 node 수
+constexpr size_t LOCAL_BATCH = 256;
+
+} // namespace
+
+LveSceneGraph::LveSceneGraph(LveJobSystem *jobSystem)
+    : jobSystem{jobSystem} {}
+
+LveSceneGraph::node_t LveSceneGraph::createNode(const TransformComponent &local,
+                                                node_t parent) {
+  assert((parent == NO_PARENT ||
+          (parent < records.size() && records[parent].alive)) &&
+         "Invalid parent node");
+
+  node_t node;
+  if (!freeNodes.empty()) {
+    node = freeNodes.back();
+    freeNodes.pop_back();
+  } else {
+    node = static_cast<node_t>(records.size());
+    records.emplace_back();
+  }
+
+  auto &record = records[node];
+  record = NodeRecord{};
+  record.local = local;
+  record.parent = parent;
+  record.alive = true;
+  if (parent != NO_PARENT) {
+    records[parent].children.push_back(node);
+  }
+
+  markDirty(node, true);
+  orderDirty = true;
+  return node;
+}
+
+void LveSceneGraph::destroyNode(node_t node) {
+  assert(node < records.size() && records[node].alive && "Invalid node");
+
+  auto &record = records[node];
+  if (record.parent != NO_PARENT) {
+    auto &siblings = records[record.parent].children;
+    siblings.erase(std::find(siblings.begin(), siblings.end(), node));
+  }
+
+  // subtree를 깊이 우선으로 삭제
+  std::vector<node_t> stack{node};
+  while (!stack.empty()) {
+    node_t current = stack.back();
+    stack.pop_back();
+    auto &currentRecord = records[current];
+    stack.insert(stack.end(), currentRecord.children.begin(),
+                 currentRecord.children.end());
+    currentRecord = NodeRecord{};
+    freeNodes.push_back(current);
+  }
+
+  orderDirty = true;
+}
+
+void LveSceneGraph::setParent(node_t node, node_t parent) {
+  assert(node < records.size() && records[node].alive && "Invalid node");
+  assert((parent == NO_PARENT || !isDescendant(parent, node)) &&
+         "Cannot parent a node to its own subtree");
+
+  auto &record = records[node];
+  if (record.parent == parent) {
+    return;
+  }
+  if (record.parent != NO_PARENT) {
+    auto &siblings = records[record.parent].children;
+    siblings.erase(std::find(siblings.begin(), siblings.end(), node));
+  }
+  record.parent = parent;
+  if (parent != NO_PARENT) {
+    records[parent].children.push_back(node);
+  }
+
+  markDirty(node, false);
+  orderDirty = true;
+}
+
+void LveSceneGraph::setLocalTransform(node_t node,
+                                      const TransformComponent &local) {
+  assert(node < records.size() && records[node].alive && "Invalid node");
+  records[node].local = local;
+  markDirty(node, true);
+}
+
+const glm::mat4 &LveSceneGraph::worldMatrix(node_t node) const {
+  assert(!orderDirty && records[node].hasOrder &&
+         "Call update() before reading world matrices");
+  return worldMatrices[records[node].order];
+}
+
+void LveSceneGraph::markDirty(node_t node, bool localChanged) {
+  auto &record = records[node];
+  if (localChanged && !record.localPending) {
+    record.localPending = true;
+    pendingLocals.push_back(node);
+  }
+  // 새 node는 rebuildOrder()에서 dirty로 들어감
+  if (record.hasOrder) {
+    dirty[record.order] = 1;
+  }
+  anyDirty = true;
+}
+
+bool LveSceneGraph::isDescendant(node_t node, node_t ancestor) const {
+  for (node_t current = node; current != NO_PARENT;
+       current = records[current].parent) {
+    if (current == ancestor) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void LveSceneGraph::update() {
+  stats = Stats{};
+
+  if (orderDirty) {
+    auto start = Clock::now();
+    rebuildOrder();
+    stats.reorderMs = elapsedMs(start);
+  }
+
+  stats.nodeCount = orderToNode.size();
+  stats.levelCount = levelOffsets.empty() ? 0 : levelOffsets.size() - 1;
+
+  if (!anyDirty) {
+    return;
+  }
+
+  auto start = Clock::now();
+  recomputeLocals();
+
+  // level 순서대로 처리 -> 같은 level 안의 node는 서로 독립적
+  std::atomic<size_t> worldRecomputed{0};
+  for (size_t level = 0; level + 1 < levelOffsets.size(); level++) {
+    const size_t begin = levelOffsets[level];
+    const size_t end = levelOffsets[level + 1];
+
+    if (jobSystem != nullptr && end - begin >= parallelThreshold) {
+      jobSystem->parallelFor(
+          end - begin, parallelGrain, [&](size_t first, size_t last) {
+            worldRecomputed.fetch_add(
+                propagateRange(begin + first, begin + last),
+                std::memory_order_relaxed);
+          });
+    } else {
+      worldRecomputed.fetch_add(propagateRange(begin, end),
+                                std::memory_order_relaxed);
+    }
+  }
+
+  stats.worldRecomputed = worldRecomputed.load();
+  stats.propagateMs = elapsedMs(start);
+  anyDirty = false;
+}
+
+void LveSceneGraph::rebuildOrder() {
+  const size_t count = size();
+
+  std::vector<node_t> newOrder;
+  newOrder.reserve(count);
+  std::vector<uint32_t> newLevelOffsets{0};
+
+  // root들이 level 0, 이후 level마다 children을 차례로 추가
+  for (node_t node = 0; node < records.size(); node++) {
+    if (records[node].alive && records[node].parent == NO_PARENT) {
+      newOrder.push_back(node);
+    }
+  }
+  size_t levelBegin = 0;
+  while (levelBegin < newOrder.size()) {
+    const size_t levelEnd = newOrder.size();
+    newLevelOffsets.push_back(static_cast<uint32_t>(levelEnd));
+    for (size_t i = levelBegin; i < levelEnd; i++) {
+      const auto &children = records[newOrder[i]].children;
+      newOrder.insert(newOrder.end(), children.begin(), children.end());
+    }
+    levelBegin = levelEnd;
+  }
+  assert(newOrder.size() == count && "Scene graph contains unreachable nodes");
+
+  // 기존 matrix와 dirty 상태는 새 위치로 옮기고, 새 node는 dirty로 시작
+  std::vector<uint32_t> newParentOrder(count);
+  std::vector<glm::mat4> newLocals(count, glm::mat4{1.f});
+  std::vector<glm::mat4> newWorlds(count, glm::mat4{1.f});
+  std::vector<uint8_t> newDirty(count, 1);
+
+  for (uint32_t i = 0; i < count; i++) {
+    const auto &record = records[newOrder[i]];
+    if (record.hasOrder) {
+      newLocals[i] = localMatrices[record.order];
+      newWorlds[i] = worldMatrices[record.order];
+      newDirty[i] = dirty[record.order];
+    }
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    auto &record = records[newOrder[i]];
+    record.order = i;
+    record.hasOrder = true;
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    const node_t parent = records[newOrder[i]].parent;
+    newParentOrder[i] =
+        parent == NO_PARENT ? NO_PARENT : records[parent].order;
+  }
+
+  orderToNode = std::move(newOrder);
+  parentOrder = std::move(newParentOrder);
+  levelOffsets = std::move(newLevelOffsets);
+  localMatrices = std::move(newLocals);
+  worldMatrices = std::move(newWorlds);
+  dirty = std::move(newDirty);
+  changed.assign(count, 0);
+
+  orderDirty = false;
+  anyDirty = true;
+}
+
+void LveSceneGraph::recomputeLocals() {
+  // 삭제되었거나 중복된 항목 제거
+  size_t kept = 0;
+  for (node_t node : pendingLocals) {
+    auto &record = records[node];
+    if (record.alive && record.localPending) {
+      record.localPending = false;
+      pendingLocals[kept++] = node;
+    }
+  }
+  pendingLocals.resize(kept);
+  stats.localRecomputed = kept;
+
+  auto computeBatches = [&](size_t begin, size_t end) {
+    float soa[9][LOCAL_BATCH];
+    glm::mat4 results[LOCAL_BATCH];
+
+    for (size_t first = begin; first < end; first += LOCAL_BATCH) {
+      const size_t batch = std::min(LOCAL_BATCH, end - first);
+      for (size_t i = 0; i < batch; i++) {
+        const auto &local = records[pendingLocals[first + i]].local;
+        soa[0][i] = local.translation.x;
+        soa[1][i] = local.translation.y;
+        soa[2][i] = local.translation.z;
+        soa[3][i] = local.rotation.x;
+        soa[4][i] = local.rotation.y;
+        soa[5][i] = local.rotation.z;
+        soa[6][i] = local.scale.x;
+        soa[7][i] = local.scale.y;
+        soa[8][i] = local.scale.z;
+      }
+      LveTransformSystem::computeMatrices(soa[0], soa[1], soa[2], soa[3],
+                                          soa[4], soa[5], soa[6], soa[7],
+                                          soa[8], results, batch);
+      for (size_t i = 0; i < batch; i++) {
+        localMatrices[records[pendingLocals[first + i]].order] = results[i];
+      }
+    }
+  };
+
+  if (jobSystem != nullptr && kept >= parallelThreshold) {
+    jobSystem->parallelFor(kept, parallelGrain, computeBatches);
+  } else {
+    computeBatches(0, kept);
+  }
+
+  pendingLocals.clear();
+}
+
+size_t LveSceneGraph::propagateRange(size_t begin, size_t end) {
+  size_t recomputed = 0;
+  for (size_t i = begin; i < end; i++) {
+    const uint32_t parent = parentOrder[i];
+    const bool parentChanged = parent != NO_PARENT && changed[parent];
+    const bool nodeChanged = dirty[i] || parentChanged;
+
+    changed[i] = nodeChanged;
+    dirty[i] = 0;
+
+    if (nodeChanged) {
+      worldMatrices[i] = parent == NO_PARENT
+                             ? localMatrices[i]
+                             : worldMatrices[parent] * localMatrices[i];
+      recomputed++;
+    }
+  }
+  return recomputed;
+}
+
+} // namespace lve
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "lve_game_object.hpp"
+#include "lve_job_system.hpp"
+
+// libs
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+// std
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace lve {
+
+/**
+ * @brief parent/child 관계를 가진 transform hierarchy
+ *
+ * node는 breadth-first 순서로 정렬된 배열에 저장
+ * -> parent가 항상 child보다 앞에 있으므로 한 번의 선형 순회로 world matrix 전파
+ * 변경된 node와 그 subtree만 다시 계산하고, 큰 level은 job system에서 병렬 처리
+ */
+class LveSceneGraph {
+public:
+  using node_t = uint32_t;
+  static constexpr node_t NO_PARENT = std::numeric_limits<node_t>::max();
+
+  // 마지막 update() 한 번의 비용
+  struct Stats {
+    size_t nodeCount = 0;
+    size_t levelCount = 0;
+    size_t localRecomputed = 0;
+    size_t worldRecomputed = 0;
+    double reorderMs = 0.0;
+    double propagateMs = 0.0;
+  };
+
+  /**
+   * @param jobSystem 큰 level을 나눠서 처리할 scheduler, nullptr이면 단일 thread
+   */
+  explicit LveSceneGraph(LveJobSystem *jobSystem = nullptr);
+
+  LveSceneGraph(const LveSceneGraph &) = delete;
+  LveSceneGraph &operator=(const LveSceneGraph &) = delete;
+
+  node_t createNode(const TransformComponent &local,
+                    node_t parent = NO_PARENT);
+
+  /**
+   * @brief node와 subtree 전체 삭제
+   */
+  void destroyNode(node_t node);
+
+  /**
+   * @brief parent 변경, NO_PARENT면 root가 됨
+   * 자기 subtree 아래로 옮기는 것은 허용하지 않음
+   */
+  void setParent(node_t node, node_t parent);
+
+  void setLocalTransform(node_t node, const TransformComponent &local);
+  const TransformComponent &getLocalTransform(node_t node) const {
+    return records[node].local;
+  }
+  node_t getParent(node_t node) const { return records[node].parent; }
+
+  /**
+   * @brief 정렬 갱신, local matrix 계산, world matrix 전파
+   */
+  void update();
+
+  /**
+   * @brief 마지막 update() 기준 world matrix
+   */
+  const glm::mat4 &worldMatrix(node_t node) const;
+
+  const Stats &getStats() const { return stats; }
+  size_t size() const { return records.size() - freeNodes.size(); }
+
+  // 한 level의 node 수가 이 값 이상이면 병렬 처리
+  size_t parallelThreshold = 16 * 1024;
+  size_t parallelGrain = 4 * 1024;
+
+private:
+  // handle로 접근하는 안정적인 정보
+  struct NodeRecord {
+    TransformComponent local{};
+    node_t parent = NO_PARENT;
+    std::vector<node_t> children;
+    uint32_t order = 0;        // 정렬된 배열에서의 위치
+    bool hasOrder = false;     // 아직 정렬되지 않은 새 node면 false
+    bool localPending = false; // pendingLocals에 들어 있음
+    bool alive = false;
+  };
+
+  void markDirty(node_t node, bool localChanged);
+  void rebuildOrder();
+  void recomputeLocals();
+  size_t propagateRange(size_t begin, size_t end);
+  bool isDescendant(node_t node, node_t ancestor) const;
+
+  LveJobSystem *jobSystem;
+
+  std::vector<NodeRecord> records;
+  std::vector<node_t> freeNodes;
+
+  // breadth-first 순서로 정렬된 배열
+  std::vector<node_t> orderToNode;
+  std::vector<uint32_t> parentOrder;
+  std::vector<uint32_t> levelOffsets;
+  std::vector<glm::mat4> localMatrices;
+  std::vector<glm::mat4> worldMatrices;
+  std::vector<uint8_t> dirty;   // world matrix를 다시 계산해야 함
+  std::vector<uint8_t> changed; // 이번 update에서 world matrix가 바뀜
+
+  // local matrix를 다시 계산할 node 목록
+  std::vector<node_t> pendingLocals;
+
+  bool orderDirty = false;
+  bool anyDirty = false;
+  Stats stats{};
+};
+
+// hierarchy에 속한 entity는 TransformComponent 대신 이 component를 가짐
+struct SceneNodeComponent {
+  LveSceneGraph::node_t node = LveSceneGraph::NO_PARENT;
+};
+
+} // namespace lve
@@ -0,0 +1,197 @@
+#include "lve_simulation.hpp"
+#include "lve_profiler.hpp"
+
+// libs
+#include <glm/gtc/constants.hpp>
+
+// std
+#include <algorithm>
+#include <cassert>
+
+namespace lve {
+
+namespace {
+
+// -pi..pi 범위로 감싼 각도 차이
+float angleDelta(float from, float to) {
+  return glm::mod(to - from + glm::pi<float>(), glm::two_pi<float>()) -
+         glm::pi<float>();
+}
+
+} // namespace
+
+LveSimulationState LveSimulationState::interpolate(const LveSimulationState &a,
+                                                   const LveSimulationState &b,
+                                                   float alpha) {
+  LveSimulationState result = b;
+  result.viewer.translation =
+      glm::mix(a.viewer.translation, b.viewer.translation, alpha);
+  result.viewer.scale = glm::mix(a.viewer.scale, b.viewer.scale, alpha);
+  result.viewer.rotation = {
+      a.viewer.rotation.x +
+          angleDelta(a.viewer.rotation.x, b.viewer.rotation.x) * alpha,
+      a.viewer.rotation.y +
+          angleDelta(a.viewer.rotation.y, b.viewer.rotation.y) * alpha,
+      a.viewer.rotation.z +
+          angleDelta(a.viewer.rotation.z, b.viewer.rotation.z) * alpha};
+  return result;
+}
+
+LveSimulation::LveSimulation(double tickRate, const LveSimulationState &initial,
+                             StepFn step)
+    : tickRate{tickRate},
+      tickDuration{std::chrono::duration_cast<Clock::duration>(
+          std::chrono::duration<double>(1.0 / tickRate))},
+      step{std::move(step)}, state{initial} {
+  assert(tickRate > 0.0 && "Simulation tick rate must be positive");
+
+  // thread 시작 전에도 sample()이 유효한 상태를 반환하도록 초기값 publish
+  Snapshot &first = snapshots.back();
+  first.previous = initial;
+  first.current = initial;
+  first.currentTime = Clock::now();
+  snapshots.publish();
+  snapshots.update();
+}
+
+LveSimulation::~LveSimulation() { stop(); }
+
+void LveSimulation::start() {
+  if (running.exchange(true)) {
+    return;
+  }
+  thread = std::thread([this] { threadLoop(); });
+}
+
+void LveSimulation::stop() {
+  if (!running.exchange(false)) {
+    return;
+  }
+  {
+    // 대기 조건 확인과 notify 사이에 깨우는 신호를 놓치지 않도록 lock
+    std::lock_guard<std::mutex> lock{pauseMutex};
+  }
+  pauseCondition.notify_all();
+  thread.join();
+}
+
+void LveSimulation::pause() { paused.store(true, std::memory_order_relaxed); }
+
+void LveSimulation::resume() {
+  if (!paused.load(std::memory_order_relaxed)) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock{pauseMutex};
+    paused.store(false, std::memory_order_relaxed);
+  }
+  pauseCondition.notify_all();
+}
+
+LveSimulationState LveSimulation::sample(Clock::time_point now) {
+  snapshots.update();
+  const Snapshot &snapshot = snapshots.front();
+
+  const double alpha =
+      std::chrono::duration<double>(now - snapshot.currentTime).count() *
+      tickRate;
+  return LveSimulationState::interpolate(
+      snapshot.previous, snapshot.current,
+      static_cast<float>(std::clamp(alpha, 0.0, 1.0)));
+}
+
+void LveSimulation::threadLoop() {
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+  const float dt = static_cast<float>(1.0 / tickRate);
+  LVE_PROFILE_THREAD("simulation");
+
+  Stats stats = snapshots.front().stats;
+  LveSimulationState previous = state;
+
+  // 1초 단위로 tick rate, step 시간 집계
+  auto windowStart = Clock::now();
+  uint64_t windowTicks = 0;
+  double windowStepMs = 0.0;
+  double windowMaxStepMs = 0.0;
+
+  Clock::time_point next = windowStart + tickDuration;
+  while (running.load(std::memory_order_relaxed)) {
+    if (paused.load(std::memory_order_relaxed)) {
+      std::unique_lock<std::mutex> lock{pauseMutex};
+      pauseCondition.wait(lock, [this] {
+        return !paused.load(std::memory_order_relaxed) ||
+               !running.load(std::memory_order_relaxed);
+      });
+      lock.unlock();
+
+      // 쉰 구간은 skippedTicks, tick rate 집계에서 제외하고 지금부터 다시 시작
+      windowStart = Clock::now();
+      windowTicks = 0;
+      windowStepMs = 0.0;
+      windowMaxStepMs = 0.0;
+      next = windowStart + tickDuration;
+      continue;
+    }
+
+    std::this_thread::sleep_until(next);
+    const auto now = Clock::now();
+
+    // 늦게 깨어났으면 밀린 tick을 한 번에 처리
+    uint32_t processed = 0;
+    while (next <= now && processed < maxCatchUpTicks) {
+      previous = state;
+
+      const auto stepStart = Clock::now();
+      state.time = next;
+      {
+        LVE_PROFILE_SCOPE("simulation tick");
+        step(state, dt);
+      }
+      state.tick++;
+      const double stepMs = Milliseconds(Clock::now() - stepStart).count();
+
+      windowTicks++;
+      windowStepMs += stepMs;
+      windowMaxStepMs = std::max(windowMaxStepMs, stepMs);
+      stats.ticks++;
+
+      next += tickDuration;
+      processed++;
+    }
+
+    // 그래도 밀려 있으면 따라잡지 않고 버림 -> 시간 누적 폭주 방지
+    if (next <= now) {
+      const auto behind = (now - next) / tickDuration + 1;
+      stats.skippedTicks += static_cast<uint64_t>(behind);
+      next += behind * tickDuration;
+    }
+
+    const double windowSeconds =
+        std::chrono::duration<double>(now - windowStart).count();
+    if (windowSeconds >= 1.0) {
+      stats.tickRate = static_cast<double>(windowTicks) / windowSeconds;
+      stats.averageStepMs =
+          windowTicks > 0 ? windowStepMs / static_cast<double>(windowTicks)
+                          : 0.0;
+      stats.maxStepMs = windowMaxStepMs;
+      windowStart = now;
+      windowTicks = 0;
+      windowStepMs = 0.0;
+      windowMaxStepMs = 0.0;
+    }
+
+    if (processed == 0) {
+      continue;
+    }
+
+    // 마지막 tick의 예정 시각 기준으로 보간
+    Snapshot &snapshot = snapshots.back();
+    snapshot.previous = previous;
+    snapshot.current = state;
+    snapshot.currentTime = next - tickDuration;
+    snapshot.stats = stats;
+    snapshots.publish();
+  }
+}
+
+} // namespace lve
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "lve_game_object.hpp"
+#include "lve_triple_buffer.hpp"
+
+// std
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace lve {
+
+/**
+ * @brief simulation thread가 한 tick마다 만드는 상태
+ * 새로 simulation할 데이터는 여기에 추가
+ */
+struct LveSimulationState {
+  uint64_t tick = 0;
+  // 이 tick 구간이 끝나는 예정 시각, step에서 [time - dt, time) 구간을 처리
+  std::chrono::steady_clock::time_point time{};
+  // 이 상태에 반영된 가장 최근 key 입력 event 시각 (입력 지연 측정용)
+  std::chrono::steady_clock::time_point inputTime{};
+
+  TransformComponent viewer{};
+
+  /**
+   * @brief 두 상태 사이 보간, rotation은 짧은 방향으로 보간
+   */
+  static LveSimulationState interpolate(const LveSimulationState &a,
+                                        const LveSimulationState &b,
+                                        float alpha);
+};
+
+/**
+ * @brief 고정 간격으로 상태를 갱신하는 simulation thread
+ *
+ * render loop와 독립적으로 tickRate Hz로 step을 호출하고, 결과는 triple buffer로
+ * 넘김 -> render thread는 기다리지 않고 마지막 두 tick 사이를 보간해서 그림
+ * frame rate가 달라도 simulation 결과는 같음
+ */
+class LveSimulation {
+public:
+  using Clock = std::chrono::steady_clock;
+  using StepFn = std::function<void(LveSimulationState &state, float dt)>;
+
+  // simulation thread에서 측정한 값, snapshot과 같이 전달
+  struct Stats {
+    uint64_t ticks = 0;
+    uint64_t skippedTicks = 0; // 너무 밀려서 버린 tick
+    double tickRate = 0.0;     // 최근 1초 동안 실제 tick 수
+    double averageStepMs = 0.0;
+    double maxStepMs = 0.0;
+  };
+
+  /**
+   * @param tickRate 초당 tick 수
+   * @param initial 초기 상태
+   * @param step simulation thread에서 tick마다 호출
+   */
+  LveSimulation(double tickRate, const LveSimulationState &initial,
+                StepFn step);
+  ~LveSimulation();
+
+  LveSimulation(const LveSimulation &) = delete;
+  LveSimulation &operator=(const LveSimulation &) = delete;
+
+  void start();
+  void stop();
+
+  /**
+   * @brief simulation thread를 재움 (on-demand redraw에서 그릴 것이 없을 때)
+   * 진행 중인 tick은 끝까지 처리
+   */
+  void pause();
+
+  /**
+   * @brief pause()한 thread를 깨움, 쉬는 동안의 tick은 따라잡지 않고 건너뜀
+   */
+  void resume();
+
+  bool isPaused() const { return paused.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief render thread 전용, now 시점의 보간된 상태
+   * 마지막 tick과 그 이전 tick 사이를 보간하므로 한 tick만큼 늦게 보임
+   */
+  LveSimulationState sample(Clock::time_point now = Clock::now());
+
+  // render thread 전용, 마지막으로 받은 snapshot 기준
+  const Stats &getStats() const { return snapshots.front().stats; }
+
+  double getTickRate() const { return tickRate; }
+
+  // 한 번에 따라잡는 최대 tick 수, 넘으면 나머지는 버림
+  uint32_t maxCatchUpTicks = 8;
+
+private:
+  struct Snapshot {
+    LveSimulationState previous{};
+    LveSimulationState current{};
+    Clock::time_point currentTime{};
+    Stats stats{};
+  };
+
+  void threadLoop();
+
+  const double tickRate;
+  const Clock::duration tickDuration;
+  StepFn step;
+
+  LveSimulationState state;
+  LveTripleBuffer<Snapshot> snapshots;
+
+  std::thread thread;
+  std::atomic<bool> running{false};
+
+  // pause() 중에는 thread가 pauseCondition에서 대기
+  std::atomic<bool> paused{false};
+  std::mutex pauseMutex;
+  std::condition_variable pauseCondition;
+};
+
+} // namespace lve
@@ -0,0 +1,61 @@
+#pragma once
+
+// std
+#include <atomic>
+#include <cstddef>
+
+namespace lve {
+
+/**
+ * @brief producer 하나, consumer 하나 사이의 고정 크기 lock-free ring
+ *
+ * 가득 차면 push()가 false를 반환 (producer가 기다리지 않음)
+ */
+template <typename T, size_t Capacity> class LveSpscRing {
+  static_assert((Capacity & (Capacity - 1)) == 0,
+                "Ring capacity must be a power of two");
+
+public:
+  LveSpscRing() = default;
+
+  LveSpscRing(const LveSpscRing &) = delete;
+  LveSpscRing &operator=(const LveSpscRing &) = delete;
+
+  // producer 전용
+  bool push(const T &value) {
+    const size_t head = writeIndex.load(std::memory_order_relaxed);
+    if (head - readIndex.load(std::memory_order_acquire) >= Capacity) {
+      return false;
+    }
+    items[head & (Capacity - 1)] = value;
+    writeIndex.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // consumer 전용, 비어 있으면 nullptr
+  const T *peek() const {
+    const size_t tail = readIndex.load(std::memory_order_relaxed);
+    if (tail == writeIndex.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    return &items[tail & (Capacity - 1)];
+  }
+
+  // consumer 전용, peek()으로 확인한 원소 제거
+  void pop() {
+    readIndex.store(readIndex.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_release);
+  }
+
+  size_t size() const {
+    return writeIndex.load(std::memory_order_acquire) -
+           readIndex.load(std::memory_order_acquire);
+  }
+
+private:
+  T items[Capacity];
+  alignas(64) std::atomic<size_t> writeIndex{0};
+  alignas(64) std::atomic<size_t> readIndex{0};
+};
+
+} // namespace lve
@@ -1,30 +1,56 @@
 #include "lve_swap_chain.hpp"
+#include "lve_log.hpp"
+#include "lve_profiler.hpp"
+#include "lve_vulkan_dispatch.hpp"
 
 // std
+#include <algorithm>
 #include <array>
+#include <cassert>
 #include <cstdlib>
 #include <cstring>
-#include <iostream>
 #include <limits>
 #include <set>
 #include <stdexcept>
 
 namespace lve {
 
-LveSwapChain::LveSwapChain(LveDevice &deviceRef, VkExtent2D extent)
-    : device{deviceRef}, windowExtent{extent} {
+const std::vector<LveFramePacing> &LveFramePacing::presets() {
+  static const std::vector<LveFramePacing> pacings{
+      // 기존 동작
+      {"balanced", 2, VK_PRESENT_MODE_MAILBOX_KHR},
+      // tearing을 허용하고 CPU가 최대 3 frame 앞서 나감
+      {"throughput", 3, VK_PRESENT_MODE_IMMEDIATE_KHR},
+      // CPU와 GPU를 겹치지 않고 가장 최근 입력으로 그림
+      {"low-latency", 1, VK_PRESENT_MODE_MAILBOX_KHR},
+      {"vsync", 2, VK_PRESENT_MODE_FIFO_KHR},
+      // refresh를 놓친 frame만 tearing 허용
+      {"vsync-relaxed", 1, VK_PRESENT_MODE_FIFO_RELAXED_KHR},
+  };
+  return pacings;
+}
+
+LveSwapChain::LveSwapChain(LveDevice &deviceRef, VkExtent2D extent,
+                           const LveFramePacing &pacing)
+    : device{deviceRef}, windowExtent{extent}, framePacing{pacing} {
   init();
 }
 
 LveSwapChain::LveSwapChain(LveDevice &deviceRef, VkExtent2D extent,
+                           const LveFramePacing &pacing,
                            std::shared_ptr<LveSwapChain> previous)
-    : device{deviceRef}, windowExtent{extent}, oldSwapChain{previous} {
+    : device{deviceRef}, windowExtent{extent}, framePacing{pacing},
+      oldSwapChain{previous} {
   init();
   oldSwapChain = nullptr;
 }
 
 void LveSwapChain::init() {
-  createSwapChain();
+  assert(framePacing.framesInFlight >= 1 &&
+         framePacing.framesInFlight <= MAX_FRAMES_IN_FLIGHT &&
+         "Frames in flight must be between 1 and MAX_FRAMES_IN_FLIGHT");
+  createSwapChain(oldSwapChain == nullptr ? VK_NULL_HANDLE
+                                          : oldSwapChain->swapChain);
   createImageViews();
   createRenderPass();
   createDepthResources();
@@ -45,8 +71,7 @@ LveSwapChain::~LveSwapChain() {
 
   for (int i = 0; i < depthImages.size(); i++) {
     vkDestroyImageView(device.device(), depthImageViews[i], nullptr);
-    vkDestroyImage(device.device(), depthImages[i], nullptr);
-    vkFreeMemory(device.device(), depthImageMemorys[i], nullptr);
+    device.destroyImage(depthImages[i], depthImageMemorys[i]);
   }
 
   for (auto framebuffer : swapChainFramebuffers) {
@@ -56,22 +81,97 @@ LveSwapChain::~LveSwapChain() {
   vkDestroyRenderPass(device.device(), renderPass, nullptr);
 
   // cleanup synchronization objects
-  for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+  for (size_t i = 0; i < inFlightFences.size(); i++) {
     vkDestroySemaphore(device.device(), renderFinishedSemaphores[i], nullptr);
     vkDestroySemaphore(device.device(), imageAvailableSemaphores[i], nullptr);
     vkDestroyFence(device.device(), inFlightFences[i], nullptr);
   }
 }
 
+void LveSwapChain::recreate(VkExtent2D extent) {
+  windowExtent = extent;
+
+  // 지금까지 submit한 frame이 이전 object를 사용 중일 수 있음
+  // -> 그 frame들이 끝난 뒤 LveDevice가 파괴
+  const VkSwapchainKHR previous = swapChain;
+  retireExtentResources(device.submittedSubmission());
+
+  const VkFormat previousFormat = swapChainImageFormat;
+  createSwapChain(previous);
+  if (swapChainImageFormat != previousFormat) {
+    // render pass를 그대로 쓰므로 format은 바뀌면 안 됨
+    throw std::runtime_error("Swap chain image(or depth) format has changed!");
+  }
+
+  createImageViews();
+  createDepthResources();
+  createFramebuffers();
+  imagesInFlight.assign(imageCount(), VK_NULL_HANDLE);
+}
+
+void LveSwapChain::retireExtentResources(uint64_t lastUse) {
+  for (auto framebuffer : swapChainFramebuffers) {
+    device.deferDestroyFramebuffer(framebuffer, lastUse);
+  }
+  for (size_t i = 0; i < depthImages.size(); i++) {
+    device.deferDestroyImageView(depthImageViews[i], lastUse);
+    device.deferDestroyImage(depthImages[i], depthImageMemorys[i], lastUse);
+  }
+  for (auto imageView : swapChainImageViews) {
+    device.deferDestroyImageView(imageView, lastUse);
+  }
+  device.deferDestroySwapchain(swapChain, lastUse);
+
+  swapChainFramebuffers.clear();
+  depthImages.clear();
+  depthImageMemorys.clear();
+  depthImageViews.clear();
+  swapChainImageViews.clear();
+  // 스왑체인 image는 스왑체인이 소유
+  swapChainImages.clear();
+  swapChain = VK_NULL_HANDLE;
+}
+
 VkResult LveSwapChain::acquireNextImage(uint32_t *imageIndex) {
-  vkWaitForFences(device.device(), 1, &inFlightFences[currentFrame], VK_TRUE,
-                  std::numeric_limits<uint64_t>::max());
+  const int64_t waitBegin = LveFlightRecorder::now();
+  VkResult fenceResult;
+  {
+    LVE_PROFILE_SCOPE("wait frame fence");
+    if (waitCallback) {
+      // 짧은 timeout으로 나눠 기다리면서 그 사이에 callback 실행
+      while ((fenceResult = vkd::waitForFences(
+                  device.device(), 1, &inFlightFences[currentFrame], VK_TRUE,
+                  WAIT_POLL_INTERVAL_NS)) == VK_TIMEOUT) {
+        waitCallback();
+      }
+    } else {
+      fenceResult = vkd::waitForFences(device.device(), 1,
+                                       &inFlightFences[currentFrame], VK_TRUE,
+                                       std::numeric_limits<uint64_t>::max());
+    }
+  }
+  if (flightRecord) {
+    flightRecord->frameFenceWaitNs = LveFlightRecorder::now() - waitBegin;
+    flightRecord->fenceResult = fenceResult;
+  }
+  LveFlightRecorder::checkDeviceLost(fenceResult);
+
+  // fence signal은 같은 queue에 먼저 submit한 작업이 모두 끝났다는 뜻
+  // -> 그 번호 이하로 파괴를 예약한 object 정리
+  device.completeSubmission(frameSubmissions[currentFrame]);
 
-  VkResult result = vkAcquireNextImageKHR(
+  LVE_PROFILE_SCOPE("acquire image");
+  VkResult result = vkd::acquireNextImage(
       device.device(), swapChain, std::numeric_limits<uint64_t>::max(),
       imageAvailableSemaphores[currentFrame], // must be a not signaled
                                               // semaphore
       VK_NULL_HANDLE, imageIndex);
+  if (flightRecord) {
+    flightRecord->acquireNs = LveFlightRecorder::now();
+    flightRecord->acquireResult = result;
+    flightRecord->imageIndex = *imageIndex;
+  }
+  LveFlightRecorder::checkDeviceLost(result);
 
   return result;
 }
@@ -79,11 +179,23 @@ VkResult LveSwapChain::acquireNextImage(uint32_t *imageIndex) {
 VkResult LveSwapChain::submitCommandBuffers(const VkCommandBuffer *buffers,
                                             uint32_t *imageIndex) {
   if (imagesInFlight[*imageIndex] != VK_NULL_HANDLE) {
-    vkWaitForFences(device.device(), 1, &imagesInFlight[*imageIndex], VK_TRUE,
-                    UINT64_MAX);
+    LVE_PROFILE_SCOPE("wait image fence");
+    const int64_t waitBegin = LveFlightRecorder::now();
+    const VkResult fenceResult =
+        vkd::waitForFences(device.device(), 1, &imagesInFlight[*imageIndex],
+                           VK_TRUE, UINT64_MAX);
+    if (flightRecord) {
+      flightRecord->imageFenceWaitNs = LveFlightRecorder::now() - waitBegin;
+    }
+    LveFlightRecorder::checkDeviceLost(fenceResult);
   }
   imagesInFlight[*imageIndex] = inFlightFences[currentFrame];
 
+  // 이미지 대기까지 끝난 뒤 -> submit 전에 할 수 있는 가장 늦은 시점
+  if (beforeSubmitCallback) {
+    beforeSubmitCallback();
+  }
+
   VkSubmitInfo submitInfo = {};
   submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 
@@ -101,9 +213,16 @@ VkResult LveSwapChain::submitCommandBuffers(const VkCommandBuffer *buffers,
   submitInfo.signalSemaphoreCount = 1;
   submitInfo.pSignalSemaphores = signalSemaphores;
 
-  vkResetFences(device.device(), 1, &inFlightFences[currentFrame]);
-  if (vkQueueSubmit(device.graphicsQueue(), 1, &submitInfo,
-                    inFlightFences[currentFrame]) != VK_SUCCESS) {
+  frameSubmissions[currentFrame] = device.advanceSubmission();
+  vkd::resetFences(device.device(), 1, &inFlightFences[currentFrame]);
+  const VkResult submitResult = vkd::queueSubmit(
+      device.graphicsQueue(), 1, &submitInfo, inFlightFences[currentFrame]);
+  if (flightRecord) {
+    flightRecord->submitNs = LveFlightRecorder::now();
+    flightRecord->submitResult = submitResult;
+  }
+  if (submitResult != VK_SUCCESS) {
+    LveFlightRecorder::checkDeviceLost(submitResult);
     throw std::runtime_error("failed to submit draw command buffer!");
   }
 
@@ -119,20 +238,29 @@ VkResult LveSwapChain::submitCommandBuffers(const VkCommandBuffer *buffers,
 
   presentInfo.pImageIndices = imageIndex;
 
-  auto result = vkQueuePresentKHR(device.presentQueue(), &presentInfo);
+  VkResult result;
+  {
+    // FIFO에서는 여기서 vsync를 기다릴 수 있음
+    LVE_PROFILE_SCOPE("queue present");
+    result = vkd::queuePresent(device.presentQueue(), &presentInfo);
+  }
+  if (flightRecord) {
+    flightRecord->presentNs = LveFlightRecorder::now();
+    flightRecord->presentResult = result;
+  }
+  LveFlightRecorder::checkDeviceLost(result);
 
-  currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+  currentFrame = (currentFrame + 1) % framePacing.framesInFlight;
 
   return result;
 }
 
-void LveSwapChain::createSwapChain() {
+void LveSwapChain::createSwapChain(VkSwapchainKHR previous) {
   SwapChainSupportDetails swapChainSupport = device.getSwapChainSupport();
 
   VkSurfaceFormatKHR surfaceFormat =
       chooseSwapSurfaceFormat(swapChainSupport.formats);
-  VkPresentModeKHR presentMode =
-      chooseSwapPresentMode(swapChainSupport.presentModes);
+  presentMode = chooseSwapPresentMode(swapChainSupport.presentModes);
   VkExtent2D extent = chooseSwapExtent(swapChainSupport.capabilities);
 
   uint32_t imageCount = swapChainSupport.capabilities.minImageCount + 1;
@@ -173,8 +301,8 @@ void LveSwapChain::createSwapChain() {
   createInfo.clipped = VK_TRUE;
 
   //   createInfo.oldSwapchain = VK_NULL_HANDLE;
-  createInfo.oldSwapchain =
-      oldSwapChain == nullptr ? VK_NULL_HANDLE : oldSwapChain->swapChain;
+  // 이전 스왑체인은 retire되지만 이미 present한 image는 계속 표시될 수 있음
+  createInfo.oldSwapchain = previous;
 
   if (vkCreateSwapchainKHR(device.device(), &createInfo, nullptr, &swapChain) !=
       VK_SUCCESS) {
@@ -330,7 +458,8 @@ void LveSwapChain::createDepthResources() {
     imageInfo.flags = 0;
 
     device.createImageWithInfo(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-                               depthImages[i], depthImageMemorys[i]);
+                               depthImages[i], depthImageMemorys[i],
+                               LveMemoryCategory::DEPTH);
 
     VkImageViewCreateInfo viewInfo{};
     viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -351,9 +480,10 @@ void LveSwapChain::createDepthResources() {
 }
 
 void LveSwapChain::createSyncObjects() {
-  imageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
-  renderFinishedSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
-  inFlightFences.resize(MAX_FRAMES_IN_FLIGHT);
+  imageAvailableSemaphores.resize(framePacing.framesInFlight);
+  renderFinishedSemaphores.resize(framePacing.framesInFlight);
+  inFlightFences.resize(framePacing.framesInFlight);
+  frameSubmissions.resize(framePacing.framesInFlight, 0);
   imagesInFlight.resize(imageCount(), VK_NULL_HANDLE);
 
   VkSemaphoreCreateInfo semaphoreInfo = {};
@@ -363,7 +493,7 @@ void LveSwapChain::createSyncObjects() {
   fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
   fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
 
-  for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+  for (size_t i = 0; i < framePacing.framesInFlight; i++) {
     if (vkCreateSemaphore(device.device(), &semaphoreInfo, nullptr,
                           &imageAvailableSemaphores[i]) != VK_SUCCESS ||
         vkCreateSemaphore(device.device(), &semaphoreInfo, nullptr,
@@ -391,23 +521,33 @@ VkSurfaceFormatKHR LveSwapChain::chooseSwapSurfaceFormat(
 VkPresentModeKHR LveSwapChain::chooseSwapPresentMode(
     const std::vector<VkPresentModeKHR> &availablePresentModes) {
   for (const auto &availablePresentMode : availablePresentModes) {
-    if (availablePresentMode == VK_PRESENT_MODE_MAILBOX_KHR) {
-      std::cout << "Present mode: Mailbox" << std::endl;
+    if (availablePresentMode == framePacing.presentMode) {
+      LVE_LOG_INFO << "Present mode: " << presentModeName(availablePresentMode);
       return availablePresentMode;
     }
   }
 
-  // for (const auto &availablePresentMode : availablePresentModes) {
-  //   if (availablePresentMode == VK_PRESENT_MODE_IMMEDIATE_KHR) {
-  //     std::cout << "Present mode: Immediate" << std::endl;
-  //     return availablePresentMode;
-  //   }
-  // }
-
-  std::cout << "Present mode: V-Sync" << std::endl;
+  // FIFO는 항상 지원됨
+  LVE_LOG_WARN << "Present mode: " << presentModeName(framePacing.presentMode)
+               << " unavailable, using V-Sync";
   return VK_PRESENT_MODE_FIFO_KHR;
 }
 
+const char *LveSwapChain::presentModeName(VkPresentModeKHR mode) {
+  switch (mode) {
+  case VK_PRESENT_MODE_IMMEDIATE_KHR:
+    return "Immediate";
+  case VK_PRESENT_MODE_MAILBOX_KHR:
+    return "Mailbox";
+  case VK_PRESENT_MODE_FIFO_KHR:
+    return "V-Sync";
+  case VK_PRESENT_MODE_FIFO_RELAXED_KHR:
+    return "V-Sync (relaxed)";
+  default:
+    return "Unknown";
+  }
+}
+
 VkExtent2D
 LveSwapChain::chooseSwapExtent(const VkSurfaceCapabilitiesKHR &capabilities) {
   if (capabilities.currentExtent.width !=
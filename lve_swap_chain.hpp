@@ -1,27 +1,50 @@
 #pragma once
 
 #include "lve_device.hpp"
+#include "lve_flight_recorder.hpp"
 
 // vulkan headers
 #include <vulkan/vulkan.h>
 
 // std lib headers
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 
 namespace lve {
 
+/**
+ * @brief frames in flight 수와 present mode 조합
+ *
+ * frames in flight가 많을수록 CPU/GPU가 겹쳐서 처리량이 늘지만 입력 -> 화면 지연이
+ * 한 frame씩 늘어남, present mode는 vsync 여부와 queue 길이를 결정
+ */
+struct LveFramePacing {
+  const char *name;
+  uint32_t framesInFlight;
+  VkPresentModeKHR presentMode;
+
+  // 런타임에 고를 수 있는 조합, 0번이 기본값
+  static const std::vector<LveFramePacing> &presets();
+};
+
 class LveSwapChain {
 public:
-  // GPU와 CPU 간의 병렬 처리를 최적화
-  static constexpr int MAX_FRAMES_IN_FLIGHT = 2;
+  // GPU와 CPU 간의 병렬 처리를 최적화, LveFramePacing::framesInFlight의 상한
+  static constexpr int MAX_FRAMES_IN_FLIGHT = 3;
+  // waitCallback 호출 간격
+  static constexpr uint64_t WAIT_POLL_INTERVAL_NS = 500'000;
 
-  LveSwapChain(LveDevice &deviceRef, VkExtent2D windowExtent);
+  LveSwapChain(LveDevice &deviceRef, VkExtent2D windowExtent,
+               const LveFramePacing &pacing);
   /**
-   * @brief 이전 스왑체인을 참조하여 새로운 스왑체인을 생성 -> 창 크기 변경 대비
+   * @brief 이전 스왑체인을 참조하여 새로운 스왑체인을 생성
+   * sync object까지 모두 새로 만들므로 previous를 쓰는 GPU 작업이 끝난 뒤에 호출
+   * (frames in flight 변경 등), 창 크기 변경은 recreate() 사용
    */
   LveSwapChain(LveDevice &deviceRef, VkExtent2D windowExtent,
+               const LveFramePacing &pacing,
                std::shared_ptr<LveSwapChain> previous);
   ~LveSwapChain();
   LveSwapChain(const LveSwapChain &) = delete;
@@ -38,6 +61,11 @@ public:
   VkExtent2D getSwapChainExtent() { return swapChainExtent; }
   uint32_t width() { return swapChainExtent.width; }
   uint32_t height() { return swapChainExtent.height; }
+  uint32_t getFramesInFlight() const { return framePacing.framesInFlight; }
+  // 요청한 mode가 지원되지 않으면 FIFO로 바뀌어 있음
+  VkPresentModeKHR getPresentMode() const { return presentMode; }
+
+  static const char *presentModeName(VkPresentModeKHR mode);
 
   /**
    * @brief 스왑체인의 가로세로 비율을 반환
@@ -64,6 +92,16 @@ public:
    * @return VkResult
    */
   VkResult acquireNextImage(uint32_t *imageIndex);
+
+  /**
+   * @brief 창 크기 변경 -> extent에 의존하는 object만 다시 생성
+   * 스왑체인(oldSwapchain 전달), image view, depth image, framebuffer는 새로 만들고
+   * render pass와 sync object는 그대로 사용
+   * 이전 object는 지금까지 submit한 frame이 모두 끝난 뒤 LveDevice가 파괴하므로
+   * device 전체를 기다리지 않음
+   */
+  void recreate(VkExtent2D extent);
+
   VkResult submitCommandBuffers(const VkCommandBuffer *buffers,
                                 uint32_t *imageIndex);
 
@@ -79,14 +117,25 @@ public:
            swapChain.swapChainImageFormat == swapChainImageFormat;
   }
 
+  // frame fence를 기다리는 동안 주기적으로 호출 (입력 처리 등), 비어 있으면 그냥 대기
+  std::function<void()> waitCallback;
+
+  // vkQueueSubmit 직전에 호출 (late latch), 이 frame의 fence는 이미 signal된 상태
+  std::function<void()> beforeSubmitCallback;
+
+  // 이번 frame의 fence 대기 시간, submit/present 시각과 result를 기록할 곳
+  // renderer가 frame마다 설정, 비어 있으면 기록하지 않음
+  LveFlightRecorder::FrameRecord *flightRecord = nullptr;
+
 private:
   void init();
 
   /**
    * @brief 스왑체인 생성에 필요한 설정을 구성 및 instace 생성
    *
+   * @param previous 교체할 이전 스왑체인, 없으면 VK_NULL_HANDLE
    */
-  void createSwapChain();
+  void createSwapChain(VkSwapchainKHR previous);
 
   /**
    * @brief  GPU가 해당 이미지를 렌더링 파이프라인에서 해석할 수 있도록 준비
@@ -146,6 +195,13 @@ private:
    */
   VkExtent2D chooseSwapExtent(const VkSurfaceCapabilitiesKHR &capabilities);
 
+  /**
+   * @brief extent에 의존하는 object를 LveDevice의 deferred destruction으로 넘김
+   *
+   * @param lastUse 이 object를 마지막으로 사용한 submit 번호
+   */
+  void retireExtentResources(uint64_t lastUse);
+
   VkFormat swapChainImageFormat;
   VkFormat swapChainDepthFormat;
   VkExtent2D swapChainExtent;
@@ -162,6 +218,9 @@ private:
   LveDevice &device;
   VkExtent2D windowExtent;
 
+  LveFramePacing framePacing;
+  VkPresentModeKHR presentMode;
+
   VkSwapchainKHR swapChain;
   std::shared_ptr<LveSwapChain> oldSwapChain;
 
@@ -170,6 +229,9 @@ private:
   std::vector<VkFence> inFlightFences;
   std::vector<VkFence> imagesInFlight;
   size_t currentFrame = 0;
+
+  // frame마다 마지막 submit 번호 (LveDevice::advanceSubmission)
+  std::vector<uint64_t> frameSubmissions;
 };
 
 } // namespace lve
@@ -0,0 +1,83 @@
+#include "lve_trace.hpp"
+
+// std
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+namespace lve {
+
+namespace {
+
+void writeString(std::ostream &out, const char *text) {
+  out << '"';
+  for (const char *c = text; *c != '\0'; c++) {
+    if (*c == '"' || *c == '\\') {
+      out << '\\' << *c;
+    } else if (static_cast<unsigned char>(*c) < 0x20) {
+      out << ' ';
+    } else {
+      out << *c;
+    }
+  }
+  out << '"';
+}
+
+} // namespace
+
+void LveTrace::write(std::ostream &out,
+                     const std::vector<LveTraceEvent> &events,
+                     const std::vector<LveTraceThread> &threads) {
+  // viewer가 시간 0 근처부터 보여주도록 가장 이른 event 기준으로 옮김
+  double originUs = 0.0;
+  if (!events.empty()) {
+    originUs = std::min_element(events.begin(), events.end(),
+                                [](const auto &a, const auto &b) {
+                                  return a.beginUs < b.beginUs;
+                                })
+                   ->beginUs;
+  }
+
+  const auto flags = out.flags();
+  const auto precision = out.precision();
+  out << std::fixed << std::setprecision(3);
+
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  for (const auto &thread : threads) {
+    out << (first ? "\n" : ",\n");
+    first = false;
+    out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+        << thread.threadId << ",\"args\":{\"name\":";
+    writeString(out, thread.name.c_str());
+    out << "}}";
+  }
+  for (const auto &event : events) {
+    out << (first ? "\n" : ",\n");
+    first = false;
+    out << "{\"name\":";
+    writeString(out, event.name);
+    out << ",\"cat\":";
+    writeString(out, event.category);
+    out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadId
+        << ",\"ts\":" << event.beginUs - originUs
+        << ",\"dur\":" << event.durationUs << "}";
+  }
+  out << "\n]}\n";
+
+  out.flags(flags);
+  out.precision(precision);
+}
+
+bool LveTrace::writeFile(const std::string &path,
+                         const std::vector<LveTraceEvent> &events,
+                         const std::vector<LveTraceThread> &threads) {
+  std::ofstream file{path};
+  if (!file.is_open()) {
+    return false;
+  }
+  write(file, events, threads);
+  return file.good();
+}
+
+} // namespace lve
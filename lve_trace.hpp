@@ -0,0 +1,58 @@
+#pragma once
+
+// std
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace lve {
+
+/**
+ * @brief 시작 시간과 길이를 가진 구간 하나 (Chrome trace의 complete event)
+ * CPU, GPU 구간 모두 steady_clock 기준 microsecond로 맞춰서 저장
+ */
+struct LveTraceEvent {
+  // 문자열 literal처럼 trace를 내보낼 때까지 유효해야 함
+  const char *name = "";
+  const char *category = "";
+  uint32_t threadId = 0;
+  double beginUs = 0.0;
+  double durationUs = 0.0;
+};
+
+// trace에서 threadId에 붙일 이름 (track 이름)
+struct LveTraceThread {
+  uint32_t threadId = 0;
+  std::string name;
+};
+
+/**
+ * @brief Chrome trace event format(JSON)으로 출력
+ * chrome://tracing, ui.perfetto.dev에서 열 수 있음
+ */
+class LveTrace {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  // GPU queue 구간을 표시하는 track
+  static constexpr uint32_t GPU_THREAD_ID = 0xFFFF0000u;
+
+  static double toMicroseconds(Clock::time_point time) {
+    return std::chrono::duration<double, std::micro>(time.time_since_epoch())
+        .count();
+  }
+
+  static void write(std::ostream &out, const std::vector<LveTraceEvent> &events,
+                    const std::vector<LveTraceThread> &threads);
+
+  /**
+   * @return 파일을 열지 못하면 false
+   */
+  static bool writeFile(const std::string &path,
+                        const std::vector<LveTraceEvent> &events,
+                        const std::vector<LveTraceThread> &threads);
+};
+
+} // namespace lve
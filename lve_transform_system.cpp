@@ -0,0 +1,256 @@
+#include "lve_transform_system.hpp"
+
+// std
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace lve {
+
+namespace {
+
+// GCC/Clang vector extension -> x86에서는 SSE/AVX, ARM에서는 NEON 명령으로 변환
+constexpr size_t LANES = LveTransformSystem::LANES;
+typedef float floatv __attribute__((vector_size(LANES * sizeof(float))));
+typedef int32_t intv __attribute__((vector_size(LANES * sizeof(int32_t))));
+
+inline floatv load(const float *ptr) {
+  floatv v;
+  std::memcpy(&v, ptr, sizeof(v));
+  return v;
+}
+
+inline floatv splat(float value) { return floatv{} + value; }
+
+inline floatv bitAnd(floatv a, intv mask) {
+  return reinterpret_cast<floatv>(reinterpret_cast<intv>(a) & mask);
+}
+
+inline floatv bitXor(floatv a, intv mask) {
+  return reinterpret_cast<floatv>(reinterpret_cast<intv>(a) ^ mask);
+}
+
+// Cephes sinf/cosf를 lane 단위로 옮긴 것, |x| < 8192 범위에서 오차 ~1e-7
+// 한 번의 range reduction으로 sin과 cos를 같이 구함
+inline void sincos(floatv x, floatv &s, floatv &c) {
+  const intv signMask = intv{} + static_cast<int32_t>(0x80000000u);
+
+  intv signSin = reinterpret_cast<intv>(x) & signMask;
+  x = bitAnd(x, ~signMask);
+
+  // x를 pi/4 구간으로 나눈 index (짝수로 올림)
+  intv j = __builtin_convertvector(x * splat(1.27323954473516f), intv);
+  j = (j + 1) & ~1;
+  floatv y = __builtin_convertvector(j, floatv);
+
+  intv swapSignSin = (j & 4) << 29;
+  intv polyMask = (j & 2) == 0;
+  intv signCos = (~(j - 2) & 4) << 29;
+  signSin ^= swapSignSin;
+
+  // 확장 정밀도 modular arithmetic
+  x = ((x - y * splat(0.78515625f)) - y * splat(2.4187564849853515625e-4f)) -
+      y * splat(3.77489497744594108e-8f);
+
+  const floatv z = x * x;
+
+  floatv cosPoly = (splat(2.443315711809948e-5f) * z -
+                    splat(1.388731625493765e-3f)) *
+                       z +
+                   splat(4.166664568298827e-2f);
+  cosPoly = cosPoly * z * z - splat(0.5f) * z + splat(1.f);
+
+  floatv sinPoly = (splat(-1.9515295891e-4f) * z + splat(8.3321608736e-3f)) * z -
+                   splat(1.6666654611e-1f);
+  sinPoly = sinPoly * z * x + x;
+
+  // 구간에 따라 sin/cos polynomial을 서로 바꿔서 사용
+  const floatv sinFromSin = bitAnd(sinPoly, polyMask);
+  const floatv sinFromCos = bitAnd(cosPoly, ~polyMask);
+  s = bitXor(sinFromSin + sinFromCos, signSin);
+  c = bitXor((cosPoly - sinFromCos) + (sinPoly - sinFromSin), signCos);
+}
+
+// LANES개 객체를 한 번에 계산, 결과는 out[0..LANES)
+inline void computeBlock(const float *tx, const float *ty, const float *tz,
+                         const float *rx, const float *ry, const float *rz,
+                         const float *sx, const float *sy, const float *sz,
+                         glm::mat4 *out) {
+  floatv s1, c1, s2, c2, s3, c3;
+  sincos(load(ry), s1, c1);
+  sincos(load(rx), s2, c2);
+  sincos(load(rz), s3, c3);
+
+  const floatv scaleX = load(sx);
+  const floatv scaleY = load(sy);
+  const floatv scaleZ = load(sz);
+
+  // TransformComponent::mat4()와 같은 식
+  const floatv m00 = scaleX * (c1 * c3 + s1 * s2 * s3);
+  const floatv m01 = scaleX * (c2 * s3);
+  const floatv m02 = scaleX * (c1 * s2 * s3 - c3 * s1);
+  const floatv m10 = scaleY * (c3 * s1 * s2 - c1 * s3);
+  const floatv m11 = scaleY * (c2 * c3);
+  const floatv m12 = scaleY * (c1 * c3 * s2 + s1 * s3);
+  const floatv m20 = scaleZ * (c2 * s1);
+  const floatv m21 = scaleZ * (-s2);
+  const floatv m22 = scaleZ * (c1 * c2);
+
+  // SoA -> AoS 전치하여 저장
+  for (size_t lane = 0; lane < LANES; lane++) {
+    out[lane] = glm::mat4{{m00[lane], m01[lane], m02[lane], 0.f},
+                          {m10[lane], m11[lane], m12[lane], 0.f},
+                          {m20[lane], m21[lane], m22[lane], 0.f},
+                          {tx[lane], ty[lane], tz[lane], 1.f}};
+  }
+}
+
+} // namespace
+
+LveTransformSystem::handle_t
+LveTransformSystem::add(const TransformComponent &transform) {
+  handle_t handle;
+  if (!freeHandles.empty()) {
+    handle = freeHandles.back();
+    freeHandles.pop_back();
+  } else {
+    handle = static_cast<handle_t>(capacity());
+    translationX.push_back(0.f);
+    translationY.push_back(0.f);
+    translationZ.push_back(0.f);
+    rotationX.push_back(0.f);
+    rotationY.push_back(0.f);
+    rotationZ.push_back(0.f);
+    scaleX.push_back(1.f);
+    scaleY.push_back(1.f);
+    scaleZ.push_back(1.f);
+    worldMatrices.emplace_back(1.f);
+    if (dirtyBits.size() * 64 < capacity()) {
+      dirtyBits.push_back(0);
+    }
+  }
+
+  set(handle, transform);
+  return handle;
+}
+
+void LveTransformSystem::remove(handle_t handle) {
+  assert(handle < capacity() && "Invalid transform handle");
+  dirtyBits[handle / 64] &= ~(uint64_t{1} << (handle % 64));
+  freeHandles.push_back(handle);
+}
+
+void LveTransformSystem::setTranslation(handle_t handle,
+                                        const glm::vec3 &translation) {
+  translationX[handle] = translation.x;
+  translationY[handle] = translation.y;
+  translationZ[handle] = translation.z;
+  markDirty(handle);
+}
+
+void LveTransformSystem::setRotation(handle_t handle,
+                                     const glm::vec3 &rotation) {
+  rotationX[handle] = rotation.x;
+  rotationY[handle] = rotation.y;
+  rotationZ[handle] = rotation.z;
+  markDirty(handle);
+}
+
+void LveTransformSystem::setScale(handle_t handle, const glm::vec3 &scale) {
+  scaleX[handle] = scale.x;
+  scaleY[handle] = scale.y;
+  scaleZ[handle] = scale.z;
+  markDirty(handle);
+}
+
+void LveTransformSystem::set(handle_t handle,
+                             const TransformComponent &transform) {
+  setTranslation(handle, transform.translation);
+  setRotation(handle, transform.rotation);
+  setScale(handle, transform.scale);
+}
+
+glm::vec3 LveTransformSystem::getTranslation(handle_t handle) const {
+  return {translationX[handle], translationY[handle], translationZ[handle]};
+}
+
+glm::vec3 LveTransformSystem::getRotation(handle_t handle) const {
+  return {rotationX[handle], rotationY[handle], rotationZ[handle]};
+}
+
+glm::vec3 LveTransformSystem::getScale(handle_t handle) const {
+  return {scaleX[handle], scaleY[handle], scaleZ[handle]};
+}
+
+void LveTransformSystem::markAllDirty() {
+  std::fill(dirtyBits.begin(), dirtyBits.end(), ~uint64_t{0});
+  // 마지막 word에서 범위를 넘는 bit 제거
+  if (capacity() % 64 != 0) {
+    dirtyBits.back() = (uint64_t{1} << (capacity() % 64)) - 1;
+  }
+  for (handle_t handle : freeHandles) {
+    dirtyBits[handle / 64] &= ~(uint64_t{1} << (handle % 64));
+  }
+}
+
+size_t LveTransformSystem::update() {
+  const size_t count = capacity();
+  const uint64_t laneMask = (uint64_t{1} << LANES) - 1;
+  size_t updated = 0;
+
+  for (size_t word = 0; word < dirtyBits.size(); word++) {
+    uint64_t bits = dirtyBits[word];
+    if (bits == 0) {
+      continue;
+    }
+    updated += static_cast<size_t>(__builtin_popcountll(bits));
+
+    // dirty 객체가 하나라도 있는 LANES 묶음만 통째로 다시 계산
+    for (size_t lane = 0; lane < 64; lane += LANES) {
+      if (((bits >> lane) & laneMask) == 0) {
+        continue;
+      }
+      const size_t first = word * 64 + lane;
+      const size_t blockSize = std::min<size_t>(LANES, count - first);
+      computeMatrices(&translationX[first], &translationY[first],
+                      &translationZ[first], &rotationX[first],
+                      &rotationY[first], &rotationZ[first], &scaleX[first],
+                      &scaleY[first], &scaleZ[first], &worldMatrices[first],
+                      blockSize);
+    }
+    dirtyBits[word] = 0;
+  }
+
+  return updated;
+}
+
+void LveTransformSystem::computeMatrices(const float *tx, const float *ty,
+                                         const float *tz, const float *rx,
+                                         const float *ry, const float *rz,
+                                         const float *sx, const float *sy,
+                                         const float *sz, glm::mat4 *out,
+                                         size_t count) {
+  size_t i = 0;
+  for (; i + LANES <= count; i += LANES) {
+    computeBlock(tx + i, ty + i, tz + i, rx + i, ry + i, rz + i, sx + i,
+                 sy + i, sz + i, out + i);
+  }
+
+  if (i == count) {
+    return;
+  }
+
+  // 남은 객체는 임시 배열에 채워서 같은 kernel로 처리
+  const size_t rest = count - i;
+  float pad[9][LANES] = {};
+  const float *sources[9] = {tx, ty, tz, rx, ry, rz, sx, sy, sz};
+  for (size_t component = 0; component < 9; component++) {
+    std::memcpy(pad[component], sources[component] + i, rest * sizeof(float));
+  }
+  glm::mat4 results[LANES];
+  computeBlock(pad[0], pad[1], pad[2], pad[3], pad[4], pad[5], pad[6], pad[7],
+               pad[8], results);
+  std::copy(results, results + rest, out + i);
+}
+
+} // namespace lve
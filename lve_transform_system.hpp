@@ -0,0 +1,116 @@
+#pragma once
+
+#include "lve_game_object.hpp"
+
+// libs
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+// std
+#include <cstdint>
+#include <vector>
+
+namespace lve {
+
+/**
+ * @brief translation, rotation, scale을 SoA 배열로 보관하고
+ * 변경된 객체의 world matrix만 다시 계산하는 transform system
+ *
+ * 계산은 한 번에 LANES개(AVX 8, 그 외 4) 객체를 처리하는 SIMD kernel로 수행
+ * 결과는 TransformComponent::mat4()와 같은 Translate * Ry * Rx * Rz * Scale
+ */
+class LveTransformSystem {
+public:
+  using handle_t = uint32_t;
+
+  // SIMD kernel 한 번에 처리하는 객체 수
+#if defined(__AVX__)
+  static constexpr uint32_t LANES = 8;
+#else
+  static constexpr uint32_t LANES = 4;
+#endif
+
+  LveTransformSystem() = default;
+
+  LveTransformSystem(const LveTransformSystem &) = delete;
+  LveTransformSystem &operator=(const LveTransformSystem &) = delete;
+
+  /**
+   * @brief transform을 추가하고 handle 반환, 새 객체는 dirty 상태로 시작
+   *
+   * @param transform 초기 transform
+   * @return handle_t
+   */
+  handle_t add(const TransformComponent &transform);
+
+  /**
+   * @brief transform 제거, handle은 free list로 돌아가 재사용됨
+   *
+   * @param handle
+   */
+  void remove(handle_t handle);
+
+  void setTranslation(handle_t handle, const glm::vec3 &translation);
+  void setRotation(handle_t handle, const glm::vec3 &rotation);
+  void setScale(handle_t handle, const glm::vec3 &scale);
+  void set(handle_t handle, const TransformComponent &transform);
+
+  glm::vec3 getTranslation(handle_t handle) const;
+  glm::vec3 getRotation(handle_t handle) const;
+  glm::vec3 getScale(handle_t handle) const;
+
+  /**
+   * @brief 모든 객체를 dirty로 표시 (벤치마크, 일괄 초기화용)
+   */
+  void markAllDirty();
+
+  /**
+   * @brief dirty 객체의 world matrix를 다시 계산
+   *
+   * @return 이번 호출에서 다시 계산한 객체 수
+   */
+  size_t update();
+
+  /**
+   * @brief 마지막 update() 기준 world matrix 반환
+   */
+  const glm::mat4 &worldMatrix(handle_t handle) const {
+    return worldMatrices[handle];
+  }
+
+  bool isDirty(handle_t handle) const {
+    return (dirtyBits[handle / 64] >> (handle % 64)) & 1u;
+  }
+
+  // slot 수 (제거된 slot 포함)
+  size_t capacity() const { return translationX.size(); }
+  size_t size() const { return capacity() - freeHandles.size(); }
+
+  /**
+   * @brief SoA 입력에서 count개 객체의 matrix를 계산하는 SIMD kernel
+   * 다른 system(scene graph 등)에서도 local matrix 계산에 재사용
+   */
+  static void computeMatrices(const float *tx, const float *ty, const float *tz,
+                              const float *rx, const float *ry, const float *rz,
+                              const float *sx, const float *sy, const float *sz,
+                              glm::mat4 *out, size_t count);
+
+private:
+  void markDirty(handle_t handle) {
+    dirtyBits[handle / 64] |= uint64_t{1} << (handle % 64);
+  }
+
+  // SoA 배열 -> 같은 성분끼리 연속이라 SIMD load가 가능
+  std::vector<float> translationX, translationY, translationZ;
+  std::vector<float> rotationX, rotationY, rotationZ;
+  std::vector<float> scaleX, scaleY, scaleZ;
+
+  std::vector<glm::mat4> worldMatrices;
+
+  // 객체 하나당 1bit, 64개씩 묶어서 dirty 여부 확인
+  std::vector<uint64_t> dirtyBits;
+  std::vector<handle_t> freeHandles;
+};
+
+} // namespace lve
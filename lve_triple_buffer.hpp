@@ -0,0 +1,66 @@
+#pragma once
+
+// std
+#include <atomic>
+#include <cstdint>
+
+namespace lve {
+
+/**
+ * @brief producer 하나, consumer 하나 사이의 lock-free triple buffer
+ *
+ * producer는 back()에 쓰고 publish(), consumer는 update() 후 front()를 읽음
+ * 세 slot을 돌려 쓰므로 양쪽 모두 기다리지 않고, consumer는 항상 가장 최근에
+ * 완성된 값만 봄 (중간 값은 건너뜀)
+ */
+template <typename T> class LveTripleBuffer {
+public:
+  LveTripleBuffer() = default;
+
+  LveTripleBuffer(const LveTripleBuffer &) = delete;
+  LveTripleBuffer &operator=(const LveTripleBuffer &) = delete;
+
+  // producer 전용
+  T &back() { return slots[backIndex].value; }
+
+  // producer 전용, back을 consumer 쪽으로 넘기고 새 back을 받음
+  void publish() {
+    const uint8_t previous =
+        middle.exchange(backIndex | FRESH, std::memory_order_acq_rel);
+    backIndex = previous & INDEX_MASK;
+  }
+
+  /**
+   * @brief consumer 전용, 새로 publish된 값이 있으면 front로 가져옴
+   *
+   * @return front가 바뀌었는지 여부
+   */
+  bool update() {
+    if ((middle.load(std::memory_order_relaxed) & FRESH) == 0) {
+      return false;
+    }
+    const uint8_t previous =
+        middle.exchange(frontIndex, std::memory_order_acq_rel);
+    frontIndex = previous & INDEX_MASK;
+    return true;
+  }
+
+  // consumer 전용
+  const T &front() const { return slots[frontIndex].value; }
+
+private:
+  static constexpr uint8_t INDEX_MASK = 0x3;
+  static constexpr uint8_t FRESH = 0x4;
+
+  // slot마다 cache line을 따로 사용 -> false sharing 방지
+  struct alignas(64) Slot {
+    T value{};
+  };
+
+  Slot slots[3];
+  alignas(64) std::atomic<uint8_t> middle{1};
+  alignas(64) uint8_t backIndex = 0;
+  alignas(64) uint8_t frontIndex = 2;
+};
+
+} // namespace lve
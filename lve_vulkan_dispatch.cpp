@@ -0,0 +1,85 @@
+#include "lve_vulkan_dispatch.hpp"
+
+namespace lve {
+
+thread_local LveVulkanStats::FrameStats LveVulkanStats::frame{};
+
+uint64_t LveVulkanStats::FrameStats::commandCount() const {
+  uint64_t count = 0;
+  for (uint32_t call = 0; call < FIRST_NON_COMMAND; call++) {
+    count += calls[call].count;
+  }
+  return count;
+}
+
+double LveVulkanStats::FrameStats::cpuMs() const {
+  double ms = 0.0;
+  for (const auto &call : calls) {
+    ms += call.cpuMs;
+  }
+  return ms;
+}
+
+const char *LveVulkanStats::callName(Call call) {
+  switch (call) {
+  case BIND_PIPELINE:
+    return "vkCmdBindPipeline";
+  case BIND_DESCRIPTOR_SETS:
+    return "vkCmdBindDescriptorSets";
+  case BIND_VERTEX_BUFFERS:
+    return "vkCmdBindVertexBuffers";
+  case BIND_INDEX_BUFFER:
+    return "vkCmdBindIndexBuffer";
+  case PUSH_CONSTANTS:
+    return "vkCmdPushConstants";
+  case DRAW:
+    return "vkCmdDraw";
+  case DRAW_INDEXED:
+    return "vkCmdDrawIndexed";
+  case BEGIN_RENDER_PASS:
+    return "vkCmdBeginRenderPass";
+  case END_RENDER_PASS:
+    return "vkCmdEndRenderPass";
+  case SET_VIEWPORT:
+    return "vkCmdSetViewport";
+  case SET_SCISSOR:
+    return "vkCmdSetScissor";
+  case RESET_QUERY_POOL:
+    return "vkCmdResetQueryPool";
+  case WRITE_TIMESTAMP:
+    return "vkCmdWriteTimestamp";
+  case BEGIN_QUERY:
+    return "vkCmdBeginQuery";
+  case END_QUERY:
+    return "vkCmdEndQuery";
+  case COPY_BUFFER:
+    return "vkCmdCopyBuffer";
+  case COPY_BUFFER_TO_IMAGE:
+    return "vkCmdCopyBufferToImage";
+  case COPY_IMAGE_TO_BUFFER:
+    return "vkCmdCopyImageToBuffer";
+  case PIPELINE_BARRIER:
+    return "vkCmdPipelineBarrier";
+  case BEGIN_COMMAND_BUFFER:
+    return "vkBeginCommandBuffer";
+  case END_COMMAND_BUFFER:
+    return "vkEndCommandBuffer";
+  case QUEUE_SUBMIT:
+    return "vkQueueSubmit";
+  case QUEUE_WAIT_IDLE:
+    return "vkQueueWaitIdle";
+  case QUEUE_PRESENT:
+    return "vkQueuePresentKHR";
+  case WAIT_FOR_FENCES:
+    return "vkWaitForFences";
+  case RESET_FENCES:
+    return "vkResetFences";
+  case ACQUIRE_NEXT_IMAGE:
+    return "vkAcquireNextImageKHR";
+  case CALL_COUNT:
+    break;
+  }
+  return "unknown";
+}
+
+} // namespace lve
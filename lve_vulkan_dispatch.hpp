@@ -0,0 +1,345 @@
+#pragma once
+
+// libs
+#include <vulkan/vulkan.h>
+
+// std
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+// 0이면 counter와 timing이 모두 사라지고 wrapper는 vk* 호출만 남음
+// (-DLVE_VULKAN_STATS=0)
+#ifndef LVE_VULKAN_STATS
+#define LVE_VULKAN_STATS 1
+#endif
+
+namespace lve {
+
+/**
+ * @brief engine이 호출하는 Vulkan 함수의 호출 수와 CPU 시간 집계
+ *
+ * vk* 대신 lve::vkd::* wrapper를 호출하면 여기에 기록됨
+ * thread마다 따로 집계(thread_local) -> atomic 없이 기록
+ * LveRenderer가 beginFrame()마다 render thread 값을 잘라서 frame 단위로
+ * getFrameStats()에 보관 (render thread에서 한 upload, query, copy 포함)
+ */
+class LveVulkanStats {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  enum Call : uint32_t {
+    // command buffer 기록
+    BIND_PIPELINE,
+    BIND_DESCRIPTOR_SETS,
+    BIND_VERTEX_BUFFERS,
+    BIND_INDEX_BUFFER,
+    PUSH_CONSTANTS,
+    DRAW,
+    DRAW_INDEXED,
+    BEGIN_RENDER_PASS,
+    END_RENDER_PASS,
+    SET_VIEWPORT,
+    SET_SCISSOR,
+    RESET_QUERY_POOL,
+    WRITE_TIMESTAMP,
+    BEGIN_QUERY,
+    END_QUERY,
+    COPY_BUFFER,
+    COPY_BUFFER_TO_IMAGE,
+    COPY_IMAGE_TO_BUFFER,
+    PIPELINE_BARRIER,
+    // 여기부터는 vkCmd*가 아님
+    BEGIN_COMMAND_BUFFER,
+    END_COMMAND_BUFFER,
+    QUEUE_SUBMIT,
+    QUEUE_WAIT_IDLE,
+    QUEUE_PRESENT,
+    WAIT_FOR_FENCES,
+    RESET_FENCES,
+    ACQUIRE_NEXT_IMAGE,
+    CALL_COUNT
+  };
+  static constexpr uint32_t FIRST_NON_COMMAND = BEGIN_COMMAND_BUFFER;
+
+  struct CallStats {
+    uint64_t count = 0;
+    // timingEnabled일 때만 누적
+    double cpuMs = 0.0;
+  };
+
+  struct FrameStats {
+    std::array<CallStats, CALL_COUNT> calls{};
+
+    const CallStats &operator[](Call call) const { return calls[call]; }
+
+    // vkCmd* 호출 합계
+    uint64_t commandCount() const;
+    uint64_t drawCount() const {
+      return calls[DRAW].count + calls[DRAW_INDEXED].count;
+    }
+    // 모든 호출의 CPU 시간 합계
+    double cpuMs() const;
+  };
+
+  static const char *callName(Call call);
+
+  // true면 호출마다 시간 측정 (Clock::now() 두 번), 기본값 꺼짐
+  static inline bool timingEnabled = false;
+
+  static const FrameStats &current() { return frame; }
+
+  /**
+   * @brief 지금까지 집계한 값을 반환하고 0부터 다시 집계
+   */
+  static FrameStats take() {
+    FrameStats taken = frame;
+    frame = FrameStats{};
+    return taken;
+  }
+
+  // wrapper 하나의 호출 구간
+  class Scope {
+  public:
+    explicit Scope(Call call) : call{call}, timed{timingEnabled} {
+      frame.calls[call].count++;
+      if (timed) {
+        start = Clock::now();
+      }
+    }
+    ~Scope() {
+      if (timed) {
+        frame.calls[call].cpuMs +=
+            std::chrono::duration<double, std::milli>(Clock::now() - start)
+                .count();
+      }
+    }
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+  private:
+    Call call;
+    bool timed;
+    Clock::time_point start{};
+  };
+
+private:
+  static thread_local FrameStats frame;
+};
+
+#if LVE_VULKAN_STATS
+#define LVE_VK_SCOPE(call)                                                     \
+  ::lve::LveVulkanStats::Scope lveVkScope { ::lve::LveVulkanStats::call }
+#else
+#define LVE_VK_SCOPE(call) ((void)0)
+#endif
+
+/**
+ * @brief 집계하는 Vulkan 함수 wrapper, 인자는 vk* 함수와 같음
+ * LVE_VULKAN_STATS=0이면 inline된 vk* 호출만 남음
+ */
+namespace vkd {
+
+inline void cmdBindPipeline(VkCommandBuffer commandBuffer,
+                            VkPipelineBindPoint bindPoint,
+                            VkPipeline pipeline) {
+  LVE_VK_SCOPE(BIND_PIPELINE);
+  vkCmdBindPipeline(commandBuffer, bindPoint, pipeline);
+}
+
+inline void cmdBindDescriptorSets(VkCommandBuffer commandBuffer,
+                                  VkPipelineBindPoint bindPoint,
+                                  VkPipelineLayout layout, uint32_t firstSet,
+                                  uint32_t setCount,
+                                  const VkDescriptorSet *sets,
+                                  uint32_t dynamicOffsetCount,
+                                  const uint32_t *dynamicOffsets) {
+  LVE_VK_SCOPE(BIND_DESCRIPTOR_SETS);
+  vkCmdBindDescriptorSets(commandBuffer, bindPoint, layout, firstSet, setCount,
+                          sets, dynamicOffsetCount, dynamicOffsets);
+}
+
+inline void cmdBindVertexBuffers(VkCommandBuffer commandBuffer,
+                                 uint32_t firstBinding, uint32_t bindingCount,
+                                 const VkBuffer *buffers,
+                                 const VkDeviceSize *offsets) {
+  LVE_VK_SCOPE(BIND_VERTEX_BUFFERS);
+  vkCmdBindVertexBuffers(commandBuffer, firstBinding, bindingCount, buffers,
+                         offsets);
+}
+
+inline void cmdBindIndexBuffer(VkCommandBuffer commandBuffer, VkBuffer buffer,
+                               VkDeviceSize offset, VkIndexType indexType) {
+  LVE_VK_SCOPE(BIND_INDEX_BUFFER);
+  vkCmdBindIndexBuffer(commandBuffer, buffer, offset, indexType);
+}
+
+inline void cmdPushConstants(VkCommandBuffer commandBuffer,
+                             VkPipelineLayout layout,
+                             VkShaderStageFlags stageFlags, uint32_t offset,
+                             uint32_t size, const void *values) {
+  LVE_VK_SCOPE(PUSH_CONSTANTS);
+  vkCmdPushConstants(commandBuffer, layout, stageFlags, offset, size, values);
+}
+
+inline void cmdDraw(VkCommandBuffer commandBuffer, uint32_t vertexCount,
+                    uint32_t instanceCount, uint32_t firstVertex,
+                    uint32_t firstInstance) {
+  LVE_VK_SCOPE(DRAW);
+  vkCmdDraw(commandBuffer, vertexCount, instanceCount, firstVertex,
+            firstInstance);
+}
+
+inline void cmdDrawIndexed(VkCommandBuffer commandBuffer, uint32_t indexCount,
+                           uint32_t instanceCount, uint32_t firstIndex,
+                           int32_t vertexOffset, uint32_t firstInstance) {
+  LVE_VK_SCOPE(DRAW_INDEXED);
+  vkCmdDrawIndexed(commandBuffer, indexCount, instanceCount, firstIndex,
+                   vertexOffset, firstInstance);
+}
+
+inline void cmdBeginRenderPass(VkCommandBuffer commandBuffer,
+                               const VkRenderPassBeginInfo *beginInfo,
+                               VkSubpassContents contents) {
+  LVE_VK_SCOPE(BEGIN_RENDER_PASS);
+  vkCmdBeginRenderPass(commandBuffer, beginInfo, contents);
+}
+
+inline void cmdEndRenderPass(VkCommandBuffer commandBuffer) {
+  LVE_VK_SCOPE(END_RENDER_PASS);
+  vkCmdEndRenderPass(commandBuffer);
+}
+
+inline void cmdSetViewport(VkCommandBuffer commandBuffer,
+                           uint32_t firstViewport, uint32_t viewportCount,
+                           const VkViewport *viewports) {
+  LVE_VK_SCOPE(SET_VIEWPORT);
+  vkCmdSetViewport(commandBuffer, firstViewport, viewportCount, viewports);
+}
+
+inline void cmdSetScissor(VkCommandBuffer commandBuffer, uint32_t firstScissor,
+                          uint32_t scissorCount, const VkRect2D *scissors) {
+  LVE_VK_SCOPE(SET_SCISSOR);
+  vkCmdSetScissor(commandBuffer, firstScissor, scissorCount, scissors);
+}
+
+inline void cmdResetQueryPool(VkCommandBuffer commandBuffer,
+                              VkQueryPool queryPool, uint32_t firstQuery,
+                              uint32_t queryCount) {
+  LVE_VK_SCOPE(RESET_QUERY_POOL);
+  vkCmdResetQueryPool(commandBuffer, queryPool, firstQuery, queryCount);
+}
+
+inline void cmdWriteTimestamp(VkCommandBuffer commandBuffer,
+                              VkPipelineStageFlagBits pipelineStage,
+                              VkQueryPool queryPool, uint32_t query) {
+  LVE_VK_SCOPE(WRITE_TIMESTAMP);
+  vkCmdWriteTimestamp(commandBuffer, pipelineStage, queryPool, query);
+}
+
+inline void cmdBeginQuery(VkCommandBuffer commandBuffer, VkQueryPool queryPool,
+                          uint32_t query, VkQueryControlFlags flags) {
+  LVE_VK_SCOPE(BEGIN_QUERY);
+  vkCmdBeginQuery(commandBuffer, queryPool, query, flags);
+}
+
+inline void cmdEndQuery(VkCommandBuffer commandBuffer, VkQueryPool queryPool,
+                        uint32_t query) {
+  LVE_VK_SCOPE(END_QUERY);
+  vkCmdEndQuery(commandBuffer, queryPool, query);
+}
+
+inline void cmdCopyBuffer(VkCommandBuffer commandBuffer, VkBuffer srcBuffer,
+                          VkBuffer dstBuffer, uint32_t regionCount,
+                          const VkBufferCopy *regions) {
+  LVE_VK_SCOPE(COPY_BUFFER);
+  vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, regionCount, regions);
+}
+
+inline void cmdCopyBufferToImage(VkCommandBuffer commandBuffer,
+                                 VkBuffer srcBuffer, VkImage dstImage,
+                                 VkImageLayout dstImageLayout,
+                                 uint32_t regionCount,
+                                 const VkBufferImageCopy *regions) {
+  LVE_VK_SCOPE(COPY_BUFFER_TO_IMAGE);
+  vkCmdCopyBufferToImage(commandBuffer, srcBuffer, dstImage, dstImageLayout,
+                         regionCount, regions);
+}
+
+inline void cmdCopyImageToBuffer(VkCommandBuffer commandBuffer,
+                                 VkImage srcImage, VkImageLayout srcImageLayout,
+                                 VkBuffer dstBuffer, uint32_t regionCount,
+                                 const VkBufferImageCopy *regions) {
+  LVE_VK_SCOPE(COPY_IMAGE_TO_BUFFER);
+  vkCmdCopyImageToBuffer(commandBuffer, srcImage, srcImageLayout, dstBuffer,
+                         regionCount, regions);
+}
+
+inline void cmdPipelineBarrier(
+    VkCommandBuffer commandBuffer, VkPipelineStageFlags srcStageMask,
+    VkPipelineStageFlags dstStageMask, VkDependencyFlags dependencyFlags,
+    uint32_t memoryBarrierCount, const VkMemoryBarrier *memoryBarriers,
+    uint32_t bufferMemoryBarrierCount,
+    const VkBufferMemoryBarrier *bufferMemoryBarriers,
+    uint32_t imageMemoryBarrierCount,
+    const VkImageMemoryBarrier *imageMemoryBarriers) {
+  LVE_VK_SCOPE(PIPELINE_BARRIER);
+  vkCmdPipelineBarrier(commandBuffer, srcStageMask, dstStageMask,
+                       dependencyFlags, memoryBarrierCount, memoryBarriers,
+                       bufferMemoryBarrierCount, bufferMemoryBarriers,
+                       imageMemoryBarrierCount, imageMemoryBarriers);
+}
+
+inline VkResult beginCommandBuffer(VkCommandBuffer commandBuffer,
+                                   const VkCommandBufferBeginInfo *beginInfo) {
+  LVE_VK_SCOPE(BEGIN_COMMAND_BUFFER);
+  return vkBeginCommandBuffer(commandBuffer, beginInfo);
+}
+
+inline VkResult endCommandBuffer(VkCommandBuffer commandBuffer) {
+  LVE_VK_SCOPE(END_COMMAND_BUFFER);
+  return vkEndCommandBuffer(commandBuffer);
+}
+
+inline VkResult queueSubmit(VkQueue queue, uint32_t submitCount,
+                            const VkSubmitInfo *submits, VkFence fence) {
+  LVE_VK_SCOPE(QUEUE_SUBMIT);
+  return vkQueueSubmit(queue, submitCount, submits, fence);
+}
+
+inline VkResult queueWaitIdle(VkQueue queue) {
+  LVE_VK_SCOPE(QUEUE_WAIT_IDLE);
+  return vkQueueWaitIdle(queue);
+}
+
+inline VkResult queuePresent(VkQueue queue,
+                             const VkPresentInfoKHR *presentInfo) {
+  LVE_VK_SCOPE(QUEUE_PRESENT);
+  return vkQueuePresentKHR(queue, presentInfo);
+}
+
+inline VkResult waitForFences(VkDevice device, uint32_t fenceCount,
+                              const VkFence *fences, VkBool32 waitAll,
+                              uint64_t timeout) {
+  LVE_VK_SCOPE(WAIT_FOR_FENCES);
+  return vkWaitForFences(device, fenceCount, fences, waitAll, timeout);
+}
+
+inline VkResult resetFences(VkDevice device, uint32_t fenceCount,
+                            const VkFence *fences) {
+  LVE_VK_SCOPE(RESET_FENCES);
+  return vkResetFences(device, fenceCount, fences);
+}
+
+inline VkResult acquireNextImage(VkDevice device, VkSwapchainKHR swapChain,
+                                 uint64_t timeout, VkSemaphore semaphore,
+                                 VkFence fence, uint32_t *imageIndex) {
+  LVE_VK_SCOPE(ACQUIRE_NEXT_IMAGE);
+  return vkAcquireNextImageKHR(device, swapChain, timeout, semaphore, fence,
+                               imageIndex);
+}
+
+} // namespace vkd
+
+} // namespace lve
@@ -5,8 +5,8 @@
 
 namespace lve {
 
-LveWindow::LveWindow(int w, int h, std::string name)
-    : width{w}, height{h}, windowName{name} {
+LveWindow::LveWindow(int w, int h, std::string name, bool headless)
+    : width{w}, height{h}, headless{headless}, windowName{name} {
   initWindow();
 }
 
@@ -17,7 +17,16 @@ LveWindow::~LveWindow() {
 }
 
 void LveWindow::initWindow() {
-  glfwInit();
+  if (headless) {
+#ifdef GLFW_PLATFORM_NULL
+    glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+#else
+    throw std::runtime_error("headless window requires GLFW 3.4 or later!");
+#endif
+  }
+  if (glfwInit() != GLFW_TRUE) {
+    throw std::runtime_error("failed to initialize GLFW!");
+  }
 
   //   OpenGL 대신 Vulkan이므로 OpenGL 컨텍스트를 생성하지 않도록 한다
   glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
@@ -25,6 +34,9 @@ void LveWindow::initWindow() {
   //    창이 크기 조정을 허용하지 않도록 설정한다
   //   glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
   glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
+  if (headless) {
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+  }
 
   window =
       glfwCreateWindow(width, height, windowName.c_str(), nullptr, nullptr);
@@ -32,6 +44,8 @@ void LveWindow::initWindow() {
   // glfw pointer 가져와서 callback 함수에 전달
   glfwSetWindowUserPointer(window, this);
   glfwSetFramebufferSizeCallback(window, framebufferResizeCallback);
+  glfwSetKeyCallback(window, keyCallbackDispatch);
+  glfwSetWindowRefreshCallback(window, windowRefreshCallback);
 }
 
 void LveWindow::createWindowSurface(VkInstance instance,
@@ -49,6 +63,23 @@ void LveWindow::framebufferResizeCallback(GLFWwindow *window, int width,
   lveWindow->framebufferResized = true;
   lveWindow->width = width;
   lveWindow->height = height;
+  lveWindow->redrawRequested.store(true, std::memory_order_release);
+}
+
+void LveWindow::keyCallbackDispatch(GLFWwindow *window, int key, int,
+                                    int action, int) {
+  auto lveWindow =
+      reinterpret_cast<LveWindow *>(glfwGetWindowUserPointer(window));
+  lveWindow->redrawRequested.store(true, std::memory_order_release);
+  if (lveWindow->keyCallback) {
+    lveWindow->keyCallback(key, action);
+  }
+}
+
+void LveWindow::windowRefreshCallback(GLFWwindow *window) {
+  auto lveWindow =
+      reinterpret_cast<LveWindow *>(glfwGetWindowUserPointer(window));
+  lveWindow->redrawRequested.store(true, std::memory_order_release);
 }
 
 } // namespace lve
\ No newline at end of file
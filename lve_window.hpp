@@ -2,6 +2,8 @@
 #define GLFW_INCLUDE_VULKAN
 
 #include <GLFW/glfw3.h>
+#include <atomic>
+#include <functional>
 #include <string>
 
 namespace lve {
@@ -17,8 +19,11 @@ public:
    * @param w width
    * @param h height
    * @param name window name
+   * @param headless true면 화면 없이 생성 (GLFW 3.4 null platform)
+   * surface는 VK_EXT_headless_surface로 만들어지므로 display 없는 CI에서도
+   * software Vulkan driver(lavapipe 등)로 그릴 수 있음
    */
-  LveWindow(int w, int h, std::string name);
+  LveWindow(int w, int h, std::string name, bool headless = false);
   ~LveWindow();
 
   // 복사 생성자, 대입 연산자 삭제하여 리소스의 유일성을 보장
@@ -60,6 +65,33 @@ public:
    */
   GLFWwindow *getGLFWwindow() const { return window; }
 
+  /**
+   * @brief key 입력 callback 등록 (glfwPollEvents 중에 main thread에서 호출)
+   *
+   * @param callback callback(key, action), action은 GLFW_PRESS/RELEASE/REPEAT
+   */
+  void setKeyCallback(std::function<void(int, int)> callback) {
+    keyCallback = std::move(callback);
+  }
+
+  /**
+   * @brief 다음 loop에서 다시 그리도록 표시 (on-demand redraw)
+   * 어느 thread에서나 호출 가능, glfwWaitEvents로 대기 중인 main thread를 깨움
+   * -> asset loading job 완료, scene 변경 등에서 호출
+   */
+  void requestRedraw() {
+    redrawRequested.store(true, std::memory_order_release);
+    glfwPostEmptyEvent();
+  }
+
+  /**
+   * @brief main thread 전용, redraw 요청이 있었으면 true를 반환하고 초기화
+   * key 입력, 크기 변경, window 노출(refresh)도 요청으로 처리됨
+   */
+  bool consumeRedrawRequest() {
+    return redrawRequested.exchange(false, std::memory_order_acquire);
+  }
+
   /**
    * @brief window surface 생성
    *
@@ -79,6 +111,12 @@ private:
   static void framebufferResizeCallback(GLFWwindow *window, int width,
                                         int height);
 
+  static void keyCallbackDispatch(GLFWwindow *window, int key, int scancode,
+                                  int action, int mods);
+
+  // window가 가려졌다가 다시 보이는 등 내용을 다시 그려야 할 때
+  static void windowRefreshCallback(GLFWwindow *window);
+
   /**
    * @brief glfw window 생성
    */
@@ -87,6 +125,11 @@ private:
   int width;
   int height;
   bool framebufferResized = false;
+  bool headless = false;
+  // 첫 frame은 항상 그림
+  std::atomic<bool> redrawRequested{true};
+
+  std::function<void(int, int)> keyCallback;
 
   std::string windowName;
   GLFWwindow *window;
@@ -1,17 +1,52 @@
 #include "first_app.hpp"
+#include "lve_flight_recorder.hpp"
+#include "lve_log.hpp"
 
 // std
 #include <cstdlib>
 #include <iostream>
 #include <stdexcept>
+#include <string>
 
-int main() {
-  lve::FirstApp app{};
+int main(int argc, char **argv) {
+  // --record-input <file>: 입력 기록, --replay-input <file>: 기록 재생
+  // --metrics <address>: metrics endpoint
+  //   (예: 127.0.0.1:9464, unix:/tmp/lve_metrics.sock)
+  // --log <file>: engine log를 stdout 대신 파일에 씀
+  lve::FirstApp::Options options{};
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (arg == "--record-input" && i + 1 < argc) {
+      options.recordInputPath = argv[++i];
+    } else if (arg == "--replay-input" && i + 1 < argc) {
+      options.replayInputPath = argv[++i];
+    } else if (arg == "--metrics" && i + 1 < argc) {
+      options.metricsAddress = argv[++i];
+    } else if (arg == "--log" && i + 1 < argc) {
+      if (!lve::LveLog::setFile(argv[++i])) {
+        std::cerr << "failed to open log file '" << argv[i] << "'\n";
+        return EXIT_FAILURE;
+      }
+    } else {
+      std::cerr << "unknown argument '" << arg << "'\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  // device 생성 중의 crash도 기록하도록 app보다 먼저 시작
+  if (!lve::LveFlightRecorder::start(lve::FirstApp::FLIGHT_RECORDER_FILE,
+                                     lve::FirstApp::FLIGHT_DUMP_FILE)) {
+    LVE_LOG_WARN << "failed to map " << lve::FirstApp::FLIGHT_RECORDER_FILE
+                 << ", flight recorder kept in memory only";
+  }
+
+  lve::FirstApp app{options};
 
   try {
     app.run();
   } catch (const std::exception &e) {
-    std::cerr << e.what() << "\n";
+    // 남은 log는 종료할 때 (atexit) 모두 씀
+    LVE_LOG_ERROR << e.what();
     return EXIT_FAILURE;
   }
 
@@ -0,0 +1,8 @@
+// overdraw 측정용, additive blend로 pixel마다 fragment 수를 셈
+#version 450
+
+layout(location = 0) in vec3 fragColor;
+
+layout(location = 0) out float outCount;
+
+void main() { outCount = 1.0; }
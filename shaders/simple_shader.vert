@@ -16,7 +16,13 @@ layout(push_constant) uniform Push {
 }
 push;
 
+// submit 직전에 쓰는 camera 보정 (최신 PV * inverse(기록 시점 PV))
+layout(set = 0, binding = 0) uniform LateLatch {
+  mat4 correction;
+}
+latch;
+
 void main() {
-  gl_Position = push.transform * vec4(position, 1.0);
+  gl_Position = latch.correction * push.transform * vec4(position, 1.0);
   fragColor = color;
 }
\ No newline at end of file
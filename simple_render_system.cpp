@@ -1,4 +1,7 @@
 #include "simple_render_system.hpp"
+#include "lve_log.hpp"
+#include "lve_profiler.hpp"
+#include "lve_vulkan_dispatch.hpp"
 
 // libs
 #define GLM_FORCE_RADIANS
@@ -21,9 +24,11 @@ struct SimplePushConstantData {
 };
 
 SimpleRenderSystem::SimpleRenderSystem(LveDevice &device,
-                                       VkRenderPass renderPass)
-    : lveDevice{device} {
-  createPipelineLayout();
+                                       VkRenderPass renderPass,
+                                       VkDescriptorSetLayout globalSetLayout,
+                                       VkRenderPass overdrawRenderPass)
+    : lveDevice{device}, overdrawRenderPass{overdrawRenderPass} {
+  createPipelineLayout(globalSetLayout);
   createPipeline(renderPass);
 }
 
@@ -31,7 +36,8 @@ SimpleRenderSystem::~SimpleRenderSystem() {
   vkDestroyPipelineLayout(lveDevice.device(), pipelineLayout, nullptr);
 }
 
-void SimpleRenderSystem::createPipelineLayout() {
+void SimpleRenderSystem::createPipelineLayout(
+    VkDescriptorSetLayout globalSetLayout) {
   VkPushConstantRange pushConstantRange{};
 
   pushConstantRange.stageFlags =
@@ -41,8 +47,8 @@ void SimpleRenderSystem::createPipelineLayout() {
 
   VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
   pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-  pipelineLayoutInfo.setLayoutCount = 0;
-  pipelineLayoutInfo.pSetLayouts = nullptr;
+  pipelineLayoutInfo.setLayoutCount = 1;
+  pipelineLayoutInfo.pSetLayouts = &globalSetLayout;
   pipelineLayoutInfo.pushConstantRangeCount = 1;
   pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
 
@@ -66,28 +72,144 @@ void SimpleRenderSystem::createPipeline(VkRenderPass renderPass) {
       "shaders/simple_shader.frag.spv", pipelineConfig);
 }
 
-void SimpleRenderSystem::renderGameObjects(
-    VkCommandBuffer commandBuffer, std::vector<LveGameObject> &gameObjects,
-    const LveCamera &camera) {
+void SimpleRenderSystem::createOverdrawPipeline(VkRenderPass renderPass) {
+  assert(pipelineLayout != nullptr &&
+         "Cannot create pipeline before pipeline layout");
 
-  lvePipeline->bind(commandBuffer);
+  // vertex shader와 push constant는 그대로 사용 -> 같은 layout
+  PipelineConfigInfo pipelineConfig{};
 
-  auto projectionView = camera.getProjection() * camera.getView();
+  LvePipeline::overdrawPipelineConfigInfo(pipelineConfig);
+  pipelineConfig.renderPass = renderPass;
+  pipelineConfig.pipelineLayout = pipelineLayout;
+  overdrawPipeline = std::make_unique<LvePipeline>(
+      lveDevice, "shaders/simple_shader.vert.spv", "shaders/overdraw.frag.spv",
+      pipelineConfig);
+}
 
-  for (auto &obj : gameObjects) {
+bool SimpleRenderSystem::prepareOverdraw() {
+  if (overdrawPipeline != nullptr) {
+    return true;
+  }
+  if (overdrawRenderPass == VK_NULL_HANDLE) {
+    return false;
+  }
+  try {
+    createOverdrawPipeline(overdrawRenderPass);
+  } catch (const std::runtime_error &e) {
+    LVE_LOG_WARN << "overdraw pipeline unavailable: " << e.what();
+    return false;
+  }
+  return true;
+}
 
-    SimplePushConstantData push{};
-    push.color = obj.color;
-    // push.transform = camera.getProjection() * obj.transform.mat4();
-    push.transform = projectionView * obj.transform.mat4();
+void SimpleRenderSystem::renderGameObjects(FrameInfo &frameInfo) {
+  LVE_PROFILE_FUNCTION();
+  LveGpuScope gpuScope{frameInfo.gpuProfiler, frameInfo.commandBuffer,
+                       "simple render system"};
+  drawObjects(frameInfo, *lvePipeline);
+}
+
+void SimpleRenderSystem::renderOverdraw(FrameInfo &frameInfo) {
+  assert(overdrawPipeline != nullptr &&
+         "Overdraw pipeline was not created (call prepareOverdraw first)");
+  LVE_PROFILE_FUNCTION();
+  LveGpuScope gpuScope{frameInfo.gpuProfiler, frameInfo.commandBuffer,
+                       "overdraw"};
+  drawObjects(frameInfo, *overdrawPipeline);
+}
 
-    vkCmdPushConstants(commandBuffer, pipelineLayout,
-                       VK_SHADER_STAGE_VERTEX_BIT |
-                           VK_SHADER_STAGE_FRAGMENT_BIT,
-                       0, sizeof(SimplePushConstantData), &push);
+void SimpleRenderSystem::drawObjects(FrameInfo &frameInfo,
+                                     LvePipeline &pipeline) {
+  VkCommandBuffer commandBuffer = frameInfo.commandBuffer;
+  LveRegistry &registry = frameInfo.registry;
+  const LveSceneGraph &sceneGraph = frameInfo.sceneGraph;
 
-    obj.model->bind(commandBuffer);
-    obj.model->draw(commandBuffer);
+  LveFrameCapture *capture = frameInfo.capture;
+
+  pipeline.bind(commandBuffer);
+  drawCount = 0;
+
+  vkd::cmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                             pipelineLayout, 0, 1,
+                             &frameInfo.globalDescriptorSet, 0, nullptr);
+  if (capture != nullptr) {
+    capture->bindPipeline(pipeline);
+    capture->bindGlobalSet();
   }
+
+  auto projectionView =
+      frameInfo.camera.getProjection() * frameInfo.camera.getView();
+
+  auto draw = [&](LveModel *model, const glm::mat4 &modelMatrix,
+                  const glm::vec3 &color) {
+    SimplePushConstantData push{};
+    push.color = color;
+    push.transform = projectionView * modelMatrix;
+
+    const VkShaderStageFlags pushStages =
+        VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+    vkd::cmdPushConstants(commandBuffer, pipelineLayout, pushStages, 0,
+                          sizeof(SimplePushConstantData), &push);
+
+    model->bind(commandBuffer);
+    model->draw(commandBuffer);
+    drawCount++;
+
+    if (capture != nullptr) {
+      capture->pushConstants(pushStages, sizeof(SimplePushConstantData),
+                             &push);
+      capture->drawModel(*model);
+    }
+  };
+
+  // BVH에 있는 entity는 아래 query에서 그림
+  auto &proxies = registry.pool<BvhProxyComponent>();
+  auto culled = [&](LveEntity entity) {
+    return frameInfo.bvh != nullptr && proxies.contains(entity.index);
+  };
+
+  registry.each<ModelComponent, TransformComponent, ColorComponent>(
+      [&](LveEntity entity, ModelComponent &model,
+          TransformComponent &transform, ColorComponent &color) {
+        if (!culled(entity)) {
+          draw(model.model, transform.mat4(), color.color);
+        }
+      });
+
+  registry.each<ModelComponent, SceneNodeComponent, ColorComponent>(
+      [&](LveEntity entity, ModelComponent &model,
+          SceneNodeComponent &sceneNode, ColorComponent &color) {
+        if (!culled(entity)) {
+          draw(model.model, sceneGraph.worldMatrix(sceneNode.node),
+               color.color);
+        }
+      });
+
+  if (frameInfo.bvh == nullptr) {
+    return;
+  }
+
+  // leaf userData = entity index
+  auto &models = registry.pool<ModelComponent>();
+  auto &transforms = registry.pool<TransformComponent>();
+  auto &sceneNodes = registry.pool<SceneNodeComponent>();
+  auto &colors = registry.pool<ColorComponent>();
+
+  frameInfo.bvh->queryFrustum(
+      LveFrustum::fromMatrix(projectionView), [&](uint32_t entityIndex) {
+        ModelComponent *model = models.tryGet(entityIndex);
+        ColorComponent *color = colors.tryGet(entityIndex);
+        if (model == nullptr || color == nullptr) {
+          return;
+        }
+        if (auto *transform = transforms.tryGet(entityIndex)) {
+          draw(model->model, transform->mat4(), color->color);
+        } else if (auto *sceneNode = sceneNodes.tryGet(entityIndex)) {
+          draw(model->model, sceneGraph.worldMatrix(sceneNode->node),
+               color->color);
+        }
+      });
 }
+
 } // namespace lve
\ No newline at end of file
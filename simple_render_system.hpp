@@ -2,6 +2,7 @@
 
 #include "lve_camera.hpp"
 #include "lve_device.hpp"
+#include "lve_frame_info.hpp"
 #include "lve_game_object.hpp"
 #include "lve_pipeline.hpp"
 
@@ -17,16 +18,43 @@ public:
   /**
    * @brief pipeline layout과 pipeline 생성
    *
+   * @param overdrawRenderPass overdraw pipeline을 만들 render pass
+   *                           (pipeline은 prepareOverdraw()에서 생성)
    */
-  SimpleRenderSystem(LveDevice &device, VkRenderPass renderPass);
+  SimpleRenderSystem(LveDevice &device, VkRenderPass renderPass,
+                     VkDescriptorSetLayout globalSetLayout,
+                     VkRenderPass overdrawRenderPass = VK_NULL_HANDLE);
   ~SimpleRenderSystem();
 
   SimpleRenderSystem(const SimpleRenderSystem &) = delete;
   SimpleRenderSystem &operator=(const SimpleRenderSystem &) = delete;
 
-  void renderGameObjects(VkCommandBuffer commandBuffer,
-                         std::vector<LveGameObject> &gameObjects,
-                         const LveCamera &camera);
+  /**
+   * @brief Model, Transform, Color component를 가진 entity를 그림
+   * registry의 dense 배열을 그대로 순회
+   * SceneNodeComponent를 가진 entity는 scene graph의 world matrix 사용
+   * frameInfo.bvh가 있으면 BvhProxyComponent entity는 frustum 안에 있는 것만 그림
+   *
+   */
+  void renderGameObjects(FrameInfo &frameInfo);
+
+  /**
+   * @brief overdraw pipeline을 처음 호출할 때 생성
+   * 측정을 켤 때만 overdraw shader를 읽음 -> shader가 없어도 시작은 가능
+   *
+   * @return overdraw render pass가 없거나 pipeline 생성에 실패하면 false
+   */
+  bool prepareOverdraw();
+
+  /**
+   * @brief renderGameObjects()와 같은 object를 overdraw pipeline으로 그림
+   * prepareOverdraw()가 성공한 뒤
+   * LveOverdraw::beginPass() ~ endPass() 사이에서 호출
+   */
+  void renderOverdraw(FrameInfo &frameInfo);
+
+  // 마지막 renderGameObjects()/renderOverdraw()에서 기록한 draw call 수
+  uint32_t getDrawCount() const { return drawCount; }
 
 private:
   /**
@@ -34,7 +62,7 @@ private:
    * 푸시 상수를 설정, shader의 상수 데이터 설정
    *
    */
-  void createPipelineLayout();
+  void createPipelineLayout(VkDescriptorSetLayout globalSetLayout);
 
   /**
    * @brief 그래픽스 파이프라인 레이아웃을 이용해 그래픽 파이프라인 생성
@@ -43,10 +71,24 @@ private:
    */
   void createPipeline(VkRenderPass renderPass);
 
+  /**
+   * @brief additive blend로 fragment 수를 세는 pipeline 생성
+   * @param renderPass LveOverdraw의 render pass
+   */
+  void createOverdrawPipeline(VkRenderPass renderPass);
+
+  /**
+   * @brief pipeline을 bind하고 그릴 entity를 모두 그림
+   */
+  void drawObjects(FrameInfo &frameInfo, LvePipeline &pipeline);
+
   // vertex, fragment shader 파일 경로를 받아서 pipeline 생성
   LveDevice &lveDevice;
 
   std::unique_ptr<LvePipeline> lvePipeline;
+  std::unique_ptr<LvePipeline> overdrawPipeline;
+  VkRenderPass overdrawRenderPass;
   VkPipelineLayout pipelineLayout;
+  uint32_t drawCount = 0;
 };
 } // namespace lve
\ No newline at end of file